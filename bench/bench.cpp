@@ -0,0 +1,121 @@
+#include "bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+/**
+ * @brief The number of allocations made through operator new.
+ */
+static atomic<uint64_t> allocations(0);
+
+/**
+ * @brief The filter selecting the benchmarks to run, empty to run all of them.
+ */
+static string filter;
+
+/**
+ * @brief Allocates memory, counting the allocation.
+ *
+ * @param size The number of bytes to allocate.
+ * @return void* The allocated memory.
+ * @throws std::bad_alloc If the memory cannot be allocated.
+ */
+static void* countedAllocate(size_t size)
+{
+	allocations.fetch_add(1, memory_order_relaxed);
+
+	void* memory = malloc(size > 0 ? size : 1);
+
+	if (memory == nullptr)
+	{
+		throw bad_alloc();
+	}
+
+	return memory;
+}
+
+void* operator new(size_t size)
+{
+	return countedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return countedAllocate(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+	allocations.fetch_add(1, memory_order_relaxed);
+	return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept
+{
+	allocations.fetch_add(1, memory_order_relaxed);
+	return malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+/**
+ * @brief Retrieves the number of allocations made through operator new since the start.
+ *
+ * @return uint64_t The number of allocations.
+ */
+uint64_t allocationCount()
+{
+	return allocations.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Checks if a benchmark is selected by the filter given on the command line.
+ *
+ * @param name The name of the benchmark.
+ * @return bool True if the filter is empty or is a substring of the name, false otherwise.
+ */
+bool isSelected(const string& name)
+{
+	return filter.empty() || name.find(filter) != string::npos;
+}
+
+int main(int argc, char* argv[])
+{
+	// Only run the benchmarks whose name contains the given filter
+	if (argc >= 2)
+	{
+		filter = argv[1];
+	}
+
+	// Print the numbers in fixed notation so that runs can be compared line by line
+	cout << fixed << setprecision(2);
+	cout << "benchmark\titerations\tns_per_op\tallocs_per_op\tpeak_rss_kb\tchecksum\n";
+
+	runParseBenchmarks();
+	runAddressBenchmarks();
+	runSegmentBenchmarks();
+	runLookupBenchmarks();
+	runFormatBenchmarks();
+	runPoolBenchmarks();
+
+	return 0;
+}
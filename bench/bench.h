@@ -0,0 +1,98 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "utils/stats.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Retrieves the number of allocations made through operator new since the start.
+ *
+ * @return uint64_t The number of allocations.
+ */
+uint64_t allocationCount();
+
+/**
+ * @brief Checks if a benchmark is selected by the filter given on the command line.
+ *
+ * @param name The name of the benchmark.
+ * @return bool True if the filter is empty or is a substring of the name, false otherwise.
+ */
+bool isSelected(const string& name);
+
+/**
+ * @brief Runs an operation a number of times and prints one line of results.
+ *
+ * The line holds the name of the benchmark, the number of iterations, the mean time
+ * and number of allocations per iteration, the peak resident set size of the process
+ * so far, and the sum of the values returned by the operation, which keeps the
+ * compiler from discarding the work. The fields are separated by tabulations.
+ *
+ * @param name The name of the benchmark.
+ * @param iterations The number of times the operation is run.
+ * @param operation The operation, taking the index of the iteration and returning a checksum.
+ */
+template <typename Operation>
+void runBenchmark(const string& name, uint64_t iterations, Operation operation)
+{
+	// Skip the benchmarks that are not selected
+	if (!isSelected(name))
+	{
+		return;
+	}
+
+	uint64_t checksum = 0;
+	uint64_t allocations = allocationCount();
+
+	auto start = chrono::steady_clock::now();
+
+	for (uint64_t i = 0; i < iterations; ++i)
+	{
+		checksum += (uint64_t)operation(i);
+	}
+
+	auto end = chrono::steady_clock::now();
+
+	allocations = allocationCount() - allocations;
+
+	double nanoseconds = (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+
+	cout << name << "\t" << iterations << "\t" << nanoseconds / (double)iterations << "\t"
+		<< (double)allocations / (double)iterations << "\t" << Stats::getPeakResidentSize() / 1024 << "\t" << checksum << "\n";
+}
+
+/**
+ * @brief Runs the benchmarks of the address parsers.
+ */
+void runParseBenchmarks();
+
+/**
+ * @brief Runs the benchmarks of the address arithmetic and of the masks.
+ */
+void runAddressBenchmarks();
+
+/**
+ * @brief Runs the benchmarks of the segmentation of both families.
+ */
+void runSegmentBenchmarks();
+
+/**
+ * @brief Runs the benchmarks of the longest-prefix-match lookups.
+ */
+void runLookupBenchmarks();
+
+/**
+ * @brief Runs the benchmarks of the table printing and of the end-to-end jobs.
+ */
+void runFormatBenchmarks();
+
+/**
+ * @brief Runs the benchmarks of the concurrent subnet pool.
+ */
+void runPoolBenchmarks();
+
+#endif // BENCH_H
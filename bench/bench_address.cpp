@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "address/ipv4_address.h"
+#include "address/ipv6_address.h"
+
+/**
+ * @brief Runs the benchmarks of the address arithmetic and of the masks.
+ *
+ * The arithmetic is measured on a single address updated in place, and the
+ * masks are constructed for every prefix length in turn.
+ */
+void runAddressBenchmarks()
+{
+	const uint64_t count = 1000000;
+
+	IPv4Address ipv4("10.0.0.0");
+	IPv6Address ipv6("2001:db8::");
+	Mask ipv4Mask(24);
+	Mask ipv6Mask(64);
+	Mask ipv4HostMask = ~ipv4Mask;
+	Mask ipv6HostMask = ~ipv6Mask;
+
+	runBenchmark("ipv4_add", count, [&](uint64_t) { ipv4 += 256; return ipv4.toUInt32(); });
+	runBenchmark("ipv4_and_mask", count, [&](uint64_t) { ipv4 &= ipv4Mask; return ipv4.toUInt32(); });
+	runBenchmark("ipv4_or_mask", count, [&](uint64_t) { ipv4 |= ipv4HostMask; return ipv4.toUInt32(); });
+	runBenchmark("ipv6_add", count, [&](uint64_t) { ipv6 += 65536; return ipv6.toUInt128().getLow(); });
+	runBenchmark("ipv6_add_uint128", count, [&](uint64_t) { ipv6 += UInt128(1, 0); return ipv6.toUInt128().getHigh(); });
+	runBenchmark("ipv6_and_mask", count, [&](uint64_t) { ipv6 &= ipv6Mask; return ipv6.toUInt128().getLow(); });
+	runBenchmark("ipv6_or_mask", count, [&](uint64_t) { ipv6 |= ipv6HostMask; return ipv6.toUInt128().getLow(); });
+	runBenchmark("mask_construct", count, [](uint64_t i) { return (uint64_t)Mask((int)(i % 128) + 1).getPrefixLength(); });
+}
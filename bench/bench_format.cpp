@@ -0,0 +1,75 @@
+#include "bench.h"
+#include "cli/cli.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include <streambuf>
+
+#define FORMAT_SUBNETS 65536 ///< The number of subnets of the printed networks.
+
+/**
+ * @class NullBuffer
+ * @brief Stream buffer discarding everything written to it.
+ *
+ * Writing the output to it measures the formatting alone, without the cost of
+ * a terminal, a file or a growing string.
+ */
+class NullBuffer : public streambuf
+{
+protected:
+	/**
+	 * @brief Discards a character.
+	 *
+	 * @param c The character to discard.
+	 * @return int The character.
+	 */
+	int overflow(int c) override
+	{
+		return c;
+	}
+
+	/**
+	 * @brief Discards a sequence of characters.
+	 *
+	 * @param s The characters to discard.
+	 * @param n The number of characters.
+	 * @return streamsize The number of characters.
+	 */
+	streamsize xsputn(const char* s, streamsize n) override
+	{
+		(void)s;
+		return n;
+	}
+};
+
+/**
+ * @brief Runs the benchmarks of the table printing and of the end-to-end jobs.
+ *
+ * The printing benchmarks print already segmented networks, one operation being
+ * a whole table of FORMAT_SUBNETS rows, and the end-to-end benchmarks run whole
+ * jobs as the command line does.
+ */
+void runFormatBenchmarks()
+{
+	NullBuffer buffer;
+	ostream null(&buffer);
+
+	IPv4Network ipv4(IPv4Address("10.0.0.0"), 8);
+	IPv6Network ipv6(IPv6Address("2001:db8::"), 16);
+
+	ipv4.segment(FORMAT_SUBNETS);
+	ipv6.segment(FORMAT_SUBNETS);
+
+	runBenchmark("to_string_ipv4", 1000000, [&](uint64_t i) { return ipv4[i % FORMAT_SUBNETS]->getIp()->toString().size(); });
+	runBenchmark("to_string_ipv6", 1000000, [&](uint64_t i) { return ipv6[i % FORMAT_SUBNETS]->getIp()->toString().size(); });
+	runBenchmark("print_table_ipv4/65536", 10, [&](uint64_t) { null << ipv4; return ipv4.getSubnetCount(); });
+	runBenchmark("print_table_ipv6/65536", 10, [&](uint64_t) { null << ipv6; return ipv6.getSubnetCount(); });
+
+	CliOptions options;
+	CliOptions csv;
+	csv.format = OutputFormat::Csv;
+
+	runBenchmark("run_job_ipv4/65536", 10, [&](uint64_t) { runJob("10.0.0.0/8", "65536", null, options); return (uint64_t)1; });
+	runBenchmark("run_job_ipv6/65536", 10, [&](uint64_t) { runJob("2001:db8::/16", "65536", null, options); return (uint64_t)1; });
+	runBenchmark("run_job_csv_ipv4/65536", 10, [&](uint64_t) { runJob("10.0.0.0/8", "65536", null, csv); return (uint64_t)1; });
+	runBenchmark("run_job_csv_ipv6/65536", 10, [&](uint64_t) { runJob("2001:db8::/16", "65536", null, csv); return (uint64_t)1; });
+}
@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "network/prefix_trie.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include <random>
+
+#define LOOKUP_SUBNETS (1u << 20) ///< The number of subnets of the looked up tables.
+#define LOOKUP_ADDRESSES 1000000 ///< The number of addresses looked up by each benchmark.
+
+/**
+ * @brief Runs the lookup benchmarks of a family.
+ *
+ * The same random addresses are looked up one at a time in the trie, in a batch
+ * spread over every hardware thread, and with a binary search in the sorted table.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @tparam Generator The type of the function generating the addresses.
+ * @param name The name of the family, used as a suffix of the benchmark names.
+ * @param table The table of subnets to look up.
+ * @param randomAddress The function generating a random address of the table.
+ */
+template <typename Traits, typename Generator>
+static void runLookupBenchmarks(const string& name, const SubnetTable<Traits>& table, Generator randomAddress)
+{
+	typedef typename Traits::value_type value_type;
+
+	vector<value_type> ips(LOOKUP_ADDRESSES);
+	vector<size_t> indices(LOOKUP_ADDRESSES);
+
+	for (value_type& ip : ips)
+	{
+		ip = randomAddress();
+	}
+
+	PrefixTrie<Traits> trie(table);
+
+	runBenchmark("trie_build_" + name + "/" + to_string(table.size()), 1, [&](uint64_t)
+	{
+		return PrefixTrie<Traits>(table).size();
+	});
+
+	runBenchmark("trie_find_" + name, LOOKUP_ADDRESSES, [&](uint64_t i) { return trie.find(ips[i]); });
+	runBenchmark("table_find_" + name, LOOKUP_ADDRESSES, [&](uint64_t i) { return table.find(ips[i]); });
+
+	runBenchmark("trie_find_batch_" + name, 1, [&](uint64_t)
+	{
+		trie.find(ips.data(), ips.size(), indices.data(), 0);
+		return indices.back();
+	});
+}
+
+/**
+ * @brief Runs the benchmarks of the longest-prefix-match lookups.
+ */
+void runLookupBenchmarks()
+{
+	mt19937_64 random(42);
+
+	IPv4Network ipv4(IPv4Address("10.0.0.0"), 8);
+	IPv6Network ipv6(IPv6Address("2000::"), 8);
+
+	runLookupBenchmarks<IPv4Traits>("ipv4", ipv4.segmentTable(LOOKUP_SUBNETS), [&]() { return 0x0A000000u | (uint32_t)(random() & 0xFFFFFF); });
+	runLookupBenchmarks<IPv6Traits>("ipv6", ipv6.segmentTable(LOOKUP_SUBNETS), [&]() { return UInt128(0x2000000000000000ull | (random() >> 8), random()); });
+}
@@ -0,0 +1,167 @@
+#include "bench.h"
+#include "utils/utils.h"
+#include "address/address_parser.h"
+#include "address/ipv4_address.h"
+#include "address/ipv6_address.h"
+#include "format/address_format.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+/**
+ * @brief Parses an IPv4 address the way IPv4Address::setAddress used to.
+ *
+ * This is the reference implementation the fast parser is measured against: it
+ * splits the text into a vector of strings, then validates and converts each part
+ * with all_of and stoi.
+ *
+ * @param address The text to parse.
+ * @return uint32_t The value of the address.
+ * @throws std::invalid_argument if the address is not a valid IPv4 address.
+ */
+static uint32_t legacyParseIPv4(const string& address)
+{
+	vector<string> octets = split(address, ".");
+
+	if (octets.size() != 4)
+	{
+		throw invalid_argument("Invalid IPv4 address.");
+	}
+
+	uint32_t value = 0;
+
+	for (const string& octet : octets)
+	{
+		if (octet.empty() || !all_of(octet.begin(), octet.end(), ::isdigit))
+		{
+			throw invalid_argument("Invalid IPv4 address.");
+		}
+
+		int octetValue = stoi(octet);
+
+		if (octetValue < 0 || octetValue > 255)
+		{
+			throw invalid_argument("Invalid IPv4 address.");
+		}
+
+		value = (value << 8) | (uint32_t)octetValue;
+	}
+
+	return value;
+}
+
+/**
+ * @brief Parses an IPv6 address the way IPv6Address::setAddress used to.
+ *
+ * @param address The text to parse.
+ * @return UInt128 The value of the address.
+ * @throws std::invalid_argument if the address is not a valid IPv6 address.
+ */
+static UInt128 legacyParseIPv6(const string& address)
+{
+	vector<string> hextets;
+
+	if (address.find("::") != string::npos)
+	{
+		vector<string> parts = split(address, "::");
+		vector<string> leftPart = parts[0].empty() ? vector<string>() : split(parts[0], ":");
+		vector<string> rightPart = parts[1].empty() ? vector<string>() : split(parts[1], ":");
+
+		hextets.insert(hextets.end(), leftPart.begin(), leftPart.end());
+		hextets.resize(8 - rightPart.size(), "0");
+		hextets.insert(hextets.end(), rightPart.begin(), rightPart.end());
+	}
+	else
+	{
+		hextets = split(address, ":");
+	}
+
+	if (hextets.size() != 8)
+	{
+		throw invalid_argument("Invalid IPv6 address.");
+	}
+
+	UInt128 value = 0;
+
+	for (const string& hextet : hextets)
+	{
+		if (hextet.empty() || !all_of(hextet.begin(), hextet.end(), ::isxdigit))
+		{
+			throw invalid_argument("Invalid IPv6 address.");
+		}
+
+		int hextetValue = stoi(hextet, nullptr, 16);
+
+		if (hextetValue < 0 || hextetValue > 0xFFFF)
+		{
+			throw invalid_argument("Invalid IPv6 address.");
+		}
+
+		value = (value << 16) | UInt128((uint64_t)hextetValue);
+	}
+
+	return value;
+}
+
+/**
+ * @brief Runs the benchmarks of the address parsers.
+ *
+ * The legacy parsers, the fast parsers and the constructors of the address classes
+ * parse the same random addresses.
+ */
+void runParseBenchmarks()
+{
+	const size_t count = 1000000;
+
+	mt19937_64 random(42);
+	vector<string> ipv4Inputs;
+	vector<string> ipv6Inputs;
+
+	// Generate the addresses to parse
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint64_t r = random();
+
+		ipv4Inputs.push_back(to_string(r & 0xFF) + "." + to_string((r >> 8) & 0xFF) + "." + to_string((r >> 16) & 0xFF) + "." + to_string((r >> 24) & 0xFF));
+
+		char buffer[48];
+		snprintf(buffer, sizeof(buffer), "2001:db8:%x::%x:%x", (unsigned)((r >> 32) & 0xFFFF), (unsigned)((r >> 48) & 0xFFFF), (unsigned)(r & 0xFFFF));
+		ipv6Inputs.push_back(buffer);
+	}
+
+	runBenchmark("parse_ipv4_legacy", count, [&](uint64_t i) { return (uint64_t)legacyParseIPv4(ipv4Inputs[i]); });
+	runBenchmark("parse_ipv4", count, [&](uint64_t i) { uint32_t v = 0; parseIPv4(ipv4Inputs[i], v); return (uint64_t)v; });
+	runBenchmark("parse_ipv4_address", count, [&](uint64_t i) { return (uint64_t)IPv4Address(ipv4Inputs[i]).toUInt32(); });
+	runBenchmark("parse_ipv6_legacy", count, [&](uint64_t i) { return legacyParseIPv6(ipv6Inputs[i]).getLow(); });
+	runBenchmark("parse_ipv6", count, [&](uint64_t i) { UInt128 v = 0; parseIPv6(ipv6Inputs[i], v); return v.getLow(); });
+	runBenchmark("parse_ipv6_address", count, [&](uint64_t i) { return IPv6Address(ipv6Inputs[i]).toUInt128().getLow(); });
+
+	// Store the texts back to back, as they come in a file, for the batch parsers
+	string ipv4Text;
+	string ipv6Text;
+	vector<string_view> ipv4Views;
+	vector<string_view> ipv6Views;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		ipv4Text += ipv4Inputs[i] + "\n";
+		ipv6Text += ipv6Inputs[i] + "\n";
+	}
+
+	for (size_t i = 0, ipv4Offset = 0, ipv6Offset = 0; i < count; ++i)
+	{
+		ipv4Views.emplace_back(ipv4Text.data() + ipv4Offset, ipv4Inputs[i].size());
+		ipv6Views.emplace_back(ipv6Text.data() + ipv6Offset, ipv6Inputs[i].size());
+		ipv4Offset += ipv4Inputs[i].size() + 1;
+		ipv6Offset += ipv6Inputs[i].size() + 1;
+	}
+
+	vector<uint32_t> ipv4Values(count);
+	vector<UInt128> ipv6Values(count);
+	vector<char> output(count * (IPV6_MAX_LENGTH + 1));
+
+	runBenchmark("parse_ipv4_batch/" + to_string(count), 10, [&](uint64_t) { return parseIPv4Batch(ipv4Views.data(), count, ipv4Values.data()); });
+	runBenchmark("parse_ipv6_batch/" + to_string(count), 10, [&](uint64_t) { return parseIPv6Batch(ipv6Views.data(), count, ipv6Values.data()); });
+	runBenchmark("format_ipv4_batch/" + to_string(count), 10, [&](uint64_t) { return formatIPv4Batch(ipv4Values.data(), count, output.data()); });
+	runBenchmark("format_ipv6_batch/" + to_string(count), 10, [&](uint64_t) { return formatIPv6Batch(ipv6Values.data(), count, output.data()); });
+}
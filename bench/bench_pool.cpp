@@ -0,0 +1,120 @@
+#include "bench.h"
+#include "network/ipv4_network.h"
+#include "network/subnet_pool.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define POOL_SUBNETS (1u << 20) ///< The number of subnets of the pools.
+#define POOL_LEASES (1u << 22) ///< The number of leases, an allocation and a release each, of an operation.
+#define POOL_HELD 64 ///< The number of subnets each thread holds while it leases.
+
+/**
+ * @brief Leases subnets from a fixed number of threads, sharing the leases between them.
+ *
+ * Each thread holds up to POOL_HELD subnets, releasing the oldest one before
+ * each allocation once it holds them all, so that the pool is churned as by
+ * workers holding leases for a while.
+ *
+ * @tparam Lease The type of the function run by each thread with its number of leases.
+ * @param threadCount The number of threads.
+ * @param lease The function leasing subnets, called as lease(count).
+ */
+template <typename Lease>
+static void runLeases(unsigned threadCount, Lease lease)
+{
+	vector<thread> threads;
+
+	for (unsigned i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back(lease, POOL_LEASES / threadCount);
+	}
+
+	for (thread& t : threads)
+	{
+		t.join();
+	}
+}
+
+/**
+ * @brief Runs the benchmarks of the concurrent subnet pool.
+ *
+ * The same leases are made by an increasing number of threads, one operation
+ * being POOL_LEASES leases, from the sharded pool with a cache per thread and
+ * from a free list guarded by a single mutex, to compare their scaling.
+ */
+void runPoolBenchmarks()
+{
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	SubnetRange<IPv4Traits> range = network.subnets(28);
+	unsigned hardwareThreads = resolveThreadCount(0);
+
+	for (unsigned threadCount = 1; threadCount <= max(hardwareThreads, 4u); threadCount *= 2)
+	{
+		SubnetPool<IPv4Traits> pool(range.slice(0, POOL_SUBNETS));
+
+		runBenchmark("pool_lease/" + to_string(threadCount), 3, [&](uint64_t)
+		{
+			runLeases(threadCount, [&pool](uint64_t count)
+			{
+				SubnetPool<IPv4Traits>::Cache cache(pool);
+				uint64_t held[POOL_HELD];
+
+				for (uint64_t i = 0; i < count; ++i)
+				{
+					if (i >= POOL_HELD)
+					{
+						cache.release(held[i % POOL_HELD]);
+					}
+
+					held[i % POOL_HELD] = cache.allocate();
+				}
+
+				for (uint64_t i = 0; i < min(count, (uint64_t)POOL_HELD); ++i)
+				{
+					cache.release(held[i]);
+				}
+			});
+
+			return pool.getAllocatedCount();
+		});
+
+		vector<uint64_t> freeList;
+		mutex lock;
+
+		for (uint64_t i = 0; i < POOL_SUBNETS; ++i)
+		{
+			freeList.push_back(POOL_SUBNETS - 1 - i);
+		}
+
+		runBenchmark("pool_lease_mutex/" + to_string(threadCount), 3, [&](uint64_t)
+		{
+			runLeases(threadCount, [&freeList, &lock](uint64_t count)
+			{
+				uint64_t held[POOL_HELD];
+
+				for (uint64_t i = 0; i < count; ++i)
+				{
+					lock_guard<mutex> guard(lock);
+
+					if (i >= POOL_HELD)
+					{
+						freeList.push_back(held[i % POOL_HELD]);
+					}
+
+					held[i % POOL_HELD] = freeList.back();
+					freeList.pop_back();
+				}
+
+				lock_guard<mutex> guard(lock);
+
+				for (uint64_t i = 0; i < min(count, (uint64_t)POOL_HELD); ++i)
+				{
+					freeList.push_back(held[i]);
+				}
+			});
+
+			return (uint64_t)(POOL_SUBNETS - freeList.size());
+		});
+	}
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include "network/vlsm_planner.h"
+#include "network/prefix_aggregator.h"
+#include <random>
+
+#define SEGMENT_MIN_EXPONENT 4 ///< The exponent of the smallest number of subnets measured.
+#define SEGMENT_MAX_EXPONENT 22 ///< The exponent of the largest number of subnets measured.
+#define SEGMENT_WORK (1u << 20) ///< The number of subnets created by each benchmark, at least.
+#define VLSM_REQUIREMENTS 100000 ///< The number of host requirements of the planning benchmarks.
+#define AGGREGATE_PREFIXES 1000000 ///< The number of prefixes of the aggregation benchmark.
+
+/**
+ * @brief Runs the segmentation benchmarks of a network at every measured size.
+ *
+ * Each benchmark segments the network into 2^k subnets, with k going from
+ * SEGMENT_MIN_EXPONENT to SEGMENT_MAX_EXPONENT by steps of 2, as many times
+ * as needed to create SEGMENT_WORK subnets. The time of an operation covers
+ * the segmentation of the network and the destruction of its subnets.
+ *
+ * @tparam NetworkType The type of the network, IPv4Network or IPv6Network.
+ * @tparam AddressType The type of the address of the network, IPv4Address or IPv6Address.
+ * @param name The name of the family, used as a prefix of the benchmark names.
+ * @param ip The address of the network.
+ * @param prefixLength The prefix length of the network.
+ */
+template <typename NetworkType, typename AddressType>
+static void runSegmentSizes(const string& name, const AddressType& ip, int prefixLength)
+{
+	for (int exponent = SEGMENT_MIN_EXPONENT; exponent <= SEGMENT_MAX_EXPONENT; exponent += 2)
+	{
+		uint32_t count = 1u << exponent;
+		uint64_t iterations = (count < SEGMENT_WORK) ? SEGMENT_WORK / count : 1;
+
+		runBenchmark("segment_" + name + "/" + to_string(count), iterations, [&](uint64_t)
+		{
+			NetworkType network(ip, prefixLength);
+			network.segment(count);
+			return network.getSubnetCount();
+		});
+
+		runBenchmark("segment_table_" + name + "/" + to_string(count), iterations, [&](uint64_t)
+		{
+			NetworkType network(ip, prefixLength);
+			return network.segmentTable(count).size();
+		});
+	}
+}
+
+/**
+ * @brief Runs the benchmarks of the segmentation of both families.
+ *
+ * The networks are large enough to hold 2^SEGMENT_MAX_EXPONENT subnets. The
+ * planning benchmarks allocate VLSM_REQUIREMENTS random host requirements, and
+ * the aggregation benchmark collapses AGGREGATE_PREFIXES random prefixes.
+ */
+void runSegmentBenchmarks()
+{
+	runSegmentSizes<IPv4Network>("ipv4", IPv4Address("10.0.0.0"), 8);
+	runSegmentSizes<IPv6Network>("ipv6", IPv6Address("2000::"), 8);
+
+	// Generate random host requirements, from 1 to 100 hosts
+	mt19937_64 random(42);
+	vector<uint64_t> hosts(VLSM_REQUIREMENTS);
+
+	for (uint64_t& host : hosts)
+	{
+		host = 1 + random() % 100;
+	}
+
+	// Plan the requirements in a /8 and in a /32, one operation being a whole plan
+	runBenchmark("vlsm_plan_ipv4/" + to_string(VLSM_REQUIREMENTS), 10, [&](uint64_t)
+	{
+		VlsmPlanner<IPv4Traits> planner(0x0A000000u, 8);
+		return planner.plan(hosts).size();
+	});
+
+	runBenchmark("vlsm_plan_ipv6/" + to_string(VLSM_REQUIREMENTS), 10, [&](uint64_t)
+	{
+		VlsmPlanner<IPv6Traits> planner(IPv6Address("2001:db8::").toUInt128(), 32);
+		return planner.plan(hosts).size();
+	});
+
+	// Generate random prefixes of a /8, from /28 to /32
+	vector<Subnet<IPv4Traits>> prefixes;
+	prefixes.reserve(AGGREGATE_PREFIXES);
+
+	for (size_t i = 0; i < AGGREGATE_PREFIXES; ++i)
+	{
+		prefixes.emplace_back(0x0A000000u | (uint32_t)(random() & 0xFFFFFFu), 28 + (int)(random() % 5));
+	}
+
+	// Aggregate the prefixes in chunks, one operation being a whole aggregation
+	runBenchmark("aggregate_ipv4/" + to_string(AGGREGATE_PREFIXES), 10, [&](uint64_t)
+	{
+		PrefixAggregator<IPv4Traits> aggregator(AGGREGATE_PREFIXES / 8);
+
+		for (const Subnet<IPv4Traits>& prefix : prefixes)
+		{
+			aggregator.add(prefix);
+		}
+
+		return aggregator.result().size();
+	});
+}
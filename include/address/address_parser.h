@@ -0,0 +1,67 @@
+#ifndef ADDRESS_PARSER_H
+#define ADDRESS_PARSER_H
+
+#include "utils/uint128.h"
+#include "utils/parse_status.h"
+#include <string_view>
+
+using namespace std;
+
+/**
+ * @brief Parses the dotted-decimal representation of an IPv4 address.
+ *
+ * The text is scanned once, without allocating and without throwing. It must
+ * consist of four non-empty parts of decimal digits separated by periods, each
+ * part being between 0 and 255. When several errors are present, an invalid
+ * number of parts is reported first, then the error of the first invalid part.
+ *
+ * @param text The text to parse.
+ * @param value The value of the address, only set if the text is valid.
+ * @return ParseStatus ParseStatus::Success if the text is a valid IPv4 address, the error otherwise.
+ */
+ParseStatus parseIPv4(string_view text, uint32_t& value);
+
+/**
+ * @brief Parses the colon-hexadecimal representation of an IPv6 address.
+ *
+ * The text is scanned without allocating and without throwing. It must consist
+ * of eight non-empty parts of hexadecimal digits separated by colons, each part
+ * being at most 0xFFFF. A single "::" may replace consecutive zero parts. When
+ * several errors are present, an invalid number of parts is reported first,
+ * then the error of the first invalid part.
+ *
+ * @param text The text to parse.
+ * @param value The value of the address, only set if the text is valid.
+ * @return ParseStatus ParseStatus::Success if the text is a valid IPv6 address, the error otherwise.
+ */
+ParseStatus parseIPv6(string_view text, UInt128& value);
+
+/**
+ * @brief Parses a batch of IPv4 addresses.
+ *
+ * A plain loop calling parseIPv4 on each text, for callers holding arrays of
+ * texts. It is not a vectorized kernel: each address is parsed by the scalar
+ * parser, one after the other.
+ *
+ * @param texts The texts to parse.
+ * @param count The number of texts.
+ * @param values The values of the addresses, zero for an invalid text.
+ * @param statuses The result of parsing each text, or nullptr if it is not needed.
+ * @return size_t The number of valid addresses.
+ */
+size_t parseIPv4Batch(const string_view* texts, size_t count, uint32_t* values, ParseStatus* statuses = nullptr);
+
+/**
+ * @brief Parses a batch of IPv6 addresses.
+ *
+ * A plain loop calling parseIPv6 on each text, with no vectorized kernel.
+ *
+ * @param texts The texts to parse.
+ * @param count The number of texts.
+ * @param values The values of the addresses, zero for an invalid text.
+ * @param statuses The result of parsing each text, or nullptr if it is not needed.
+ * @return size_t The number of valid addresses.
+ */
+size_t parseIPv6Batch(const string_view* texts, size_t count, UInt128* values, ParseStatus* statuses = nullptr);
+
+#endif // ADDRESS_PARSER_H
\ No newline at end of file
@@ -2,6 +2,12 @@
 #define IP_ADDRESS_H
 
 #include "mask/mask.h"
+#include "format/address_format.h"
+#include "utils/uint128.h"
+#include "utils/arena.h"
+#include "utils/utils.h"
+
+#define IP_ADDRESS_MAX_LENGTH IPV6_MAX_LENGTH ///< The maximum length of the text of an IP address.
 
 using namespace std;
 
@@ -13,12 +19,36 @@ class IPAddress
 {
 protected:
 	/**
-	 * @brief A vector containing the octets of the address.
+	 * @brief The value of the address.
+	 * 
+	 * The address is stored as a fixed-width integer whose least significant bits hold
+	 * the octets of the address, the first octet being the most significant one. Only
+	 * the lowest _size * 8 bits are used, the remaining bits are always zero.
+	 */
+	UInt128 _address;
+
+	/**
+	 * @brief The number of octets in the address.
+	 */
+	size_t _size;
+
+	/**
+	 * @brief Retrieves a value with all the bits of the address set.
 	 * 
-	 * This vector stores the individual octets (8-bit values) that make up the address.
-	 * Each element in the vector represents one octet of the address.
+	 * @return UInt128 A value with the lowest _size * 8 bits set to one.
 	 */
-	vector<uint8_t> _address;
+	UInt128 getWidthMask() const
+	{
+		return UInt128::lowBits((int)_size * 8);
+	}
+
+	/**
+	 * @brief Adds a signed offset to the address, wrapping around at the width of the address.
+	 * 
+	 * @param offset The offset to add, subtracted if it is negative.
+	 * @return IPAddress& A reference to the modified IPAddress object.
+	 */
+	IPAddress& addOffset(int64_t offset);
 
 	/**
 	 * @brief Sets the IP address.
@@ -35,12 +65,12 @@ public:
 	 * @brief Constructs an IPAddress object with a specified size.
 	 * 
 	 * This constructor initializes the IPAddress object with a given size,
-	 * setting all elements of the internal address vector to zero.
+	 * setting all octets of the address to zero.
 	 * 
 	 * @param size The size of the IP address.
 	 */
 	IPAddress(size_t size)
-		: _address(size, 0) {}
+		: _address(0), _size(size) {}
 
 	/**
 	 * @brief Virtual destructor for the IPAddress class.
@@ -51,6 +81,18 @@ public:
 	 */
 	virtual ~IPAddress() = default;
 
+	/**
+	 * @brief Copy and move operations of the IPAddress class.
+	 *
+	 * An address is a plain value, so moving it is as cheap as copying it. They are
+	 * declared explicitly because the virtual destructor would otherwise suppress
+	 * the implicit move operations of the derived classes.
+	 */
+	IPAddress(const IPAddress&) = default;
+	IPAddress(IPAddress&&) noexcept = default;
+	IPAddress& operator =(const IPAddress&) = default;
+	IPAddress& operator =(IPAddress&&) noexcept = default;
+
 	/**
 	 * @brief Creates a clone of the current IPAddress object.
 	 * 
@@ -61,6 +103,17 @@ public:
 	 */
 	virtual IPAddress* clone() const = 0;
 
+	/**
+	 * @brief Creates a clone of the current IPAddress object in an arena.
+	 * 
+	 * The clone lives in the memory of the arena, so it must be destroyed in place
+	 * and never deleted.
+	 * 
+	 * @param arena The arena from which the clone is allocated.
+	 * @return IPAddress* Pointer to the cloned IPAddress object.
+	 */
+	virtual IPAddress* clone(Arena& arena) const = 0;
+
 	/**
 	 * @brief Checks if the given prefix length is compatible.
 	 * 
@@ -80,10 +133,10 @@ public:
 	 * of the network portion of the address, and the remaining bits define the host
 	 * portion.
 	 * 
-	 * @param prefixLength The length of the network prefix in bits.
-	 * @return uint32_t The number of possible addresses in the network segment.
+	 * @param prefixLength The length of the network prefix in bits, between 0 and the width of the address.
+	 * @return UInt128 The number of possible addresses in the network segment, 2^128 - 1 for the whole IPv6 space.
 	 */
-	inline uint32_t calculateCapacity(int prefixLength) const;
+	inline UInt128 calculateCapacity(int prefixLength) const;
 
 	/**
 	 * @brief Retrieves the octet at the specified index from the IP address.
@@ -109,16 +162,51 @@ public:
 	 */
 	inline uint8_t operator [](size_t index) const;
 
+	/**
+	 * @brief Retrieves the octet at the specified index, without checking the index.
+	 * 
+	 * This is the unchecked counterpart of the subscript operator, for the loops that
+	 * already know their indices are valid.
+	 * 
+	 * @param index The zero-based index of the octet, which must be less than getSize().
+	 * @return uint8_t The octet at the specified index.
+	 */
+	uint8_t getOctetUnchecked(size_t index) const
+	{
+		return (uint8_t)(_address >> (int)((_size - 1 - index) * 8)).getLow();
+	}
+
+	/**
+	 * @brief Copies all the octets of the IP address, the first octet first.
+	 * 
+	 * @param octets The buffer receiving the octets, at least getSize() octets long.
+	 * @return size_t The number of octets copied, getSize().
+	 */
+	inline size_t getOctets(uint8_t* octets) const;
+
+	/**
+	 * @brief Retrieves the integer value of the IP address.
+	 * 
+	 * The first octet of the address is the most significant octet of the value,
+	 * and the bits above the width of the address are zero.
+	 * 
+	 * @return UInt128 The value of the IP address.
+	 */
+	UInt128 toUInt128() const
+	{
+		return _address;
+	}
+
 	/**
 	 * @brief Retrieves the size of the IP address.
 	 * 
-	 * This function returns the size of the IP address stored in the _address member.
+	 * This function returns the number of octets of the IP address.
 	 * 
 	 * @return size_t The size of the IP address.
 	 */
 	size_t getSize() const
 	{
-		return _address.size();
+		return _size;
 	}
 
 	/**
@@ -191,6 +279,17 @@ public:
 	 */
 	inline string toString() const;
 
+	/**
+	 * @brief Pure virtual function to write the text of the IP address into a buffer.
+	 * 
+	 * This function must be overridden by derived classes to write the same text
+	 * as their print method, without going through a stream.
+	 * 
+	 * @param buffer The buffer receiving the text, at least IP_ADDRESS_MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	virtual size_t format(char* buffer) const = 0;
+
 	/**
 	 * @brief Pure virtual function to print the IP address.
 	 * 
@@ -224,23 +323,18 @@ public:
  * @brief Calculates the capacity of an IP address range based on the given prefix length.
  *
  * This function determines the number of possible IP addresses within a subnet
- * defined by the given prefix length. If the prefix length is greater than or equal 32,
- * it returns a fixed value of 65536 (2^16). Otherwise, it calculates the capacity
- * as 2^(32 - prefixLength).
+ * defined by the given prefix length, 2^(width - prefixLength), exactly on 128 bits.
+ * The capacity of the whole IPv6 space, 2^128, does not fit and saturates to 2^128 - 1.
  *
  * @param prefixLength The prefix length of the subnet.
- * @return uint32_t The capacity of the IP address range.
+ * @return UInt128 The capacity of the IP address range.
  */
-uint32_t IPAddress::calculateCapacity(int prefixLength) const
+UInt128 IPAddress::calculateCapacity(int prefixLength) const
 {
-	// If the prefix length is greater than or equal to 32, return 65536
-	if (prefixLength >= 32)
-	{
-		return 65536;
-	}
+	int hostBits = (int)_size * 8 - prefixLength;
 
-	// Otherwise, return 2^(32 - prefixLength)
-	return 1 << (32 - prefixLength);
+	// The whole IPv6 space saturates, otherwise the capacity is a power of 2
+	return (hostBits >= 128) ? UInt128::lowBits(128) : UInt128(1) << hostBits;
 }
 
 /**
@@ -248,33 +342,57 @@ uint32_t IPAddress::calculateCapacity(int prefixLength) const
  * 
  * @param index The zero-based index of the octet to access.
  * @return uint8_t The octet at the specified index.
- * @throws std::out_of_range If the index is out of the valid range (0 to _address.size() - 1).
+ * @throws std::out_of_range If the index is out of the valid range (0 to _size - 1).
  */
 uint8_t IPAddress::operator [](size_t index) const
 {
 	// Check if the index is out of range
-	if (index >= _address.size())
+	if (index >= _size)
 	{
-		throw out_of_range("Index out of range, must be between 0 and " + to_string(_address.size() - 1) + ".");
+		throwIndexOutOfRange(_size);
 	}
 
 	// Return the octet at the specified index
-	return _address[index];
+	return getOctetUnchecked(index);
+}
+
+/**
+ * @brief Copies all the octets of the IP address, the first octet first.
+ *
+ * The octets are taken from the two 64-bit halves of the value, without
+ * shifting the whole 128-bit value for each octet.
+ *
+ * @param octets The buffer receiving the octets, at least getSize() octets long.
+ * @return size_t The number of octets copied, getSize().
+ */
+size_t IPAddress::getOctets(uint8_t* octets) const
+{
+	uint64_t high = _address.getHigh();
+	uint64_t low = _address.getLow();
+
+	for (size_t i = 0; i < _size; ++i)
+	{
+		// Position of the octet in the value, from its least significant bit
+		size_t shift = (_size - 1 - i) * 8;
+
+		octets[i] = (uint8_t)((shift >= 64) ? high >> (shift - 64) : low >> shift);
+	}
+
+	return _size;
 }
 
 /**
  * @brief Converts the IPAddress object to its string representation.
  * 
- * This function uses an output string stream to generate a string
- * representation of the IPAddress object by calling the print method.
+ * This function writes the text of the address into a local buffer with the
+ * format method, then copies it into the returned string.
  * 
  * @return string A string representation of the IPAddress object.
  */
 string IPAddress::toString() const
 {
-	ostringstream oss;
-	print(oss);
-	return oss.str();
+	char text[IP_ADDRESS_MAX_LENGTH];
+	return string(text, format(text));
 }
 
 #endif // IP_ADDRESS_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define IPV4_ADDRESS_H
 
 #include "address/ip_address.h"
+#include "address/address_parser.h"
 
 #define IPV4_NUM_OCTETS 4 ///< The number of octets in an IPv4 address.
 
@@ -37,14 +38,52 @@ public:
 	IPv4Address(const string& address)
 		: IPAddress(IPV4_NUM_OCTETS) 
 	{
-		try 
-		{
-			setAddress(address);
-		}
-		catch (const invalid_argument& e)
-		{
-			throw e;
-		}
+		setAddress(address);
+	}
+
+	/**
+	 * @brief Constructs an IPv4Address object from its integer value.
+	 * 
+	 * The first octet of the address is the most significant octet of the value.
+	 * 
+	 * @param value The 32-bit value of the IPv4 address.
+	 */
+	explicit IPv4Address(uint32_t value)
+		: IPAddress(IPV4_NUM_OCTETS)
+	{
+		_address = value;
+	}
+
+	/**
+	 * @brief Parses an IPv4 address without throwing.
+	 * 
+	 * An invalid address costs no more than a valid one: the error is returned instead
+	 * of thrown, and its message is only built on demand with getErrorMessage().
+	 * 
+	 * @param text The dotted-decimal representation of the address.
+	 * @param address The parsed address, only set if the text is valid.
+	 * @return ParseStatus ParseStatus::Success if the text is a valid IPv4 address, the error otherwise.
+	 */
+	static ParseStatus tryParse(string_view text, IPv4Address& address);
+
+	/**
+	 * @brief Retrieves the message of an error of an IPv4 address.
+	 * 
+	 * @param status The error, as returned by tryParse() or by the creation of a network.
+	 * @return const char* The message, the one the throwing constructors report.
+	 */
+	static const char* getErrorMessage(ParseStatus status);
+
+	/**
+	 * @brief Retrieves the integer value of the IPv4 address.
+	 * 
+	 * The first octet of the address is the most significant octet of the value.
+	 * 
+	 * @return uint32_t The 32-bit value of the IPv4 address.
+	 */
+	uint32_t toUInt32() const
+	{
+		return (uint32_t)_address.getLow();
 	}
 
 	/**
@@ -61,6 +100,17 @@ public:
 		return new IPv4Address(*this);
 	}
 
+	/**
+	 * @brief Creates a clone of the current IPv4Address object in an arena.
+	 * 
+	 * @param arena The arena from which the clone is allocated.
+	 * @return IPv4Address* Pointer to the clone, to be destroyed in place.
+	 */
+	IPv4Address* clone(Arena& arena) const override
+	{
+		return arena.create<IPv4Address>(*this);
+	}
+
 	/**
 	 * @brief Checks if the given prefix length is compatible with IPv4 addressing.
 	 *
@@ -75,43 +125,31 @@ public:
 		return prefixLength >= 1 && prefixLength <= 32;
 	}
 
+	/**
+	 * @brief Writes the dotted-decimal text of the IPv4 address into a buffer.
+	 *
+	 * @param buffer The buffer receiving the text, at least IPV4_MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	size_t format(char* buffer) const override
+	{
+		return formatIPv4(toUInt32(), buffer);
+	}
+
 	/**
 	 * @brief Prints the IPv4 address to the given output stream.
 	 *
-	 * This function iterates through the octets of the IPv4 address and prints each octet
-	 * to the provided output stream. Octets are separated by periods.
+	 * This function writes the octets of the IPv4 address to the provided output
+	 * stream. Octets are separated by periods.
 	 *
 	 * @param s The output stream to which the IPv4 address will be printed.
 	 * @return ostream& A reference to the output stream.
 	 */
-	inline ostream& print(ostream& s) const override;
-};
-
-/**
- * @brief Prints the IPv4 address to the given output stream.
- *
- * This function iterates through the octets of the IPv4 address and prints each octet
- * to the provided output stream. Octets are separated by periods.
- *
- * @param s The output stream to which the IPv4 address will be printed.
- * @return ostream& A reference to the output stream.
- */
-ostream& IPv4Address::print(ostream& s) const
-{
-	// Iterate through the address octets and print them to the stream
-	for (vector<uint8_t>::const_iterator it = _address.begin(); it != _address.end(); ++it)
+	ostream& print(ostream& s) const override
 	{
-		// Print the octet to the stream
-		s << (int)(*it);
-
-		// If this is not the last octet, print a period
-		if (it != _address.end() - 1)
-		{
-			s << ".";
-		}
+		char text[IPV4_MAX_LENGTH];
+		return s.write(text, (streamsize)format(text));
 	}
+};
 
-	return s;
-}
-
-#endif // IPV4_ADDRESS_H
\ No newline at end of file
+#endif // IPV4_ADDRESS_H
@@ -2,6 +2,7 @@
 #define IPV6_ADDRESS_H
 
 #include "address/ip_address.h"
+#include "address/address_parser.h"
 
 #define IPV6_NUM_HEXTETS 8 ///< The number of hextets in an IPv6 address.
 #define IPV6_NUM_OCTETS 16 ///< The number of octets in an IPv6 address.
@@ -23,18 +24,6 @@ private:
 	 */
 	void setAddress(const string& address) override;
 
-	/**
-	 * @brief Finds the longest sequence of consecutive zero blocks in the IPv6 address.
-	 * 
-	 * This function scans the IPv6 address and identifies the longest sequence of 
-	 * consecutive zero blocks. It returns a pair of integers where the first integer 
-	 * represents the starting index of the sequence and the second integer represents 
-	 * the length of the sequence.
-	 * 
-	 * @return pair<int, int> A pair of integers representing the start index and length of the sequence.
-	 */
-	pair<int, int> findLongestZeroSequence() const;
-
 public:
 	/**
 	 * @brief Constructs an IPv6Address object with the given address string.
@@ -50,16 +39,42 @@ public:
 	IPv6Address(const string& address)
 		: IPAddress(IPV6_NUM_OCTETS)
 	{
-		try
-		{
-			setAddress(address);
-		}
-		catch (const invalid_argument& e)
-		{
-			throw e;
-		}
+		setAddress(address);
 	}
 
+	/**
+	 * @brief Constructs an IPv6Address object from its integer value.
+	 * 
+	 * The first hextet of the address is the most significant hextet of the value.
+	 * 
+	 * @param value The 128-bit value of the IPv6 address.
+	 */
+	explicit IPv6Address(const UInt128& value)
+		: IPAddress(IPV6_NUM_OCTETS)
+	{
+		_address = value;
+	}
+
+	/**
+	 * @brief Parses an IPv6 address without throwing.
+	 * 
+	 * An invalid address costs no more than a valid one: the error is returned instead
+	 * of thrown, and its message is only built on demand with getErrorMessage().
+	 * 
+	 * @param text The colon-hexadecimal representation of the address.
+	 * @param address The parsed address, only set if the text is valid.
+	 * @return ParseStatus ParseStatus::Success if the text is a valid IPv6 address, the error otherwise.
+	 */
+	static ParseStatus tryParse(string_view text, IPv6Address& address);
+
+	/**
+	 * @brief Retrieves the message of an error of an IPv6 address.
+	 * 
+	 * @param status The error, as returned by tryParse() or by the creation of a network.
+	 * @return const char* The message, the one the throwing constructors report.
+	 */
+	static const char* getErrorMessage(ParseStatus status);
+
 	/**
 	 * @brief Creates a copy of the current IPv6Address object.
 	 * 
@@ -72,6 +87,17 @@ public:
 		return new IPv6Address(*this);
 	}
 
+	/**
+	 * @brief Creates a copy of the current IPv6Address object in an arena.
+	 * 
+	 * @param arena The arena from which the copy is allocated.
+	 * @return IPv6Address* Pointer to the copy, to be destroyed in place.
+	 */
+	IPv6Address* clone(Arena& arena) const override
+	{
+		return arena.create<IPv6Address>(*this);
+	}
+
 	/**
 	 * @brief Retrieves the hextet (16-bit segment) at the specified index from the IPv6 address.
 	 * 
@@ -93,6 +119,31 @@ public:
 	 */
 	inline uint16_t operator [](size_t index) const;
 
+	/**
+	 * @brief Retrieves the hextet at the specified index, without checking the index.
+	 * 
+	 * @param index The index of the hextet, which must be in the range [0, 7].
+	 * @return uint16_t The hextet at the specified index.
+	 */
+	uint16_t getHextetUnchecked(size_t index) const
+	{
+		uint64_t word = (index < IPV6_NUM_HEXTETS / 2) ? _address.getHigh() : _address.getLow();
+		return (uint16_t)(word >> ((3 - index % 4) * 16));
+	}
+
+	/**
+	 * @brief Copies all the hextets of the IPv6 address, the first hextet first.
+	 * 
+	 * @param hextets The buffer receiving the hextets, at least IPV6_NUM_HEXTETS hextets long.
+	 */
+	void getHextets(uint16_t* hextets) const
+	{
+		for (size_t i = 0; i < IPV6_NUM_HEXTETS; ++i)
+		{
+			hextets[i] = getHextetUnchecked(i);
+		}
+	}
+
 	/**
 	 * @brief Checks if the given prefix length is compatible with an IPv6 address.
 	 * 
@@ -117,6 +168,31 @@ public:
 	 */
 	IPv6Address& operator +=(const vector<uint8_t>& increment);
 
+	/**
+	 * @brief Overloads the += operator to increment the IPv6 address by a 128-bit value.
+	 *
+	 * The addition wraps around at the highest IPv6 address.
+	 *
+	 * @param increment The 128-bit value to add to the IPv6 address.
+	 * @return IPv6Address& A reference to the updated IPv6Address object.
+	 */
+	IPv6Address& operator +=(const UInt128& increment)
+	{
+		_address += increment;
+		return *this;
+	}
+
+	/**
+	 * @brief Writes the colon-hexadecimal text of the IPv6 address into a buffer.
+	 * 
+	 * @param buffer The buffer receiving the text, at least IPV6_MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	size_t format(char* buffer) const override
+	{
+		return formatIPv6(_address, buffer);
+	}
+
 	/**
 	 * @brief Prints the IPv6 address to the given output stream.
 	 * 
@@ -141,14 +217,11 @@ uint16_t IPv6Address::operator [](size_t index) const
 	// Check if the index is out of range
 	if (index >= IPV6_NUM_HEXTETS)
 	{
-		throw out_of_range("Index out of range, must be between 0 and " + to_string(IPV6_NUM_HEXTETS - 1) + ".");
+		throwIndexOutOfRange(IPV6_NUM_HEXTETS);
 	}
 
-	// Calculate the index in the address vector
-	size_t i = index * 2;
-
 	// Return the hextet at the specified index
-	return _address[i] << 8 | _address[i + 1];
+	return getHextetUnchecked(index);
 }
 
 #endif // IPV6_ADDRESS_H
\ No newline at end of file
@@ -0,0 +1,225 @@
+#ifndef CLI_H
+#define CLI_H
+
+#include "format/record_format.h"
+#include "network/segment_plan.h"
+#include <cstdint>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct CliOptions
+ * @brief Holds the options given on the command line.
+ */
+struct CliOptions
+{
+	/**
+	 * @brief Whether the jobs are read line by line instead of from the arguments.
+	 */
+	bool batch = false;
+
+	/**
+	 * @brief Whether the prefixes read line by line are aggregated instead of segmented.
+	 */
+	bool aggregate = false;
+
+	/**
+	 * @brief Whether the timings and the counters of the run are reported to the standard error.
+	 */
+	bool stats = false;
+
+	/**
+	 * @brief The file from which the batch jobs or the prefixes are read, empty for the standard input.
+	 */
+	string inputFile;
+
+	/**
+	 * @brief The number of threads segmenting or formatting each network, or parsing an input file, 0 meaning one per hardware thread.
+	 */
+	unsigned threadCount = 1;
+
+	/**
+	 * @brief The index of the first subnet written by each job.
+	 */
+	uint64_t offset = 0;
+
+	/**
+	 * @brief The maximum number of subnets written by each job, all the subnets by default.
+	 */
+	uint64_t limit = UINT64_MAX;
+
+	/**
+	 * @brief The levels of the hierarchical plan applied to the network, empty to segment it once.
+	 */
+	vector<PlanLevel> plan;
+
+	/**
+	 * @brief The layout in which the subnets are written.
+	 */
+	OutputFormat format = OutputFormat::Table;
+
+	/**
+	 * @brief The arguments that are not options, in order.
+	 */
+	vector<string> arguments;
+};
+
+/**
+ * @brief Parses the command line.
+ * 
+ * The recognized options are "--batch [file]", "--aggregate [file]",
+ * "--threads <count>", "--format <table|csv|ndjson|binary>", "--offset <index>",
+ * "--limit <count>", "--plan <levels>" and "--stats". The levels of a plan are
+ * separated by commas, each one written as /<prefix length>:<number of subnets>,
+ * or /<prefix length> for all the subnets, such as "/16:16,/20:16". Any other
+ * argument is stored in the positional arguments, in order.
+ * 
+ * @param argc The number of arguments, including the program name.
+ * @param argv The arguments, including the program name.
+ * @return CliOptions The options given on the command line.
+ * @throws std::invalid_argument If an option is malformed.
+ */
+CliOptions parseOptions(int argc, const char* const argv[]);
+
+/**
+ * @brief Segments a network given in CIDR notation and prints its subnets, without throwing on invalid input.
+ * 
+ * This function does the same as runJob(), but returns the error of an invalid network
+ * or number of subnets instead of throwing it, so that invalid jobs cost about the same
+ * as valid ones. Nothing is written to the output stream if the job fails.
+ * 
+ * @param cidr The network in CIDR notation, such as 192.168.0.0/24 or 2001:db8::/32.
+ * @param numberOfSubnets The number of subnets to create, as a decimal string.
+ * @param s The output stream to which the subnets will be printed.
+ * @param error The message of the error, the one runJob() would throw, only set if the job fails.
+ * @param options The options of the run.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+bool tryRunJob(string_view cidr, string_view numberOfSubnets, ostream& s, string& error, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Segments a network given in CIDR notation and prints its subnets.
+ * 
+ * This function parses the network and the number of subnets, segments the network,
+ * and prints the table of its subnets to the given output stream, without a trailing
+ * newline. The address family is deduced from the address. Only the subnets with an
+ * index in [offset, offset + limit) of the options are computed and written.
+ * 
+ * @param cidr The network in CIDR notation, such as 192.168.0.0/24 or 2001:db8::/32.
+ * @param numberOfSubnets The number of subnets to create, as a decimal string.
+ * @param s The output stream to which the subnets will be printed.
+ * @param options The options of the run.
+ * @throws std::invalid_argument If the network or the number of subnets is invalid.
+ */
+void runJob(const string& cidr, const string& numberOfSubnets, ostream& s, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Segments a network given in CIDR notation level by level and prints the tree of its subnets, without throwing on invalid input.
+ * 
+ * The subnets of the plan of the options are written depth-first, each subnet followed
+ * by its own subnets, in the format of the options. The tree is computed lazily, with
+ * the threads of the options formatting different branches in parallel, so no subnet
+ * is stored. Nothing is written to the output stream if the plan fails.
+ * 
+ * @param cidr The network in CIDR notation, such as 10.0.0.0/8 or 2001:db8::/32.
+ * @param s The output stream to which the subnets will be printed.
+ * @param error The message of the error, the one runPlan() would throw, only set if the plan fails.
+ * @param options The options of the run, holding the levels of the plan.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+bool tryRunPlan(string_view cidr, ostream& s, string& error, const CliOptions& options);
+
+/**
+ * @brief Segments a network given in CIDR notation level by level and prints the tree of its subnets.
+ * 
+ * @param cidr The network in CIDR notation, such as 10.0.0.0/8 or 2001:db8::/32.
+ * @param s The output stream to which the subnets will be printed.
+ * @param options The options of the run, holding the levels of the plan.
+ * @throws std::invalid_argument If the network or the plan is invalid.
+ */
+void runPlan(const string& cidr, ostream& s, const CliOptions& options);
+
+/**
+ * @brief Runs the segmentation jobs read line by line from an input stream.
+ * 
+ * Each line holds a job as a network in CIDR notation and a number of subnets separated
+ * by whitespace. Blank lines and lines starting with '#' are ignored. The result of each
+ * job is written to the output stream as soon as it is computed. An invalid job does not
+ * stop the run: its error is written inline in place of its result, as a line of the form
+ * "Error: line <number>: <message>".
+ * 
+ * @param in The input stream from which the jobs are read.
+ * @param s The output stream to which the results are written.
+ * @param options The options of the run.
+ * @return size_t The number of jobs that failed.
+ */
+size_t runBatch(istream& in, ostream& s, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Runs the segmentation jobs of an input held in memory, such as a mapped file.
+ * 
+ * This function does the same as the stream overload, but parses the lines in place.
+ * With several threads, the jobs of different parts of the input are run in parallel,
+ * and the results are written in the order of the input.
+ * 
+ * @param input The jobs, one per line.
+ * @param s The output stream to which the results are written.
+ * @param options The options of the run.
+ * @return size_t The number of jobs that failed.
+ */
+size_t runBatch(string_view input, ostream& s, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Aggregates the prefixes read line by line from an input stream.
+ * 
+ * Each line holds a network in CIDR notation, of either family. Blank lines and lines
+ * starting with '#' are ignored. The prefixes are collapsed into the smallest set of
+ * prefixes covering the same addresses, which is written once the whole input is read:
+ * the IPv4 prefixes then the IPv6 prefixes, each family sorted by address. The table
+ * format writes one prefix in CIDR notation per line, the other formats write the records
+ * of each family, the CSV format with a header per family. An invalid line does not stop
+ * the run: its error is written before the result, as a line of the form
+ * "Error: line <number>: <message>".
+ * 
+ * @param in The input stream from which the prefixes are read.
+ * @param s The output stream to which the aggregated prefixes are written.
+ * @param options The options of the run.
+ * @return size_t The number of lines that failed.
+ */
+size_t runAggregate(istream& in, ostream& s, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Aggregates the prefixes of an input held in memory, such as a mapped file.
+ * 
+ * This function does the same as the stream overload, but parses the lines in place.
+ * With several threads, different parts of the input are parsed and aggregated in
+ * parallel, and the output is the same as with a single thread.
+ * 
+ * @param input The prefixes, one per line.
+ * @param s The output stream to which the aggregated prefixes are written.
+ * @param options The options of the run.
+ * @return size_t The number of lines that failed.
+ */
+size_t runAggregate(string_view input, ostream& s, const CliOptions& options = CliOptions());
+
+/**
+ * @brief Runs the batch jobs, or the aggregation if the options request it, of an input file, without throwing if it cannot be opened.
+ * 
+ * A regular file is mapped in memory and its lines are parsed in place. Any other path,
+ * such as /dev/stdin, a FIFO or a process substitution, and a file that cannot be mapped,
+ * is read line by line as a stream instead, with the same output.
+ * 
+ * @param path The path of the input file.
+ * @param s The output stream to which the results are written.
+ * @param failures The number of lines that failed, only set if the file is opened.
+ * @param options The options of the run.
+ * @return bool True if the file is opened and processed, false if it cannot be opened.
+ */
+bool tryRunInputFile(const string& path, ostream& s, size_t& failures, const CliOptions& options = CliOptions());
+
+#endif // CLI_H
\ No newline at end of file
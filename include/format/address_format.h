@@ -0,0 +1,124 @@
+#ifndef ADDRESS_FORMAT_H
+#define ADDRESS_FORMAT_H
+
+#include "utils/uint128.h"
+#include <cstddef>
+
+#define DECIMAL_MAX_LENGTH 20 ///< The maximum length of a 64-bit unsigned integer in decimal.
+#define IPV4_MAX_LENGTH 15 ///< The maximum length of an IPv4 address in dotted-decimal notation.
+#define IPV6_MAX_LENGTH 39 ///< The maximum length of an IPv6 address in colon-hexadecimal notation.
+#define IPV6_HEAD_MAX_LENGTH 20 ///< The maximum length of the text of the first four hextets of an IPv6 address.
+
+/**
+ * @brief Writes an unsigned integer in decimal.
+ *
+ * @param value The integer to write.
+ * @param out The buffer receiving the digits, at least DECIMAL_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatDecimal(uint64_t value, char* out);
+
+/**
+ * @brief Writes an IPv4 address in dotted-decimal notation.
+ *
+ * The text is the same as the one printed by IPv4Address.
+ *
+ * @param value The value of the address.
+ * @param out The buffer receiving the text, at least IPV4_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv4(uint32_t value, char* out);
+
+/**
+ * @brief Writes an IPv6 address in the canonical text representation of RFC 5952.
+ *
+ * The text is the same as the one printed by IPv6Address: the hextets are written
+ * in lowercase without leading zeros, and the longest run of two or more zero
+ * hextets, the first one in case of a tie, is replaced by "::".
+ *
+ * @param value The value of the address.
+ * @param out The buffer receiving the text, at least IPV6_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv6(const UInt128& value, char* out);
+
+/**
+ * @class IPv6Formatter
+ * @brief Writer of IPv6 addresses sharing the text of their first half with the previous address.
+ *
+ * Consecutive subnets of a segmentation mostly differ in their last hextets,
+ * so a formatter writing one column of a table keeps the text of the first
+ * four hextets of the previous address and only renders the last four when
+ * the first half is the same. The texts are the ones formatIPv6 writes.
+ *
+ * A formatter is not thread-safe, each thread writing with its own.
+ */
+class IPv6Formatter
+{
+private:
+	/**
+	 * @brief The text of the first four hextets of the previous address.
+	 */
+	char _head[IPV6_HEAD_MAX_LENGTH] = {};
+
+	/**
+	 * @brief The high half of the previous address.
+	 */
+	uint64_t _high = 0;
+
+	/**
+	 * @brief The first hextet of the run of zero hextets of the previous address, 0xFF before the first one.
+	 */
+	uint8_t _start = 0xFF;
+
+	/**
+	 * @brief The hextet following the run of zero hextets of the previous address.
+	 */
+	uint8_t _end = 0xFF;
+
+	/**
+	 * @brief The length of the text of the first four hextets.
+	 */
+	uint8_t _headLength = 0;
+
+public:
+	/**
+	 * @brief Writes an IPv6 address, reusing the text of the first half of the previous one if it is the same.
+	 *
+	 * @param value The value of the address.
+	 * @param out The buffer receiving the text, at least IPV6_MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	size_t format(const UInt128& value, char* out);
+};
+
+/**
+ * @brief Writes a batch of IPv4 addresses in dotted-decimal notation.
+ *
+ * A plain loop calling formatIPv4 on each value, each text being followed by
+ * the separator, so that a whole batch of addresses can be written to a stream
+ * with one call. It is not a vectorized kernel.
+ *
+ * @param values The values of the addresses.
+ * @param count The number of addresses.
+ * @param out The buffer receiving the texts, at least count * (IPV4_MAX_LENGTH + 1) characters long.
+ * @param separator The character written after each address.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv4Batch(const uint32_t* values, size_t count, char* out, char separator = '\n');
+
+/**
+ * @brief Writes a batch of IPv6 addresses in colon-hexadecimal notation.
+ *
+ * A plain loop calling formatIPv6 on each value, each text being followed by
+ * the separator, with no vectorized kernel.
+ *
+ * @param values The values of the addresses.
+ * @param count The number of addresses.
+ * @param out The buffer receiving the texts, at least count * (IPV6_MAX_LENGTH + 1) characters long.
+ * @param separator The character written after each address.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv6Batch(const UInt128* values, size_t count, char* out, char separator = '\n');
+
+#endif // ADDRESS_FORMAT_H
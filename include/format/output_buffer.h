@@ -0,0 +1,252 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <ostream>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include "utils/stats.h"
+
+using namespace std;
+
+#define OUTPUT_BUFFER_CAPACITY 65536 ///< The default capacity of an output buffer, in bytes.
+
+/**
+ * @class OutputBuffer
+ * @brief Accumulates text in a reusable buffer and writes it to a stream in large blocks.
+ *
+ * Appending to the buffer only copies characters, the stream is written once the
+ * buffer is full, when flush() is called, and when the buffer is destroyed.
+ *
+ * A buffer constructed without a stream holds its text in memory instead: it
+ * grows as needed and is never written, so that a thread can format text that
+ * another thread writes later, with data() and size().
+ */
+class OutputBuffer
+{
+private:
+	/**
+	 * @brief The stream to which the buffer is written, or nullptr if the text is held in memory.
+	 */
+	ostream* _stream;
+
+	/**
+	 * @brief The storage of the buffer.
+	 */
+	vector<char> _buffer;
+
+	/**
+	 * @brief The number of characters in the buffer.
+	 */
+	size_t _size;
+
+public:
+	/**
+	 * @brief Constructs an empty buffer writing to a stream.
+	 *
+	 * @param stream The stream to which the buffer is written.
+	 * @param capacity The number of characters the buffer holds before being written.
+	 */
+	explicit OutputBuffer(ostream& stream, size_t capacity = OUTPUT_BUFFER_CAPACITY)
+		: _stream(&stream), _buffer(capacity > 0 ? capacity : 1), _size(0) {}
+
+	/**
+	 * @brief Constructs an empty buffer holding its text in memory.
+	 *
+	 * @param capacity The number of characters the buffer holds before growing.
+	 */
+	explicit OutputBuffer(size_t capacity = OUTPUT_BUFFER_CAPACITY)
+		: _stream(nullptr), _buffer(capacity > 0 ? capacity : 1), _size(0) {}
+
+	/**
+	 * @brief Destructor for the OutputBuffer class, writing the remaining characters.
+	 */
+	~OutputBuffer()
+	{
+		flush();
+	}
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator =(const OutputBuffer&) = delete;
+
+	/**
+	 * @brief Reserves room for characters at the end of the buffer.
+	 *
+	 * The characters must then be written to the returned pointer and committed.
+	 * The buffer grows if it cannot hold the given number of characters.
+	 *
+	 * @param length The number of characters to reserve.
+	 * @return char* A pointer to the reserved characters.
+	 */
+	inline char* reserve(size_t length);
+
+	/**
+	 * @brief Commits characters written to the reserved room.
+	 *
+	 * @param length The number of characters written.
+	 */
+	void commit(size_t length)
+	{
+		_size += length;
+	}
+
+	/**
+	 * @brief Appends characters to the buffer.
+	 *
+	 * @param text The characters to append.
+	 * @param length The number of characters to append.
+	 */
+	void append(const char* text, size_t length)
+	{
+		memcpy(reserve(length), text, length);
+		_size += length;
+	}
+
+	/**
+	 * @brief Appends a character to the buffer.
+	 *
+	 * @param c The character to append.
+	 */
+	void append(char c)
+	{
+		*reserve(1) = c;
+		++_size;
+	}
+
+	/**
+	 * @brief Appends characters followed by spaces, as a left-aligned field.
+	 *
+	 * Nothing is padded if the characters are at least as long as the field.
+	 *
+	 * @param text The characters to append.
+	 * @param length The number of characters to append.
+	 * @param width The width of the field.
+	 */
+	inline void appendLeft(const char* text, size_t length, size_t width);
+
+	/**
+	 * @brief Appends spaces followed by characters, as a right-aligned field.
+	 *
+	 * Nothing is padded if the characters are at least as long as the field.
+	 *
+	 * @param text The characters to append.
+	 * @param length The number of characters to append.
+	 * @param width The width of the field.
+	 */
+	inline void appendRight(const char* text, size_t length, size_t width);
+
+	/**
+	 * @brief Retrieves the characters of the buffer.
+	 *
+	 * @return const char* The characters, valid until the buffer is modified.
+	 */
+	const char* data() const
+	{
+		return _buffer.data();
+	}
+
+	/**
+	 * @brief Retrieves the number of characters of the buffer.
+	 *
+	 * @return size_t The number of characters not written yet.
+	 */
+	size_t size() const
+	{
+		return _size;
+	}
+
+	/**
+	 * @brief Empties the buffer without writing it, keeping its storage.
+	 */
+	void clear()
+	{
+		_size = 0;
+	}
+
+	/**
+	 * @brief Writes the characters of the buffer to the stream and empties the buffer.
+	 *
+	 * Nothing is done if the buffer holds its text in memory.
+	 */
+	void flush()
+	{
+		if (_size > 0 && _stream != nullptr)
+		{
+			STATS_COUNT(StatsCounter::BytesWritten, _size);
+			_stream->write(_buffer.data(), (streamsize)_size);
+			_size = 0;
+		}
+	}
+};
+
+/**
+ * @brief Reserves room for characters at the end of the buffer.
+ *
+ * This function writes the buffer to the stream if the characters do not fit in
+ * its remaining room, and grows it if they do not fit in an empty buffer either.
+ * A buffer holding its text in memory is doubled instead, keeping its text.
+ *
+ * @param length The number of characters to reserve.
+ * @return char* A pointer to the reserved characters.
+ */
+char* OutputBuffer::reserve(size_t length)
+{
+	// Write the buffer if the characters do not fit in its remaining room
+	if (_size + length > _buffer.size())
+	{
+		// Grow a buffer held in memory, keeping its text
+		if (_stream == nullptr)
+		{
+			_buffer.resize(max(_buffer.size() * 2, _size + length));
+			return _buffer.data() + _size;
+		}
+
+		flush();
+
+		// Grow the buffer if the characters do not fit in it at all
+		if (length > _buffer.size())
+		{
+			_buffer.resize(length);
+		}
+	}
+
+	return _buffer.data() + _size;
+}
+
+/**
+ * @brief Appends characters followed by spaces, as a left-aligned field.
+ *
+ * @param text The characters to append.
+ * @param length The number of characters to append.
+ * @param width The width of the field.
+ */
+void OutputBuffer::appendLeft(const char* text, size_t length, size_t width)
+{
+	size_t padding = (length < width) ? width - length : 0;
+	char* out = reserve(length + padding);
+
+	memcpy(out, text, length);
+	memset(out + length, ' ', padding);
+
+	_size += length + padding;
+}
+
+/**
+ * @brief Appends spaces followed by characters, as a right-aligned field.
+ *
+ * @param text The characters to append.
+ * @param length The number of characters to append.
+ * @param width The width of the field.
+ */
+void OutputBuffer::appendRight(const char* text, size_t length, size_t width)
+{
+	size_t padding = (length < width) ? width - length : 0;
+	char* out = reserve(length + padding);
+
+	memset(out, ' ', padding);
+	memcpy(out + padding, text, length);
+
+	_size += length + padding;
+}
+
+#endif // OUTPUT_BUFFER_H
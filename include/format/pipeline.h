@@ -0,0 +1,314 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "format/record_format.h"
+#include "format/table_format.h"
+#include "network/segment_plan.h"
+#include "network/subnet_range.h"
+#include "utils/parallel.h"
+#include "utils/stats.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define PIPELINE_CHUNK_SIZE 4096 ///< The number of subnets formatted at a time by a formatter thread.
+#define PIPELINE_SLOTS_PER_THREAD 2 ///< The number of chunk buffers per formatter thread.
+
+/**
+ * @brief Writes a subnet of a range in a format, as a table row or as a record.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the subnet.
+ * @param subnet The subnet to write.
+ * @param format The format of the subnet.
+ */
+template <typename Traits>
+void writePipelinedSubnet(OutputBuffer& out, const Subnet<Traits>& subnet, OutputFormat format)
+{
+	switch (format)
+	{
+		case OutputFormat::Table:
+			TableFormat<Traits>::writeRow(out, subnet);
+			break;
+
+		case OutputFormat::Csv:
+			writeCsvRecord<Traits>(out, subnet);
+			break;
+
+		case OutputFormat::Ndjson:
+			writeJsonRecord<Traits>(out, subnet);
+			break;
+
+		case OutputFormat::Binary:
+			writeBinaryRecord<Traits>(out, subnet);
+			break;
+	}
+}
+
+/**
+ * @brief Writes the subnets of a range in a format, overlapping their computation, their formatting and their writing.
+ *
+ * The range is cut into chunks of PIPELINE_CHUNK_SIZE subnets, claimed in order
+ * by the formatter threads with an atomic counter, so producing a chunk costs a
+ * single increment. Each formatter computes the subnets of its chunk from the
+ * lazy range and formats them into the buffer of a slot of a bounded ring, and
+ * the calling thread writes the buffers to the stream in order, one large
+ * write per chunk, as soon as each one is ready.
+ *
+ * The ring holds PIPELINE_SLOTS_PER_THREAD buffers per formatter, and a chunk
+ * waits for its slot to be written before being formatted, so the memory used
+ * is bounded by the ring whatever the number of subnets, the first bytes are
+ * written as soon as the first chunk is formatted, and the throughput is that
+ * of the slowest stage. The slots are handed over under a lock, taken twice
+ * per chunk of thousands of subnets.
+ *
+ * The output is the same as the table printed by a segmented network, or as
+ * the records written by writeRecords(), whatever the number of threads. The
+ * calling thread counts as one of the threads, so threadCount - 1 formatters
+ * are started, and a single thread or a range of a single chunk is formatted
+ * and written by the calling thread alone, one chunk after the other.
+ *
+ * The range is any sequence of subnets whose iterator can be advanced to an
+ * index, such as a SubnetRange or a SegmentPlan.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @tparam Range The type of the range, providing size(), begin() and an iterator supporting + and ++.
+ * @param s The output stream to which the subnets are written.
+ * @param range The range of the subnets.
+ * @param format The format of the subnets.
+ * @param threadCount The number of threads, the calling thread included, 0 meaning one per hardware thread.
+ * @throws The first exception thrown by a formatter or by the stream, once all the threads have finished.
+ */
+template <typename Traits, typename Range>
+void writePipelinedRange(ostream& s, const Range& range, OutputFormat format, unsigned threadCount)
+{
+	STATS_TIMER(StatsPhase::Print);
+
+	uint64_t chunkCount = (range.size() + PIPELINE_CHUNK_SIZE - 1) / PIPELINE_CHUNK_SIZE;
+	size_t totalThreads = resolveThreadCount(threadCount);
+
+	// Write the subnets of a chunk into a buffer
+	auto formatChunk = [&range, format](OutputBuffer& out, uint64_t chunk)
+	{
+		uint64_t begin = chunk * PIPELINE_CHUNK_SIZE;
+		uint64_t end = min(begin + PIPELINE_CHUNK_SIZE, range.size());
+		typename Range::iterator it = range.begin() + (int64_t)begin;
+
+		for (uint64_t i = begin; i < end; ++i, ++it)
+		{
+			writePipelinedSubnet<Traits>(out, *it, format);
+		}
+	};
+
+	{
+		OutputBuffer out(s);
+
+		// Write the header of the table or of the CSV records
+		if (format == OutputFormat::Table)
+		{
+			TableFormat<Traits>::writeHeader(out);
+		}
+		else if (format == OutputFormat::Csv)
+		{
+			writeCsvHeader<Traits>(out);
+		}
+
+		// Write the chunks directly if there is a single chunk or a single thread, there is nothing to overlap
+		if (chunkCount <= 1 || totalThreads == 1)
+		{
+			for (uint64_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				formatChunk(out, chunk);
+			}
+
+			if (format == OutputFormat::Table)
+			{
+				TableFormat<Traits>::writeFooter(out);
+			}
+
+			return;
+		}
+	}
+
+	// A buffer of the ring, holding a formatted chunk until it is written
+	struct Slot
+	{
+		OutputBuffer buffer;
+		bool ready = false;
+	};
+
+	size_t formatterCount = totalThreads - 1;
+	vector<Slot> slots(formatterCount * PIPELINE_SLOTS_PER_THREAD);
+
+	atomic<uint64_t> next(0);
+	mutex lock;
+	condition_variable slotFree;
+	condition_variable slotReady;
+	uint64_t written = 0;
+	bool failed = false;
+	exception_ptr error;
+
+	// Stop the pipeline on the first error
+	auto fail = [&]()
+	{
+		lock_guard<mutex> guard(lock);
+
+		if (!failed)
+		{
+			failed = true;
+			error = current_exception();
+		}
+
+		slotFree.notify_all();
+		slotReady.notify_all();
+	};
+
+	// Claim the chunks in order and format each one into its slot once the slot is written
+	auto formatter = [&]()
+	{
+		try
+		{
+			for (uint64_t chunk = next.fetch_add(1); chunk < chunkCount; chunk = next.fetch_add(1))
+			{
+				Slot& slot = slots[chunk % slots.size()];
+
+				{
+					unique_lock<mutex> guard(lock);
+					slotFree.wait(guard, [&]() { return failed || chunk < written + slots.size(); });
+
+					if (failed)
+					{
+						return;
+					}
+				}
+
+				slot.buffer.clear();
+				formatChunk(slot.buffer, chunk);
+
+				{
+					lock_guard<mutex> guard(lock);
+					slot.ready = true;
+				}
+
+				slotReady.notify_one();
+			}
+		}
+		catch (...)
+		{
+			fail();
+		}
+	};
+
+	vector<thread> formatters;
+
+	// Start the formatters, going on with the ones started if a thread cannot be started
+	try
+	{
+		formatters.reserve(formatterCount);
+
+		for (size_t i = 0; i < formatterCount; ++i)
+		{
+			formatters.emplace_back(formatter);
+		}
+	}
+	catch (...)
+	{
+		if (formatters.empty())
+		{
+			throw;
+		}
+	}
+
+	// Write the chunks in order as soon as they are formatted
+	try
+	{
+		for (uint64_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			Slot& slot = slots[chunk % slots.size()];
+
+			{
+				unique_lock<mutex> guard(lock);
+				slotReady.wait(guard, [&]() { return failed || slot.ready; });
+
+				if (failed)
+				{
+					break;
+				}
+			}
+
+			STATS_COUNT(StatsCounter::BytesWritten, slot.buffer.size());
+			s.write(slot.buffer.data(), (streamsize)slot.buffer.size());
+
+			{
+				lock_guard<mutex> guard(lock);
+				slot.ready = false;
+				++written;
+			}
+
+			slotFree.notify_all();
+		}
+	}
+	catch (...)
+	{
+		fail();
+	}
+
+	for (thread& t : formatters)
+	{
+		t.join();
+	}
+
+	// Rethrow the first error
+	if (error)
+	{
+		rethrow_exception(error);
+	}
+
+	// Terminate the table
+	if (format == OutputFormat::Table)
+	{
+		OutputBuffer out(s);
+		TableFormat<Traits>::writeFooter(out);
+	}
+}
+
+/**
+ * @brief Writes the subnets of a range in a format, overlapping their computation, their formatting and their writing.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param s The output stream to which the subnets are written.
+ * @param range The range of the subnets.
+ * @param format The format of the subnets.
+ * @param threadCount The number of threads, the calling thread included, 0 meaning one per hardware thread.
+ * @throws The first exception thrown by a formatter or by the stream, once all the threads have finished.
+ */
+template <typename Traits>
+void writePipelined(ostream& s, const SubnetRange<Traits>& range, OutputFormat format, unsigned threadCount = 1)
+{
+	writePipelinedRange<Traits>(s, range, format, threadCount);
+}
+
+/**
+ * @brief Writes the subnets of a plan depth-first in a format, overlapping their computation, their formatting and their writing.
+ *
+ * The chunks of the plan are cut by index, so the formatter threads compute
+ * different branches of the tree in parallel, each one descending to its chunk
+ * from the network, while the subnets are written in depth-first order.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param s The output stream to which the subnets are written.
+ * @param plan The plan of the subnets.
+ * @param format The format of the subnets.
+ * @param threadCount The number of threads, the calling thread included, 0 meaning one per hardware thread.
+ * @throws The first exception thrown by a formatter or by the stream, once all the threads have finished.
+ */
+template <typename Traits>
+void writePipelined(ostream& s, const SegmentPlan<Traits>& plan, OutputFormat format, unsigned threadCount = 1)
+{
+	writePipelinedRange<Traits>(s, plan, format, threadCount);
+}
+
+#endif // PIPELINE_H
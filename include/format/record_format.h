@@ -0,0 +1,279 @@
+#ifndef RECORD_FORMAT_H
+#define RECORD_FORMAT_H
+
+#include "format/output_buffer.h"
+#include "format/address_format.h"
+#include "network/subnet_range.h"
+#include <string>
+#include <vector>
+
+/**
+ * @enum OutputFormat
+ * @brief Layout in which the subnets of a network are written.
+ */
+enum class OutputFormat
+{
+	Table, ///< A box table meant to be read in a terminal.
+	Csv, ///< Comma-separated values, with a header line.
+	Ndjson, ///< One JSON object per line.
+	Binary ///< Fixed-size records of the network address in network byte order followed by a prefix length byte.
+};
+
+/**
+ * @brief Parses the name of an output format.
+ *
+ * @param name The name of the format: "table", "csv", "ndjson" or "binary".
+ * @param format The format, only set if the name is valid.
+ * @return bool True if the name is the name of a format, false otherwise.
+ */
+bool parseOutputFormat(const string& name, OutputFormat& format);
+
+/**
+ * @brief Writes the header line of the CSV records of a family.
+ *
+ * The columns are network, prefix_length, first_host, last_host, then broadcast
+ * if the family has a broadcast address.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the header.
+ */
+template <typename Traits>
+void writeCsvHeader(OutputBuffer& out)
+{
+	static const char header[] = "network,prefix_length,first_host,last_host";
+	static const char broadcast[] = ",broadcast";
+
+	out.append(header, sizeof(header) - 1);
+
+	if (Traits::HAS_BROADCAST)
+	{
+		out.append(broadcast, sizeof(broadcast) - 1);
+	}
+
+	out.append('\n');
+}
+
+/**
+ * @brief Writes a subnet as a CSV record.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the record.
+ * @param subnet The subnet to write.
+ */
+template <typename Traits>
+void writeCsvRecord(OutputBuffer& out, const Subnet<Traits>& subnet)
+{
+	// Reserve room for the addresses, the prefix length and the separators
+	char* begin = out.reserve(4 * Traits::MAX_LENGTH + DECIMAL_MAX_LENGTH + 5);
+	char* it = begin;
+
+	typename Traits::value_type ip = subnet.getValue();
+	int prefixLength = subnet.getPrefixLength();
+
+	// Write the network address and the prefix length
+	it += Traits::format(ip, it);
+	*it++ = ',';
+	it += formatDecimal((uint64_t)prefixLength, it);
+	*it++ = ',';
+
+	// Write the host range
+	it += Traits::format(Traits::firstHost(ip, prefixLength), it);
+	*it++ = ',';
+	it += Traits::format(Traits::lastHost(ip, prefixLength), it);
+
+	// Write the broadcast address
+	if (Traits::HAS_BROADCAST)
+	{
+		*it++ = ',';
+		it += Traits::format(ip | Traits::hostMask(prefixLength), it);
+	}
+
+	*it++ = '\n';
+
+	out.commit((size_t)(it - begin));
+}
+
+/**
+ * @brief Writes a subnet as a JSON object on its own line.
+ *
+ * The keys are the names of the CSV columns, the addresses are strings and
+ * the prefix length is a number.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the record.
+ * @param subnet The subnet to write.
+ */
+template <typename Traits>
+void writeJsonRecord(OutputBuffer& out, const Subnet<Traits>& subnet)
+{
+	static const char network[] = "{\"network\":\"";
+	static const char prefixLengthKey[] = "\",\"prefix_length\":";
+	static const char firstHost[] = ",\"first_host\":\"";
+	static const char lastHost[] = "\",\"last_host\":\"";
+	static const char broadcast[] = "\",\"broadcast\":\"";
+	static const char end[] = "\"}\n";
+
+	// Reserve room for the addresses, the prefix length and the keys
+	char* begin = out.reserve(4 * Traits::MAX_LENGTH + DECIMAL_MAX_LENGTH + sizeof(network) + sizeof(prefixLengthKey) + sizeof(firstHost) + sizeof(lastHost) + sizeof(broadcast) + sizeof(end));
+	char* it = begin;
+
+	typename Traits::value_type ip = subnet.getValue();
+	int prefixLength = subnet.getPrefixLength();
+
+	// Appends a key to the record
+	auto appendKey = [&it](const char* key, size_t length)
+	{
+		memcpy(it, key, length);
+		it += length;
+	};
+
+	// Write the network address and the prefix length
+	appendKey(network, sizeof(network) - 1);
+	it += Traits::format(ip, it);
+	appendKey(prefixLengthKey, sizeof(prefixLengthKey) - 1);
+	it += formatDecimal((uint64_t)prefixLength, it);
+
+	// Write the host range
+	appendKey(firstHost, sizeof(firstHost) - 1);
+	it += Traits::format(Traits::firstHost(ip, prefixLength), it);
+	appendKey(lastHost, sizeof(lastHost) - 1);
+	it += Traits::format(Traits::lastHost(ip, prefixLength), it);
+
+	// Write the broadcast address
+	if (Traits::HAS_BROADCAST)
+	{
+		appendKey(broadcast, sizeof(broadcast) - 1);
+		it += Traits::format(ip | Traits::hostMask(prefixLength), it);
+	}
+
+	appendKey(end, sizeof(end) - 1);
+
+	out.commit((size_t)(it - begin));
+}
+
+/**
+ * @brief Writes a subnet as a fixed-size binary record.
+ *
+ * The record holds the ADDRESS_BITS / 8 bytes of the network address in network
+ * byte order, followed by a byte holding the prefix length.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the record.
+ * @param subnet The subnet to write.
+ */
+template <typename Traits>
+void writeBinaryRecord(OutputBuffer& out, const Subnet<Traits>& subnet)
+{
+	const size_t addressBytes = Traits::ADDRESS_BITS / 8;
+	unsigned char* record = (unsigned char*)out.reserve(addressBytes + 1);
+
+	Traits::toBytes(subnet.getValue(), record);
+	record[addressBytes] = (unsigned char)subnet.getPrefixLength();
+
+	out.commit(addressBytes + 1);
+}
+
+/**
+ * @brief Writes a subnet in CIDR notation on its own line.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the record.
+ * @param subnet The subnet to write.
+ */
+template <typename Traits>
+void writeCidrRecord(OutputBuffer& out, const Subnet<Traits>& subnet)
+{
+	// Reserve room for the address, the prefix length and the separators
+	char* begin = out.reserve(Traits::MAX_LENGTH + DECIMAL_MAX_LENGTH + 2);
+	char* it = begin;
+
+	it += Traits::format(subnet.getValue(), it);
+	*it++ = '/';
+	it += formatDecimal((uint64_t)subnet.getPrefixLength(), it);
+	*it++ = '\n';
+
+	out.commit((size_t)(it - begin));
+}
+
+/**
+ * @brief Writes a sequence of subnets as records of the given format.
+ *
+ * The CSV header is written before the first record.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @tparam Iterator The type of the iterators over the subnets.
+ * @param out The buffer receiving the records.
+ * @param begin The iterator to the first subnet.
+ * @param end The iterator past the last subnet.
+ * @param format The format of the records, any format but OutputFormat::Table.
+ * @throws std::invalid_argument If the format is OutputFormat::Table.
+ */
+template <typename Traits, typename Iterator>
+void writeRecords(OutputBuffer& out, Iterator begin, Iterator end, OutputFormat format)
+{
+	STATS_TIMER(StatsPhase::Print);
+
+	switch (format)
+	{
+		case OutputFormat::Csv:
+			writeCsvHeader<Traits>(out);
+
+			for (Iterator it = begin; it != end; ++it)
+			{
+				writeCsvRecord<Traits>(out, *it);
+			}
+			break;
+
+		case OutputFormat::Ndjson:
+			for (Iterator it = begin; it != end; ++it)
+			{
+				writeJsonRecord<Traits>(out, *it);
+			}
+			break;
+
+		case OutputFormat::Binary:
+			for (Iterator it = begin; it != end; ++it)
+			{
+				writeBinaryRecord<Traits>(out, *it);
+			}
+			break;
+
+		default:
+			throw invalid_argument("The table format is not written as records.");
+	}
+}
+
+/**
+ * @brief Writes the subnets of a range as records of the given format.
+ *
+ * The subnets are generated and written one at a time, so the text of the whole
+ * range is never held in memory. The CSV header is written before the first record.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the records.
+ * @param range The subnets to write.
+ * @param format The format of the records, any format but OutputFormat::Table.
+ * @throws std::invalid_argument If the format is OutputFormat::Table.
+ */
+template <typename Traits>
+void writeRecords(OutputBuffer& out, const SubnetRange<Traits>& range, OutputFormat format)
+{
+	writeRecords<Traits>(out, range.begin(), range.end(), format);
+}
+
+/**
+ * @brief Writes a list of subnets as records of the given format.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param out The buffer receiving the records.
+ * @param subnets The subnets to write.
+ * @param format The format of the records, any format but OutputFormat::Table.
+ * @throws std::invalid_argument If the format is OutputFormat::Table.
+ */
+template <typename Traits>
+void writeRecords(OutputBuffer& out, const vector<Subnet<Traits>>& subnets, OutputFormat format)
+{
+	writeRecords<Traits>(out, subnets.begin(), subnets.end(), format);
+}
+
+#endif // RECORD_FORMAT_H
@@ -0,0 +1,157 @@
+#ifndef TABLE_FORMAT_H
+#define TABLE_FORMAT_H
+
+#include "format/output_buffer.h"
+#include "network/subnet.h"
+#include "utils/uint128.h"
+
+/**
+ * @brief Writes the header of the table of IPv4 subnets.
+ *
+ * @param out The buffer receiving the header.
+ */
+void writeIPv4TableHeader(OutputBuffer& out);
+
+/**
+ * @brief Writes a row of the table of IPv4 subnets.
+ *
+ * @param out The buffer receiving the row.
+ * @param ip The network address of the subnet.
+ * @param prefixLength The prefix length of the subnet.
+ * @param firstIp The first host address of the subnet.
+ * @param lastIp The last host address of the subnet.
+ * @param broadcastIp The broadcast address of the subnet.
+ * @param capacity The number of addresses of the subnet.
+ */
+void writeIPv4TableRow(OutputBuffer& out, uint32_t ip, int prefixLength, uint32_t firstIp, uint32_t lastIp, uint32_t broadcastIp, uint64_t capacity);
+
+/**
+ * @brief Writes the footer of the table of IPv4 subnets, without a trailing newline.
+ *
+ * @param out The buffer receiving the footer.
+ */
+void writeIPv4TableFooter(OutputBuffer& out);
+
+/**
+ * @brief Writes the header of the table of IPv6 subnets.
+ *
+ * @param out The buffer receiving the header.
+ */
+void writeIPv6TableHeader(OutputBuffer& out);
+
+/**
+ * @brief Writes a row of the table of IPv6 subnets.
+ *
+ * @param out The buffer receiving the row.
+ * @param ip The network address of the subnet.
+ * @param prefixLength The prefix length of the subnet.
+ * @param firstIp The first host address of the subnet.
+ * @param lastIp The last host address of the subnet.
+ */
+void writeIPv6TableRow(OutputBuffer& out, const UInt128& ip, int prefixLength, const UInt128& firstIp, const UInt128& lastIp);
+
+/**
+ * @brief Writes the footer of the table of IPv6 subnets, without a trailing newline.
+ *
+ * @param out The buffer receiving the footer.
+ */
+void writeIPv6TableFooter(OutputBuffer& out);
+
+/**
+ * @struct TableFormat
+ * @brief Writes the table of the subnets of an address family.
+ *
+ * The specializations forward to the writers of their family, so that code
+ * generic over the family writes its table without any virtual call.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+struct TableFormat;
+
+/**
+ * @struct TableFormat<IPv4Traits>
+ * @brief Writes the table of IPv4 subnets.
+ */
+template <>
+struct TableFormat<IPv4Traits>
+{
+	/**
+	 * @brief Writes the header of the table.
+	 *
+	 * @param out The buffer receiving the header.
+	 */
+	static void writeHeader(OutputBuffer& out)
+	{
+		writeIPv4TableHeader(out);
+	}
+
+	/**
+	 * @brief Writes the row of a subnet.
+	 *
+	 * @param out The buffer receiving the row.
+	 * @param subnet The subnet to write.
+	 */
+	static void writeRow(OutputBuffer& out, const Subnet<IPv4Traits>& subnet)
+	{
+		uint32_t ip = subnet.getValue();
+		int prefixLength = subnet.getPrefixLength();
+
+		writeIPv4TableRow(out, ip, prefixLength, IPv4Traits::firstHost(ip, prefixLength), IPv4Traits::lastHost(ip, prefixLength),
+			ip | IPv4Traits::hostMask(prefixLength), subnet.getIp().calculateCapacity(prefixLength).getLow());
+	}
+
+	/**
+	 * @brief Writes the footer of the table.
+	 *
+	 * @param out The buffer receiving the footer.
+	 */
+	static void writeFooter(OutputBuffer& out)
+	{
+		writeIPv4TableFooter(out);
+	}
+};
+
+/**
+ * @struct TableFormat<IPv6Traits>
+ * @brief Writes the table of IPv6 subnets.
+ */
+template <>
+struct TableFormat<IPv6Traits>
+{
+	/**
+	 * @brief Writes the header of the table.
+	 *
+	 * @param out The buffer receiving the header.
+	 */
+	static void writeHeader(OutputBuffer& out)
+	{
+		writeIPv6TableHeader(out);
+	}
+
+	/**
+	 * @brief Writes the row of a subnet.
+	 *
+	 * @param out The buffer receiving the row.
+	 * @param subnet The subnet to write.
+	 */
+	static void writeRow(OutputBuffer& out, const Subnet<IPv6Traits>& subnet)
+	{
+		UInt128 ip = subnet.getValue();
+		int prefixLength = subnet.getPrefixLength();
+
+		writeIPv6TableRow(out, ip, prefixLength, IPv6Traits::firstHost(ip, prefixLength), IPv6Traits::lastHost(ip, prefixLength));
+	}
+
+	/**
+	 * @brief Writes the footer of the table.
+	 *
+	 * @param out The buffer receiving the footer.
+	 */
+	static void writeFooter(OutputBuffer& out)
+	{
+		writeIPv6TableFooter(out);
+	}
+};
+
+#endif // TABLE_FORMAT_H
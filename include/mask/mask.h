@@ -1,8 +1,10 @@
 #ifndef MASK_H
 #define MASK_H
 
+#include "utils/uint128.h"
+#include "utils/parse_status.h"
+#include "utils/utils.h"
 #include <string>
-#include <vector>
 #include <cstdint>
 #include <ostream>
 #include <sstream>
@@ -14,9 +16,56 @@ using namespace std;
 #define MASK_MIN_PREFIX 1 ///< The minimum prefix length for a network mask.
 #define MASK_MAX_PREFIX 128 ///< The maximum prefix length for a network mask.
 
+/**
+ * @struct MaskTable
+ * @brief Values of the network masks of every prefix length and of their complements.
+ *
+ * The values are 128 bits wide and aligned on the most significant bit, the
+ * first octet of a mask being the most significant octet of its value.
+ */
+struct MaskTable
+{
+	/**
+	 * @brief The masks, indexed by prefix length, whose prefix length most significant bits are set.
+	 */
+	UInt128 masks[MASK_MAX_PREFIX + 1];
+
+	/**
+	 * @brief The complements of the masks, indexed by prefix length.
+	 */
+	UInt128 complements[MASK_MAX_PREFIX + 1];
+};
+
+/**
+ * @brief Computes the values of the masks of every prefix length.
+ *
+ * @return MaskTable The values of the masks and of their complements.
+ */
+constexpr MaskTable makeMaskTable()
+{
+	MaskTable table = {};
+
+	for (int prefixLength = 0; prefixLength <= MASK_MAX_PREFIX; ++prefixLength)
+	{
+		table.masks[prefixLength] = ~UInt128::lowBits(MASK_MAX_PREFIX - prefixLength);
+		table.complements[prefixLength] = UInt128::lowBits(MASK_MAX_PREFIX - prefixLength);
+	}
+
+	return table;
+}
+
+/**
+ * @brief The values of the masks, computed at compile time.
+ */
+inline constexpr MaskTable MASK_TABLE = makeMaskTable();
+
 /**
  * @class Mask
  * @brief Represents a network mask.
+ *
+ * A mask is a plain value made of its prefix length, its number of octets and
+ * whether it is complemented. Its octets are read from MASK_TABLE, so masks are
+ * built, copied and complemented without any allocation, at compile time if needed.
  */
 class Mask 
 {
@@ -27,12 +76,17 @@ private:
 	int _prefixLength;
 
 	/**
-	 * @brief A vector containing the octets of the network mask.
+	 * @brief The number of octets of the network mask.
 	 * 
-	 * This vector stores the individual octets (8-bit values) that make up the network mask.
-	 * Each element in the vector represents one octet of the mask.
+	 * A mask has as many octets as needed to hold its prefix, the last octet
+	 * being partially set if the prefix length is not a multiple of 8.
+	 */
+	int _size;
+
+	/**
+	 * @brief Whether each bit of the octets of the mask is inverted.
 	 */
-	vector<uint8_t> _maskOctets;
+	bool _complement;
 
 	/**
 	 * @brief Checks if the given prefix length is valid.
@@ -43,28 +97,32 @@ private:
 	 * @param prefixLength The prefix length to be validated.
 	 * @return bool true if the prefix length is within the valid range, false otherwise.
 	 */
-	bool isValidPrefixLength(int prefixLength) const
+	static constexpr bool isValidPrefixLength(int prefixLength)
 	{
 		return prefixLength >= MASK_MIN_PREFIX && prefixLength <= MASK_MAX_PREFIX;
 	}
 
 	/**
-	 * @brief Sets the octets of the network mask.
-	 *
-	 * This function configures the individual octets of the network mask
-	 * based on the provided parameters or internal logic. It ensures that
-	 * the mask is correctly formatted and applied to the network segment.
+	 * @brief Checks a prefix length.
+	 * 
+	 * @param prefixLength The prefix length to check.
+	 * @return int The prefix length.
+	 * @throws std::invalid_argument if the prefix length is not within the valid range.
 	 */
-	void setMaskOctets();
+	static constexpr int checkPrefixLength(int prefixLength)
+	{
+		return isValidPrefixLength(prefixLength) ? prefixLength
+			: throw invalid_argument("Invalid prefix length: must be between " + to_string(MASK_MIN_PREFIX) + " and " + to_string(MASK_MAX_PREFIX) + ".");
+	}
 
 public:
 	/**
 	 * @brief Default constructor for the Mask class.
 	 *
-	 * Initializes a Mask object with a prefix length of MASK_MIN_PREFIX and mask octets set to 0.
+	 * Initializes a Mask object with a prefix length of MASK_MIN_PREFIX and no octets.
 	 */
-	Mask()
-		: _prefixLength(MASK_MIN_PREFIX), _maskOctets(0) {}
+	constexpr Mask()
+		: _prefixLength(MASK_MIN_PREFIX), _size(0), _complement(false) {}
 
 	/**
 	 * @brief Constructs a Mask object with a specified prefix length.
@@ -72,18 +130,65 @@ public:
 	 * @param prefixLength The length of the prefix for the mask.
 	 * @throws std::invalid_argument if the prefix length is not within the valid range.
 	 */
-	Mask(int prefixLength);
+	constexpr Mask(int prefixLength)
+		: _prefixLength(checkPrefixLength(prefixLength)), _size((prefixLength + 7) / 8), _complement(false) {}
+
+	/**
+	 * @brief Creates a mask without throwing.
+	 * 
+	 * @param prefixLength The length of the prefix for the mask.
+	 * @param mask The created mask, only set if the prefix length is valid.
+	 * @return ParseStatus ParseStatus::Success if the prefix length is within the valid range,
+	 *         ParseStatus::InvalidPrefixLength otherwise.
+	 */
+	static constexpr ParseStatus tryCreate(int prefixLength, Mask& mask)
+	{
+		if (!isValidPrefixLength(prefixLength))
+		{
+			return ParseStatus::InvalidPrefixLength;
+		}
+
+		mask = Mask(prefixLength);
+
+		return ParseStatus::Success;
+	}
 
 	/**
 	 * @brief Retrieves the prefix length of the network mask.
 	 * 
 	 * @return The prefix length as an integer.
 	 */
-	int getPrefixLength() const
+	constexpr int getPrefixLength() const
 	{
 		return _prefixLength;
 	}
 
+	/**
+	 * @brief Retrieves the value of the octets of the mask.
+	 * 
+	 * @return UInt128 The octets of the mask, aligned on the most significant bit, the other bits being zero.
+	 */
+	constexpr UInt128 getValue() const
+	{
+		return (_complement ? MASK_TABLE.complements[_prefixLength] : MASK_TABLE.masks[_prefixLength]) & MASK_TABLE.masks[_size * 8];
+	}
+
+	/**
+	 * @brief Converts the mask to a value of the given number of octets.
+	 * 
+	 * The first octet of the mask is the most significant octet of the value.
+	 * The octets of the value past the octets of the mask are all set or all
+	 * cleared, as requested.
+	 * 
+	 * @param size The number of octets of the value, between 1 and 16.
+	 * @param fill Whether the octets past the mask are set instead of cleared.
+	 * @return UInt128 The mask as an integer of the given number of octets.
+	 */
+	constexpr UInt128 toValue(size_t size, bool fill) const
+	{
+		return (getValue() | (fill ? ~MASK_TABLE.masks[_size * 8] : UInt128(0))) >> (int)(128 - size * 8);
+	}
+
 	/**
 	 * @brief Retrieves the octet at the specified index.
 	 * 
@@ -110,6 +215,35 @@ public:
 	 */
 	inline uint8_t operator [](size_t index) const;
 
+	/**
+	 * @brief Retrieves the octet at the specified index, without checking the index.
+	 * 
+	 * @param index The zero-based index of the octet, which must be less than getSize().
+	 * @return uint8_t The octet at the specified index.
+	 */
+	constexpr uint8_t getOctetUnchecked(size_t index) const
+	{
+		return (uint8_t)((getValue() >> (int)(120 - index * 8)).getLow() & 0xFF);
+	}
+
+	/**
+	 * @brief Copies all the octets of the mask, the first octet first.
+	 * 
+	 * @param octets The buffer receiving the octets, at least getSize() octets long.
+	 * @return size_t The number of octets copied, getSize().
+	 */
+	size_t getOctets(uint8_t* octets) const
+	{
+		UInt128 value = getValue();
+
+		for (size_t i = 0; i < getSize(); ++i, value <<= 8)
+		{
+			octets[i] = (uint8_t)(value.getHigh() >> 56);
+		}
+
+		return getSize();
+	}
+
 	/**
 	 * @brief Retrieves the size of the mask.
 	 * 
@@ -117,9 +251,9 @@ public:
 	 * 
 	 * @return The size of the mask in octets.
 	 */
-	size_t getSize() const
+	constexpr size_t getSize() const
 	{
-		return _maskOctets.size();
+		return (size_t)_size;
 	}
 
 	/**
@@ -130,7 +264,13 @@ public:
 	 * 
 	 * @return Mask A new Mask object with each bit inverted.
 	 */
-	inline Mask operator ~() const;
+	constexpr Mask operator ~() const
+	{
+		Mask mask = *this;
+		mask._complement = !_complement;
+
+		return mask;
+	}
 
 	/**
 	 * @brief Converts the current object to its string representation.
@@ -180,36 +320,13 @@ public:
 uint8_t Mask::operator [](size_t index) const
 {
 	// Check if the index is out of range
-	if (index >= _maskOctets.size())
+	if (index >= getSize())
 	{
-		throw out_of_range("Index out of range, must be between 0 and " + to_string(_maskOctets.size() - 1) + ".");
+		throwIndexOutOfRange(getSize());
 	}
 
 	// Return the octet at the specified index
-	return _maskOctets[index];
-}
-
-/**
- * @brief Overloaded bitwise NOT operator for the Mask class.
- *
- * This operator creates a new Mask object that is the bitwise NOT
- * (inversion) of the current Mask object. Each bit in the mask octets
- * is inverted.
- *
- * @return A new Mask object with each bit in the mask octets inverted.
- */
-Mask Mask::operator ~() const
-{
-	// Create a copy of the current mask
-	Mask mask = *this;
-
-	// Iterate through the mask octets and invert each bit
-	for (vector<uint8_t>::iterator it = mask._maskOctets.begin(); it != mask._maskOctets.end(); ++it)
-	{
-		*it = ~(*it);
-	}
-
-	return mask;
+	return getOctetUnchecked(index);
 }
 
 /**
@@ -224,13 +341,13 @@ Mask Mask::operator ~() const
 ostream& Mask::print(ostream& s) const
 {
 	// Iterate through the mask octets and print each one
-	for (vector<uint8_t>::const_iterator it = _maskOctets.begin(); it != _maskOctets.end(); ++it)
+	for (size_t i = 0; i < getSize(); ++i)
 	{
 		// Print the octet as an integer
-		s << (int)(*it);
+		s << (int)getOctetUnchecked(i);
 		
 		// If the octet is not the last one, print a period
-		if (it != _maskOctets.end() - 1)
+		if (i + 1 < getSize())
 		{
 			s << ".";
 		}
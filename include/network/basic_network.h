@@ -0,0 +1,300 @@
+#ifndef BASIC_NETWORK_H
+#define BASIC_NETWORK_H
+
+#include "network/subnet_table.h"
+#include "format/table_format.h"
+#include "utils/stats.h"
+#include <stdexcept>
+
+/**
+ * @enum SegmentStatus
+ * @brief Result of checking a segmentation of a network into a number of subnets.
+ */
+enum class SegmentStatus
+{
+	Success, ///< The network can be segmented into the number of subnets.
+	NoSubnets, ///< The number of subnets is zero.
+	ExceedsCapacity ///< The number of subnets exceeds the capacity of the network.
+};
+
+/**
+ * @class BasicNetwork
+ * @brief Network of a single address family, handled as plain values.
+ *
+ * This is the engine behind IPv4Network and IPv6Network. The network and its
+ * subnets are values of the family, and the family is fixed at compile time,
+ * so segmenting the network and printing its subnets involve no allocation per
+ * subnet and no virtual call: the compiler sees and inlines all the per-subnet
+ * work. The segmentation is kept as the lazy range of the subnets, which holds
+ * its base address, prefix length and number of subnets only.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class BasicNetwork
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+private:
+	/**
+	 * @brief The network itself.
+	 */
+	Subnet<Traits> _network;
+
+	/**
+	 * @brief The subnets of the last segmentation, empty if the network is not segmented.
+	 */
+	SubnetRange<Traits> _subnets;
+
+	/**
+	 * @brief Checks if a prefix length is valid for the family.
+	 *
+	 * @param prefixLength The prefix length to check.
+	 * @return int The prefix length.
+	 * @throws std::invalid_argument If the prefix length is not valid for the family.
+	 */
+	static int checkPrefixLength(int prefixLength)
+	{
+		if (prefixLength < 0 || prefixLength > Traits::ADDRESS_BITS)
+		{
+			throw invalid_argument("Invalid prefix length: must be between 0 and " + to_string(Traits::ADDRESS_BITS) + ".");
+		}
+
+		return prefixLength;
+	}
+
+public:
+	/**
+	 * @brief Constructs a network from an address and a prefix length.
+	 *
+	 * @param ip The value of an address of the network, its host bits being ignored.
+	 * @param prefixLength The prefix length of the network.
+	 * @throws std::invalid_argument If the prefix length is not valid for the family.
+	 */
+	BasicNetwork(const value_type& ip, int prefixLength)
+		: _network(ip, checkPrefixLength(prefixLength)), _subnets(_network.getValue(), prefixLength, 0) {}
+
+	/**
+	 * @brief Retrieves the network itself.
+	 *
+	 * @return const Subnet<Traits>& The network.
+	 */
+	const Subnet<Traits>& getNetwork() const
+	{
+		return _network;
+	}
+
+	/**
+	 * @brief Retrieves the prefix length of the network.
+	 *
+	 * @return int The prefix length.
+	 */
+	int getPrefixLength() const
+	{
+		return _network.getPrefixLength();
+	}
+
+	/**
+	 * @brief Retrieves the subnets of the last segmentation.
+	 *
+	 * @return const SubnetRange<Traits>& The subnets, empty if the network is not segmented.
+	 */
+	const SubnetRange<Traits>& getSubnets() const
+	{
+		return _subnets;
+	}
+
+	/**
+	 * @brief Checks a segmentation of the network without throwing.
+	 *
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @return SegmentStatus SegmentStatus::Success if the network can be segmented into the number of subnets, the error otherwise.
+	 */
+	inline SegmentStatus checkSegment(uint64_t numberOfSubnets) const;
+
+	/**
+	 * @brief Retrieves the message of an error of a segmentation.
+	 *
+	 * @param status The error, as returned by checkSegment().
+	 * @return const char* The message, the one the segmentations report.
+	 */
+	inline static const char* getErrorMessage(SegmentStatus status);
+
+	/**
+	 * @brief Computes the range of subnets a segmentation into the given number of subnets yields.
+	 *
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @return SubnetRange<Traits> The range of the subnets.
+	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+	 */
+	inline SubnetRange<Traits> segmentRange(uint64_t numberOfSubnets) const;
+
+	/**
+	 * @brief Segments the network into a number of subnets.
+	 *
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @return const SubnetRange<Traits>& The subnets of the network.
+	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+	 */
+	const SubnetRange<Traits>& segment(uint64_t numberOfSubnets)
+	{
+		_subnets = segmentRange(numberOfSubnets);
+		return _subnets;
+	}
+
+	/**
+	 * @brief Removes the subnets of the last segmentation.
+	 */
+	void clear()
+	{
+		_subnets = SubnetRange<Traits>(_network.getValue(), getPrefixLength(), 0);
+	}
+
+	/**
+	 * @brief Segments the network into a table of subnets.
+	 *
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @param threadCount The number of threads filling the table, 0 meaning one per hardware thread.
+	 * @return SubnetTable<Traits> The table of the subnets.
+	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+	 */
+	SubnetTable<Traits> segmentTable(uint64_t numberOfSubnets, unsigned threadCount = 1) const
+	{
+		STATS_TIMER(StatsPhase::Segment);
+
+		return SubnetTable<Traits>(segmentRange(numberOfSubnets), threadCount);
+	}
+
+	/**
+	 * @brief Enumerates lazily the subnets of the network with a longer prefix length.
+	 *
+	 * @param newPrefixLength The prefix length of the subnets.
+	 * @return SubnetRange<Traits> The range of all the subnets with the new prefix length.
+	 * @throws std::invalid_argument If the new prefix length is shorter than the prefix length of the
+	 *         network or longer than the address, or if the subnets cannot be counted on 64 bits.
+	 */
+	SubnetRange<Traits> subnets(int newPrefixLength) const
+	{
+		return SubnetRange<Traits>::split(_network.getValue(), getPrefixLength(), newPrefixLength);
+	}
+
+	/**
+	 * @brief Prints the table of the subnets of the last segmentation.
+	 *
+	 * @param s The output stream to which the table will be printed.
+	 * @return ostream& A reference to the output stream.
+	 */
+	inline ostream& print(ostream& s) const;
+};
+
+/**
+ * @brief Checks a segmentation of the network without throwing.
+ *
+ * This function checks that the number of subnets is valid and does not exceed the
+ * capacity of the network, compared exactly on 128 bits. The prefix length of the
+ * subnets then fits in the address.
+ *
+ * @param numberOfSubnets The number of subnets to divide the network into.
+ * @return SegmentStatus SegmentStatus::Success if the network can be segmented into the number of subnets, the error otherwise.
+ */
+template <typename Traits>
+SegmentStatus BasicNetwork<Traits>::checkSegment(uint64_t numberOfSubnets) const
+{
+	// Check if the number of subnets is valid
+	if (numberOfSubnets < 1)
+	{
+		return SegmentStatus::NoSubnets;
+	}
+
+	// Check if the number of subnets exceeds the network capacity
+	if (UInt128(numberOfSubnets) > _network.getIp().calculateCapacity(getPrefixLength()))
+	{
+		return SegmentStatus::ExceedsCapacity;
+	}
+
+	return SegmentStatus::Success;
+}
+
+/**
+ * @brief Retrieves the message of an error of a segmentation.
+ *
+ * @param status The error, as returned by checkSegment().
+ * @return const char* The message, the one the segmentations report.
+ */
+template <typename Traits>
+const char* BasicNetwork<Traits>::getErrorMessage(SegmentStatus status)
+{
+	switch (status)
+	{
+		case SegmentStatus::Success:
+			break;
+		case SegmentStatus::NoSubnets:
+			return "Number of subnets must be greater than 0.";
+		case SegmentStatus::ExceedsCapacity:
+			return "Number of subnets must be less than or equal to the capacity of the network.";
+	}
+
+	return "";
+}
+
+/**
+ * @brief Computes the range of subnets a segmentation into the given number of subnets yields.
+ *
+ * This function checks the segmentation with checkSegment(), then computes the
+ * prefix length of the subnets, the smallest one giving at least as many subnets,
+ * with an integer logarithm.
+ *
+ * @param numberOfSubnets The number of subnets to divide the network into.
+ * @return SubnetRange<Traits> The range of the subnets.
+ * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+ */
+template <typename Traits>
+SubnetRange<Traits> BasicNetwork<Traits>::segmentRange(uint64_t numberOfSubnets) const
+{
+	SegmentStatus status = checkSegment(numberOfSubnets);
+
+	// Report the error of an invalid segmentation
+	if (status != SegmentStatus::Success)
+	{
+		throw invalid_argument(getErrorMessage(status));
+	}
+
+	STATS_COUNT(StatsCounter::Subnets, numberOfSubnets);
+
+	// Each subnet is computed directly from its index as base + index * increment
+	return SubnetRange<Traits>(_network.getValue(), getPrefixLength() + ceilLog2(numberOfSubnets), numberOfSubnets);
+}
+
+/**
+ * @brief Prints the table of the subnets of the last segmentation.
+ *
+ * The subnets are computed from the range one at a time and formatted into a
+ * buffer that is written to the stream in large blocks.
+ *
+ * @param s The output stream to which the table will be printed.
+ * @return ostream& A reference to the output stream.
+ */
+template <typename Traits>
+ostream& BasicNetwork<Traits>::print(ostream& s) const
+{
+	STATS_TIMER(StatsPhase::Print);
+
+	OutputBuffer out(s);
+
+	TableFormat<Traits>::writeHeader(out);
+
+	for (const Subnet<Traits>& subnet : _subnets)
+	{
+		TableFormat<Traits>::writeRow(out, subnet);
+	}
+
+	TableFormat<Traits>::writeFooter(out);
+
+	return s;
+}
+
+#endif // BASIC_NETWORK_H
@@ -0,0 +1,407 @@
+#ifndef INDEX_FILE_H
+#define INDEX_FILE_H
+
+#include "format/output_buffer.h"
+#include "network/prefix_trie.h"
+#include "network/subnet_range.h"
+#include "utils/stats.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+#define INDEX_FILE_MAGIC "NSINDEX" ///< The magic string opening an index file, followed by a null byte.
+#define INDEX_FILE_VERSION 1 ///< The version of the layout of the index files.
+#define INDEX_FILE_BYTE_ORDER 0x01020304u ///< The value stored in native byte order to detect a file of another byte order.
+#define INDEX_FILE_ALIGNMENT 64 ///< The alignment of the arrays of an index file, in bytes.
+
+/**
+ * @struct IndexFileHeader
+ * @brief Header of an index file, describing the arrays that follow it.
+ *
+ * An index file holds a set of subnets as three arrays, each one starting on
+ * INDEX_FILE_ALIGNMENT bytes: the network addresses as fixed-width values, the
+ * prefix lengths as bytes, and optionally the nodes of a prefix trie over the
+ * subnets. Every field is stored in native byte order, so the arrays are used
+ * in place from a mapping of the file, without being deserialized.
+ */
+struct IndexFileHeader
+{
+	/**
+	 * @brief The magic string INDEX_FILE_MAGIC.
+	 */
+	char magic[8];
+
+	/**
+	 * @brief The version of the layout, INDEX_FILE_VERSION.
+	 */
+	uint32_t version;
+
+	/**
+	 * @brief The value INDEX_FILE_BYTE_ORDER, as written by the machine of the file.
+	 */
+	uint32_t byteOrder;
+
+	/**
+	 * @brief The number of bits of the addresses, 32 for IPv4 and 128 for IPv6.
+	 */
+	uint32_t addressBits;
+
+	/**
+	 * @brief The number of address bits consumed by each level of the trie, PREFIX_TRIE_STRIDE.
+	 */
+	uint32_t stride;
+
+	/**
+	 * @brief The number of subnets.
+	 */
+	uint64_t subnetCount;
+
+	/**
+	 * @brief The number of nodes of the trie, 0 if the subnets are sorted and disjoint and have no trie.
+	 */
+	uint64_t nodeCount;
+
+	/**
+	 * @brief The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+	 */
+	uint32_t defaultSubnet;
+
+	/**
+	 * @brief Reserved, always 0.
+	 */
+	uint32_t reserved;
+
+	/**
+	 * @brief The offset of the array of the network addresses, in bytes from the start of the file.
+	 */
+	uint64_t addressesOffset;
+
+	/**
+	 * @brief The offset of the array of the prefix lengths, in bytes from the start of the file.
+	 */
+	uint64_t prefixLengthsOffset;
+
+	/**
+	 * @brief The offset of the entries of the nodes of the trie, in bytes from the start of the file.
+	 */
+	uint64_t nodesOffset;
+};
+
+/**
+ * @brief Aligns an offset of an index file on INDEX_FILE_ALIGNMENT bytes.
+ *
+ * @param offset The offset, in bytes.
+ * @return uint64_t The smallest multiple of INDEX_FILE_ALIGNMENT not less than the offset.
+ */
+constexpr uint64_t alignIndexOffset(uint64_t offset)
+{
+	return (offset + INDEX_FILE_ALIGNMENT - 1) / INDEX_FILE_ALIGNMENT * INDEX_FILE_ALIGNMENT;
+}
+
+/**
+ * @brief Creates the header of an index file, laying out its arrays.
+ *
+ * @param addressBits The number of bits of the addresses.
+ * @param addressSize The size of an address, in bytes.
+ * @param subnetCount The number of subnets.
+ * @param nodeCount The number of nodes of the trie, 0 for none.
+ * @param defaultSubnet The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+ * @return IndexFileHeader The header.
+ */
+IndexFileHeader makeIndexFileHeader(int addressBits, size_t addressSize, uint64_t subnetCount, uint64_t nodeCount, uint32_t defaultSubnet);
+
+/**
+ * @brief Checks the header of an index file held in memory.
+ *
+ * @param data The bytes of the file, such as the view of a mapped file.
+ * @param addressBits The number of bits of the addresses of the expected family.
+ * @param addressSize The size of an address of the expected family, in bytes.
+ * @return const IndexFileHeader& The header, at the start of the data.
+ * @throws std::invalid_argument If the data is not an index file of the family, of this version and of
+ *         this byte order, or if its arrays do not fit in the data.
+ */
+const IndexFileHeader& checkIndexFile(string_view data, int addressBits, size_t addressSize);
+
+/**
+ * @brief Writes the zero bytes aligning an offset of an index file.
+ *
+ * @param out The buffer receiving the bytes.
+ * @param offset The offset reached in the file, updated to the aligned offset.
+ */
+void writeIndexPadding(OutputBuffer& out, uint64_t& offset);
+
+/**
+ * @brief Writes the subnets of a range as an index file.
+ *
+ * The subnets of a range are sorted and disjoint, so the file holds no trie and
+ * an address is looked up by a binary search over the network addresses. The
+ * subnets are computed from the range while they are written, one buffer at a
+ * time, so the range is never materialized.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param s The output stream to which the file is written, opened in binary mode.
+ * @param range The range of the subnets.
+ */
+template <typename Traits>
+void writeIndexFile(ostream& s, const SubnetRange<Traits>& range)
+{
+	typedef typename Traits::value_type value_type;
+	static_assert(is_trivially_copyable<value_type>::value && sizeof(value_type) == Traits::ADDRESS_BITS / 8, "addresses must be stored as they are");
+
+	IndexFileHeader header = makeIndexFileHeader(Traits::ADDRESS_BITS, sizeof(value_type), range.size(), 0, PREFIX_TRIE_NONE);
+	OutputBuffer out(s);
+	uint64_t offset = sizeof(header);
+
+	out.append((const char*)&header, sizeof(header));
+	writeIndexPadding(out, offset);
+
+	// Write the network addresses of the subnets
+	for (Subnet<Traits> subnet : range)
+	{
+		value_type ip = subnet.getValue();
+		memcpy(out.reserve(sizeof(ip)), &ip, sizeof(ip));
+		out.commit(sizeof(ip));
+	}
+
+	offset += range.size() * sizeof(value_type);
+	writeIndexPadding(out, offset);
+
+	// Write their prefix length, shared by all the subnets, a buffer at a time
+	for (uint64_t remaining = range.size(); remaining > 0;)
+	{
+		size_t length = (size_t)min<uint64_t>(remaining, OUTPUT_BUFFER_CAPACITY);
+		memset(out.reserve(length), range.getPrefixLength(), length);
+		out.commit(length);
+		remaining -= length;
+	}
+}
+
+/**
+ * @brief Writes the subnets and the nodes of a prefix trie as an index file.
+ *
+ * The nodes are written as they are, so a lookup in the file walks the same
+ * entries as a lookup in the trie.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param s The output stream to which the file is written, opened in binary mode.
+ * @param trie The trie of the subnets.
+ */
+template <typename Traits>
+void writeIndexFile(ostream& s, const PrefixTrie<Traits>& trie)
+{
+	typedef typename Traits::value_type value_type;
+	static_assert(is_trivially_copyable<value_type>::value && sizeof(value_type) == Traits::ADDRESS_BITS / 8, "addresses must be stored as they are");
+
+	IndexFileHeader header = makeIndexFileHeader(Traits::ADDRESS_BITS, sizeof(value_type), trie.size(), trie.getNodeCount(), trie.getDefaultSubnet());
+	OutputBuffer out(s);
+	uint64_t offset = sizeof(header);
+
+	out.append((const char*)&header, sizeof(header));
+	writeIndexPadding(out, offset);
+
+	// Write the network addresses of the subnets
+	for (size_t i = 0; i < trie.size(); ++i)
+	{
+		value_type ip = trie[i].getValue();
+		memcpy(out.reserve(sizeof(ip)), &ip, sizeof(ip));
+		out.commit(sizeof(ip));
+	}
+
+	offset += trie.size() * sizeof(value_type);
+	writeIndexPadding(out, offset);
+
+	// Write their prefix lengths
+	for (size_t i = 0; i < trie.size(); ++i)
+	{
+		out.append((char)trie[i].getPrefixLength());
+	}
+
+	offset += trie.size();
+	writeIndexPadding(out, offset);
+
+	// Write the entries of the nodes directly, in one block
+	size_t length = trie.getNodeCount() * PrefixTrie<Traits>::ENTRIES * sizeof(PrefixTrieEntry);
+
+	out.flush();
+	STATS_COUNT(StatsCounter::BytesWritten, length);
+	s.write((const char*)trie.getEntries(), (streamsize)length);
+}
+
+/**
+ * @class PrefixIndex
+ * @brief Read-only longest-prefix-match index over the subnets of an index file held in memory.
+ *
+ * The index refers to the arrays of the file in place, so opening it only checks
+ * the header, whatever the number of subnets: mapping the file and constructing
+ * the index is all the loading there is. The data must outlive the index, and
+ * the arrays are trusted past the checks of their bounds. Lookups walk the
+ * nodes of the trie of the file, like PrefixTrie, or search the sorted network
+ * addresses of a file without a trie. They do not modify anything, so any
+ * number of threads may look up addresses concurrently.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class PrefixIndex
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+private:
+	/**
+	 * @brief The network addresses of the subnets.
+	 */
+	const value_type* _ips;
+
+	/**
+	 * @brief The prefix lengths of the subnets.
+	 */
+	const unsigned char* _prefixLengths;
+
+	/**
+	 * @brief The entries of the nodes of the trie, or nullptr if the file has no trie.
+	 */
+	const PrefixTrieEntry* _entries;
+
+	/**
+	 * @brief The number of subnets.
+	 */
+	size_t _size;
+
+	/**
+	 * @brief The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+	 */
+	uint32_t _defaultSubnet;
+
+public:
+	/**
+	 * @brief Constructs an index over the bytes of an index file.
+	 *
+	 * @param data The bytes of the file, such as the view of a mapped file, aligned on 8 bytes.
+	 * @throws std::invalid_argument If the data is not a valid index file of the family.
+	 */
+	explicit PrefixIndex(string_view data)
+	{
+		const IndexFileHeader& header = checkIndexFile(data, Traits::ADDRESS_BITS, sizeof(value_type));
+
+		_ips = (const value_type*)(data.data() + header.addressesOffset);
+		_prefixLengths = (const unsigned char*)(data.data() + header.prefixLengthsOffset);
+		_entries = (header.nodeCount > 0) ? (const PrefixTrieEntry*)(data.data() + header.nodesOffset) : nullptr;
+		_size = (size_t)header.subnetCount;
+		_defaultSubnet = header.defaultSubnet;
+	}
+
+	/**
+	 * @brief Retrieves the number of subnets in the index.
+	 *
+	 * @return size_t The number of subnets.
+	 */
+	size_t size() const
+	{
+		return _size;
+	}
+
+	/**
+	 * @brief Checks if the index contains no subnet.
+	 *
+	 * @return bool True if the index is empty, false otherwise.
+	 */
+	bool empty() const
+	{
+		return _size == 0;
+	}
+
+	/**
+	 * @brief Checks if the lookups walk a trie instead of searching the sorted subnets.
+	 *
+	 * @return bool True if the file holds the nodes of a trie, false otherwise.
+	 */
+	bool hasTrie() const
+	{
+		return _entries != nullptr;
+	}
+
+	/**
+	 * @brief Finds the most specific subnet containing an address.
+	 *
+	 * @param ip The value of the address to look up.
+	 * @return size_t The index of the longest subnet containing the address, or size() if there is none.
+	 */
+	inline size_t find(const value_type& ip) const;
+
+	/**
+	 * @brief Finds the most specific subnet containing each address of an array.
+	 *
+	 * @param ips The values of the addresses to look up.
+	 * @param count The number of addresses.
+	 * @param indices The array receiving the index of the subnet of each address, or size() if there is none.
+	 * @param threadCount The number of threads looking up the addresses, 0 meaning one per hardware thread.
+	 */
+	void find(const value_type* ips, size_t count, size_t* indices, unsigned threadCount = 1) const
+	{
+		parallelFor(count, threadCount, [this, ips, indices](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				indices[i] = find(ips[i]);
+			}
+		});
+	}
+
+	/**
+	 * @brief Retrieves the subnet at the given index.
+	 *
+	 * @param index The index of the subnet.
+	 * @return Subnet<Traits> The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	Subnet<Traits> operator [](size_t index) const
+	{
+		if (index >= _size)
+		{
+			throwIndexOutOfRange(_size);
+		}
+
+		return Subnet<Traits>(_ips[index], _prefixLengths[index]);
+	}
+};
+
+/**
+ * @brief Finds the most specific subnet containing an address.
+ *
+ * With a trie, this function walks its nodes as PrefixTrie does. Otherwise the
+ * subnets are sorted and disjoint, so the only one that can contain the address
+ * is the last one starting at or before it, found by a binary search.
+ *
+ * @param ip The value of the address to look up.
+ * @return size_t The index of the longest subnet containing the address, or size() if there is none.
+ */
+template <typename Traits>
+size_t PrefixIndex<Traits>::find(const value_type& ip) const
+{
+	if (_entries != nullptr)
+	{
+		uint32_t best = PrefixTrie<Traits>::lookup(_entries, _defaultSubnet, ip);
+		return (best == PREFIX_TRIE_NONE) ? _size : best;
+	}
+
+	// Find the last subnet starting at or before the address
+	const value_type* it = upper_bound(_ips, _ips + _size, ip);
+
+	if (it == _ips)
+	{
+		return _size;
+	}
+
+	size_t index = (size_t)(it - _ips) - 1;
+
+	return Subnet<Traits>(_ips[index], _prefixLengths[index]).contains(ip) ? index : _size;
+}
+
+#endif // INDEX_FILE_H
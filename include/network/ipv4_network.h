@@ -3,10 +3,15 @@
 
 #include "network/network.h"
 #include "address/ipv4_address.h"
+#include "network/basic_network.h"
+#include "network/index_file.h"
 
 /**
  * @class IPv4Network
  * @brief Represents an IPv4 network.
+ *
+ * This class is the polymorphic facade of BasicNetwork<IPv4Traits>, which
+ * computes the segmentations and prints the subnets.
  */
 class IPv4Network : public Network
 {
@@ -16,24 +21,67 @@ private:
 	 */
 	IPAddress *_broadcastIp;
 
+	/**
+	 * @brief The engine handling the network as plain IPv4 values.
+	 */
+	BasicNetwork<IPv4Traits> _engine;
+
 public:
 	/**
 	 * @brief Constructs an IPv4Network object with the given IP address and prefix length.
 	 * 
 	 * @param ip The IP address of the network.
 	 * @param prefixLength The prefix length of the network, indicating the number of bits in the network portion of the address.
+	 * @param arena The arena from which the addresses of the network are allocated, or nullptr to allocate them on the heap.
 	 * @throws std::invalid_argument If the prefix length is not compatible with the address type.
 	 */
-	IPv4Network(const IPAddress& ip, int prefixLength);
+	IPv4Network(const IPAddress& ip, int prefixLength, Arena* arena = nullptr);
 
 	/**
 	 * @brief Destructor for the IPv4Network class.
 	 *
 	 * This destructor is responsible for cleaning up resources used by the IPv4Network instance.
-	 * Specifically, it deletes the dynamically allocated broadcast IP address.
+	 * Specifically, it destroys the broadcast IP address.
 	 */
 	inline virtual ~IPv4Network();
 
+	/**
+	 * @brief Move constructor for the IPv4Network class, taking over the addresses and the subnets of another network.
+	 * 
+	 * @param other The network to move from, which can then only be destroyed or assigned to.
+	 */
+	IPv4Network(IPv4Network&& other) noexcept
+		: Network(move(other)), _broadcastIp(other._broadcastIp), _engine(other._engine)
+	{
+		other._broadcastIp = nullptr;
+		other._engine.clear();
+	}
+
+	/**
+	 * @brief Move assignment operator for the IPv4Network class, replacing the addresses and the subnets with those of another network.
+	 * 
+	 * The broadcast address of this network is destroyed before the base class
+	 * takes over the allocation of the addresses of the other network.
+	 * 
+	 * @param other The network to move from, which can then only be destroyed or assigned to.
+	 * @return IPv4Network& A reference to this network.
+	 */
+	IPv4Network& operator =(IPv4Network&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyAddress(_broadcastIp);
+			_broadcastIp = other._broadcastIp;
+			other._broadcastIp = nullptr;
+
+			Network::operator =(move(other));
+			_engine = other._engine;
+			other._engine.clear();
+		}
+
+		return *this;
+	}
+
 	/**
 	 * @brief Retrieves the broadcast IP address of the network.
 	 * 
@@ -55,9 +103,105 @@ public:
 	 * The segmentation process is based on the provided number of subnets.
 	 * 
 	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @param threadCount The number of threads building the subnets, 0 meaning one per hardware thread.
+	 *                    The subnets are the same, in the same order, whatever the number of threads.
+	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+	 */
+	void segment(uint64_t numberOfSubnets, unsigned threadCount = 1) override;
+
+	/**
+	 * @brief Creates a network without throwing.
+	 * 
+	 * @param ip The IP address of the network.
+	 * @param prefixLength The prefix length of the network.
+	 * @param network The created network, only set if the prefix length is compatible with the address.
+	 * @return ParseStatus ParseStatus::Success if the network is created, ParseStatus::InvalidPrefixLength otherwise.
+	 */
+	static ParseStatus tryCreate(const IPAddress& ip, int prefixLength, unique_ptr<IPv4Network>& network)
+	{
+		if (!ip.isPrefixLengthCompatible(prefixLength))
+		{
+			return ParseStatus::InvalidPrefixLength;
+		}
+
+		network.reset(new IPv4Network(ip, prefixLength));
+
+		return ParseStatus::Success;
+	}
+
+	/**
+	 * @brief Checks a segmentation of the network without throwing.
+	 * 
+	 * segment(), segmentRange() and segmentTable() succeed with the number of subnets
+	 * if and only if this function returns SegmentStatus::Success.
+	 * 
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @return SegmentStatus SegmentStatus::Success if the network can be segmented into the number of subnets, the error otherwise.
+	 */
+	SegmentStatus checkSegment(uint64_t numberOfSubnets) const
+	{
+		return _engine.checkSegment(numberOfSubnets);
+	}
+
+	/**
+	 * @brief Computes the range of subnets a segmentation into the given number of subnets yields.
+	 * 
+	 * The range holds the same subnets segment() would create, in the same order, but
+	 * computes them on demand without modifying the network.
+	 * 
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @return SubnetRange<IPv4Traits> The range of the subnets.
+	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
+	 */
+	SubnetRange<IPv4Traits> segmentRange(uint64_t numberOfSubnets) const
+	{
+		return _engine.segmentRange(numberOfSubnets);
+	}
+
+	/**
+	 * @brief Segments the network into a table of subnets.
+	 * 
+	 * The table holds the same subnets segment() would create, stored as a single contiguous
+	 * array of network addresses built with one allocation, without modifying the network.
+	 * 
+	 * @param numberOfSubnets The number of subnets to divide the network into.
+	 * @param threadCount The number of threads filling the table, 0 meaning one per hardware thread.
+	 * @return SubnetTable<IPv4Traits> The table of the subnets.
 	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
 	 */
-	void segment(uint32_t numberOfSubnets) override;
+	SubnetTable<IPv4Traits> segmentTable(uint64_t numberOfSubnets, unsigned threadCount = 1) const
+	{
+		return _engine.segmentTable(numberOfSubnets, threadCount);
+	}
+
+	/**
+	 * @brief Enumerates lazily the subnets of the network with a longer prefix length.
+	 * 
+	 * The subnets are computed on demand by the returned range, so enumerating them
+	 * uses constant memory and does not modify the subnets stored by segment().
+	 * 
+	 * @param newPrefixLength The prefix length of the subnets.
+	 * @return SubnetRange<IPv4Traits> The range of all the subnets with the new prefix length.
+	 * @throws std::invalid_argument If the new prefix length is shorter than the prefix length of the
+	 *         network or longer than the address, or if the subnets cannot be counted on 64 bits.
+	 */
+	SubnetRange<IPv4Traits> subnets(int newPrefixLength) const
+	{
+		return _engine.subnets(newPrefixLength);
+	}
+
+	/**
+	 * @brief Writes the subnets of the last segmentation as an index file.
+	 * 
+	 * The subnets are computed from the segmentation while they are written, and the file
+	 * can then be mapped and looked up with a PrefixIndex<IPv4Traits> without being parsed.
+	 * 
+	 * @param s The output stream to which the file is written, opened in binary mode.
+	 */
+	void writeIndex(ostream& s) const
+	{
+		writeIndexFile(s, _engine.getSubnets());
+	}
 
 	/**
 	 * @brief Prints the IPv4 network details to the provided output stream.
@@ -76,11 +220,11 @@ public:
  * @brief Destructor for the IPv4Network class.
  *
  * This destructor is responsible for cleaning up resources used by the IPv4Network instance.
- * Specifically, it deletes the dynamically allocated broadcast IP address.
+ * Specifically, it destroys the broadcast IP address.
  */
 IPv4Network::~IPv4Network()
 {
-	delete _broadcastIp;
+	destroyAddress(_broadcastIp);
 }
 
 #endif // IPV4_NETWORK_H
\ No newline at end of file
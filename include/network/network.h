@@ -2,6 +2,11 @@
 #define NETWORK_H
 
 #include "address/ip_address.h"
+#include "network/subnet_range.h"
+#include "utils/arena.h"
+#include "utils/parallel.h"
+#include <memory>
+#include <mutex>
 
 /**
  * @class Network
@@ -31,29 +36,117 @@ protected:
 	Mask _mask;
 
 	/**
-	 * @brief The subnets of the network.
+	 * @brief The subnets of the network, living in _subnetArena.
 	 */
 	vector<Network*> _subnets;
 
+	/**
+	 * @brief The arena holding the subnets and their addresses, or nullptr if there are no subnets.
+	 */
+	unique_ptr<Arena> _subnetArena;
+
+	/**
+	 * @brief Whether the addresses of the network live in an arena instead of the heap.
+	 */
+	bool _arenaAllocated;
+
+	/**
+	 * @brief Clones an address, in the arena if one is given or on the heap otherwise.
+	 * 
+	 * @param ip The address to clone.
+	 * @param arena The arena from which the clone is allocated, or nullptr.
+	 * @return IPAddress* Pointer to the clone.
+	 */
+	static IPAddress* cloneAddress(const IPAddress& ip, Arena* arena)
+	{
+		if (arena == nullptr)
+		{
+			STATS_COUNT(StatsCounter::Allocations, 1);
+		}
+
+		return (arena != nullptr) ? ip.clone(*arena) : ip.clone();
+	}
+
+	/**
+	 * @brief Destroys an address of the network, in place if the addresses live in an arena.
+	 * 
+	 * @param ip The address to destroy, or nullptr if the network has been moved from.
+	 */
+	void destroyAddress(IPAddress* ip) const
+	{
+		if (ip == nullptr)
+		{
+			return;
+		}
+
+		if (_arenaAllocated)
+		{
+			ip->~IPAddress();
+		}
+		else
+		{
+			delete ip;
+		}
+	}
+
+	/**
+	 * @brief Destroys the subnets of the network and releases their arena.
+	 */
+	inline void clearSubnets();
+
+	/**
+	 * @brief Replaces the subnets of the network with the subnets of a range.
+	 * 
+	 * @tparam NetworkType The type of the subnets, IPv4Network or IPv6Network.
+	 * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+	 * @param range The range of the new subnets.
+	 * @param threadCount The number of threads building the subnets, 0 meaning one per hardware thread.
+	 */
+	template <typename NetworkType, typename Traits>
+	inline void createSubnets(const SubnetRange<Traits>& range, unsigned threadCount);
+
+	/**
+	 * @brief Move constructor for the Network class, taking over the addresses and the subnets of another network.
+	 * 
+	 * @param other The network to move from, left without addresses nor subnets.
+	 */
+	inline Network(Network&& other) noexcept;
+
+	/**
+	 * @brief Move assignment operator for the Network class, replacing the addresses and the subnets with those of another network.
+	 * 
+	 * @param other The network to move from, left without addresses nor subnets.
+	 * @return Network& A reference to this network.
+	 */
+	inline Network& operator =(Network&& other) noexcept;
+
 public:
 	/**
 	 * @brief Constructs a Network object with the specified IP address and prefix length.
 	 * 
 	 * @param ip The IP address of the network.
 	 * @param prefixLength The prefix length of the network, indicating the number of bits in the network portion of the address.
+	 * @param arena The arena from which the addresses of the network are allocated, or nullptr to allocate them on the heap.
+	 *              The network must then be destroyed in place before the arena.
 	 * @throws std::invalid_argument If the prefix length is not compatible with the address type.
 	 */
-	Network(const IPAddress& ip, int prefixLength);
+	Network(const IPAddress& ip, int prefixLength, Arena* arena = nullptr);
 
 	/**
 	 * @brief Destructor for the Network class.
 	 *
 	 * This destructor is responsible for cleaning up dynamically allocated memory
-	 * associated with the Network object. It deletes the _ip, _firstIp, and _lastIp
-	 * members, and iterates through the _subnets vector to delete each subnet.
+	 * associated with the Network object. It destroys the _ip, _firstIp, and _lastIp
+	 * members, then destroys the subnets and releases the arena they live in.
 	 */
 	inline virtual ~Network();
 
+	/**
+	 * @brief Networks own their addresses and their subnets, so they are moved, never copied.
+	 */
+	Network(const Network&) = delete;
+	Network& operator =(const Network&) = delete;
+
 	/**
 	 * @brief Segments the network into a specified number of subnets.
 	 * 
@@ -61,9 +154,11 @@ public:
 	 * divide the network into the given number of subnets.
 	 * 
 	 * @param numberOfSubnets The number of subnets to create from the network.
+	 * @param threadCount The number of threads building the subnets, 0 meaning one per hardware thread.
+	 *                    The subnets are the same, in the same order, whatever the number of threads.
 	 * @throws std::invalid_argument If the number of subnets is invalid or exceeds the network capacity.
 	 */
-	virtual void segment(uint32_t numberOfSubnets) = 0;
+	virtual void segment(uint64_t numberOfSubnets, unsigned threadCount = 1) = 0;
 
 	/**
 	 * @brief Retrieves the IP address.
@@ -155,6 +250,17 @@ public:
 	 */
 	inline const Network* operator [](size_t index) const;
 
+	/**
+	 * @brief Retrieves a subnet from the network by its index, without checking the index.
+	 * 
+	 * @param index The index of the subnet, which must be less than getSubnetCount().
+	 * @return const Network* A pointer to the subnet at the specified index.
+	 */
+	const Network* getSubnetUnchecked(size_t index) const
+	{
+		return _subnets[index];
+	}
+
 	/**
 	 * @brief Retrieves the number of subnets.
 	 * 
@@ -198,18 +304,163 @@ public:
  * @brief Destructor for the Network class.
  *
  * This destructor is responsible for cleaning up dynamically allocated memory
- * associated with the Network object. It deletes the _ip, _firstIp, and _lastIp
- * members, and iterates through the _subnets vector to delete each subnet.
+ * associated with the Network object. It destroys the _ip, _firstIp, and _lastIp
+ * members, then destroys the subnets and releases the arena they live in.
  */
 Network::~Network()
 {
-	delete _ip;
-	delete _firstIp;
-	delete _lastIp;
+	destroyAddress(_ip);
+	destroyAddress(_firstIp);
+	destroyAddress(_lastIp);
 
+	clearSubnets();
+}
+
+/**
+ * @brief Move constructor for the Network class, taking over the addresses and the subnets of another network.
+ *
+ * The addresses, the list of the subnets and their arena change hands without
+ * being copied, so the subnets keep their addresses. A network whose addresses
+ * live in an arena still needs the arena to outlive it once moved. The moved
+ * from network can only be destroyed or assigned to.
+ *
+ * @param other The network to move from, left without addresses nor subnets.
+ */
+Network::Network(Network&& other) noexcept
+	: _ip(other._ip), _firstIp(other._firstIp), _lastIp(other._lastIp), _mask(other._mask),
+	_subnets(move(other._subnets)), _subnetArena(move(other._subnetArena)), _arenaAllocated(other._arenaAllocated)
+{
+	other._ip = nullptr;
+	other._firstIp = nullptr;
+	other._lastIp = nullptr;
+	other._subnets.clear();
+}
+
+/**
+ * @brief Move assignment operator for the Network class, replacing the addresses and the subnets with those of another network.
+ *
+ * The addresses and the subnets of this network are destroyed first, with the
+ * allocation they were made with, then those of the other network change hands
+ * as with the move constructor.
+ *
+ * @param other The network to move from, left without addresses nor subnets.
+ * @return Network& A reference to this network.
+ */
+Network& Network::operator =(Network&& other) noexcept
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	// Destroy the addresses and the subnets of this network
+	destroyAddress(_ip);
+	destroyAddress(_firstIp);
+	destroyAddress(_lastIp);
+	clearSubnets();
+
+	// Take over the addresses and the subnets of the other network
+	_ip = other._ip;
+	_firstIp = other._firstIp;
+	_lastIp = other._lastIp;
+	_mask = other._mask;
+	_subnets = move(other._subnets);
+	_subnetArena = move(other._subnetArena);
+	_arenaAllocated = other._arenaAllocated;
+
+	other._ip = nullptr;
+	other._firstIp = nullptr;
+	other._lastIp = nullptr;
+	other._subnets.clear();
+
+	return *this;
+}
+
+/**
+ * @brief Destroys the subnets of the network and releases their arena.
+ *
+ * The subnets are destroyed in place, which releases nothing by itself, then
+ * all their memory is released at once with the arena.
+ */
+void Network::clearSubnets()
+{
 	for (Network* subnet : _subnets)
 	{
-		delete subnet;
+		if (subnet != nullptr)
+		{
+			subnet->~Network();
+		}
+	}
+
+	_subnets.clear();
+	_subnetArena.reset();
+}
+
+/**
+ * @brief Replaces the subnets of the network with the subnets of a range.
+ *
+ * Each thread creates the subnets of its partition, and their addresses, in an
+ * arena of its own sized for the whole partition, so that building the subnets
+ * takes one allocation per thread instead of several per subnet. The blocks of
+ * the arenas are then handed over to the arena of the network. If a subnet
+ * cannot be created, the subnets created so far are destroyed and the network
+ * is left without subnets.
+ *
+ * @tparam NetworkType The type of the subnets, IPv4Network or IPv6Network.
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param range The range of the new subnets.
+ * @param threadCount The number of threads building the subnets, 0 meaning one per hardware thread.
+ */
+template <typename NetworkType, typename Traits>
+void Network::createSubnets(const SubnetRange<Traits>& range, unsigned threadCount)
+{
+	// A subnet holds at most four addresses: the network, first, last and broadcast addresses
+	static const size_t footprint = sizeof(NetworkType) + 4 * sizeof(typename Traits::address_type);
+
+	// Destroy the existing subnets and allocate the list of the new ones
+	clearSubnets();
+	_subnets.resize(range.size(), nullptr);
+	_subnetArena.reset(new Arena());
+
+	mutex lock;
+
+	try
+	{
+		// Create the new subnets, each thread filling its own partition of the list
+		parallelFor(range.size(), threadCount, [this, &range, &lock](size_t begin, size_t end)
+		{
+			Arena partition((end - begin) * footprint);
+
+			// Hand the blocks of the partition over to the network, even if a subnet fails
+			auto handOver = [this, &lock, &partition]()
+			{
+				lock_guard<mutex> guard(lock);
+				_subnetArena->adopt(partition);
+			};
+
+			try
+			{
+				typename SubnetRange<Traits>::iterator it = range.begin() + (int64_t)begin;
+
+				for (size_t i = begin; i < end; ++i, ++it)
+				{
+					_subnets[i] = partition.create<NetworkType>((*it).getIp(), range.getPrefixLength(), &partition);
+				}
+			}
+			catch (...)
+			{
+				handOver();
+				throw;
+			}
+
+			handOver();
+		});
+	}
+	catch (...)
+	{
+		// Destroy the subnets created before the error
+		clearSubnets();
+		throw;
 	}
 }
 
@@ -225,11 +476,11 @@ const Network* Network::operator [](size_t index) const
 	// Check if the index is out of range
 	if (index >= _subnets.size())
 	{
-		throw out_of_range("Index out of range, must be between 0 and " + to_string(_subnets.size() - 1) + ".");
+		throwIndexOutOfRange(_subnets.size());
 	}
 
 	// Return the subnet at the specified index
-	return _subnets[index];
+	return getSubnetUnchecked(index);
 }
 
 #endif // NETWORK_H
\ No newline at end of file
@@ -0,0 +1,310 @@
+#ifndef NETWORK_TRAITS_H
+#define NETWORK_TRAITS_H
+
+#include "address/ipv4_address.h"
+#include "address/ipv6_address.h"
+
+/**
+ * @struct IPv4Traits
+ * @brief Describes the IPv4 address family for the value-based network types.
+ *
+ * An IPv4 address is handled as a 32-bit unsigned integer. The first host of a
+ * network follows its network address and the last host precedes its broadcast address.
+ */
+struct IPv4Traits
+{
+	/**
+	 * @brief The integer type holding an IPv4 address.
+	 */
+	typedef uint32_t value_type;
+
+	/**
+	 * @brief The address class of the family.
+	 */
+	typedef IPv4Address address_type;
+
+	/**
+	 * @brief The number of bits in an IPv4 address.
+	 */
+	static constexpr int ADDRESS_BITS = IPV4_NUM_OCTETS * 8;
+
+	/**
+	 * @brief Computes the host mask of a prefix length.
+	 *
+	 * @param prefixLength The prefix length, between 0 and 32.
+	 * @return value_type A value with the host bits of the prefix length set.
+	 */
+	static value_type hostMask(int prefixLength)
+	{
+		return (prefixLength >= ADDRESS_BITS) ? 0 : (0xFFFFFFFFu >> prefixLength);
+	}
+
+	/**
+	 * @brief Computes the offset of a subnet from the base address of its parent.
+	 *
+	 * @param index The index of the subnet.
+	 * @param prefixLength The prefix length of the subnet.
+	 * @return value_type The offset of the subnet at the given index.
+	 */
+	static value_type subnetOffset(uint64_t index, int prefixLength)
+	{
+		return (value_type)(index << (ADDRESS_BITS - prefixLength));
+	}
+
+	/**
+	 * @brief Computes the first host address of a network.
+	 *
+	 * @param network The network address.
+	 * @param prefixLength The prefix length of the network.
+	 * @return value_type The address following the network address.
+	 */
+	static value_type firstHost(value_type network, int prefixLength)
+	{
+		(void)prefixLength;
+		return network + 1;
+	}
+
+	/**
+	 * @brief Computes the last host address of a network.
+	 *
+	 * @param network The network address.
+	 * @param prefixLength The prefix length of the network.
+	 * @return value_type The address preceding the broadcast address.
+	 */
+	static value_type lastHost(value_type network, int prefixLength)
+	{
+		return (network | hostMask(prefixLength)) - 1;
+	}
+
+	/**
+	 * @brief Converts an address value to an address object.
+	 *
+	 * @param value The value of the address.
+	 * @return address_type The address object.
+	 */
+	static address_type toAddress(value_type value)
+	{
+		return IPv4Address(value);
+	}
+
+	/**
+	 * @brief Converts an address object to its value.
+	 *
+	 * @param ip The address object.
+	 * @return value_type The lowest 32 bits of the value of the address.
+	 */
+	static value_type toValue(const IPAddress& ip)
+	{
+		return (value_type)ip.toUInt128().getLow();
+	}
+
+	/**
+	 * @brief The maximum length of the text of an IPv4 address.
+	 */
+	static constexpr size_t MAX_LENGTH = IPV4_MAX_LENGTH;
+
+	/**
+	 * @brief Whether the networks of the family have a broadcast address.
+	 */
+	static constexpr bool HAS_BROADCAST = true;
+
+	/**
+	 * @brief The number of addresses of a network that are not hosts: the network and broadcast addresses.
+	 */
+	static constexpr int RESERVED_ADDRESSES = 2;
+
+	/**
+	 * @brief Writes the dotted-decimal text of an address value.
+	 *
+	 * @param value The value of the address.
+	 * @param buffer The buffer receiving the text, at least MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	static size_t format(value_type value, char* buffer)
+	{
+		return formatIPv4(value, buffer);
+	}
+
+	/**
+	 * @brief Writes the bytes of an address value in network byte order.
+	 *
+	 * @param value The value of the address.
+	 * @param bytes The buffer receiving the ADDRESS_BITS / 8 bytes of the address.
+	 */
+	static void toBytes(value_type value, unsigned char* bytes)
+	{
+		for (int i = 0; i < ADDRESS_BITS / 8; ++i)
+		{
+			bytes[i] = (unsigned char)(value >> (ADDRESS_BITS - 8 - i * 8));
+		}
+	}
+
+	/**
+	 * @brief Retrieves consecutive bits of an address value.
+	 *
+	 * @param value The value of the address.
+	 * @param index The index of the first bit, 0 being the most significant bit.
+	 * @param count The number of bits, between 1 and 31.
+	 * @return unsigned The bits, the last one being the least significant bit.
+	 */
+	static unsigned bitsAt(value_type value, int index, int count)
+	{
+		return (value >> (ADDRESS_BITS - index - count)) & ((1u << count) - 1);
+	}
+};
+
+/**
+ * @struct IPv6Traits
+ * @brief Describes the IPv6 address family for the value-based network types.
+ *
+ * An IPv6 address is handled as a 128-bit unsigned integer. The first host of a
+ * network follows its network address and the last host is the highest address
+ * of the network.
+ */
+struct IPv6Traits
+{
+	/**
+	 * @brief The integer type holding an IPv6 address.
+	 */
+	typedef UInt128 value_type;
+
+	/**
+	 * @brief The address class of the family.
+	 */
+	typedef IPv6Address address_type;
+
+	/**
+	 * @brief The number of bits in an IPv6 address.
+	 */
+	static constexpr int ADDRESS_BITS = IPV6_NUM_OCTETS * 8;
+
+	/**
+	 * @brief Computes the host mask of a prefix length.
+	 *
+	 * @param prefixLength The prefix length, between 0 and 128.
+	 * @return value_type A value with the host bits of the prefix length set.
+	 */
+	static value_type hostMask(int prefixLength)
+	{
+		return UInt128::lowBits(ADDRESS_BITS - prefixLength);
+	}
+
+	/**
+	 * @brief Computes the offset of a subnet from the base address of its parent.
+	 *
+	 * @param index The index of the subnet.
+	 * @param prefixLength The prefix length of the subnet.
+	 * @return value_type The offset of the subnet at the given index.
+	 */
+	static value_type subnetOffset(uint64_t index, int prefixLength)
+	{
+		return UInt128(index) << (ADDRESS_BITS - prefixLength);
+	}
+
+	/**
+	 * @brief Computes the first host address of a network.
+	 *
+	 * @param network The network address.
+	 * @param prefixLength The prefix length of the network.
+	 * @return value_type The address following the network address.
+	 */
+	static value_type firstHost(const value_type& network, int prefixLength)
+	{
+		(void)prefixLength;
+		return network + 1;
+	}
+
+	/**
+	 * @brief Computes the last host address of a network.
+	 *
+	 * @param network The network address.
+	 * @param prefixLength The prefix length of the network.
+	 * @return value_type The highest address of the network.
+	 */
+	static value_type lastHost(const value_type& network, int prefixLength)
+	{
+		return network | hostMask(prefixLength);
+	}
+
+	/**
+	 * @brief Converts an address value to an address object.
+	 *
+	 * @param value The value of the address.
+	 * @return address_type The address object.
+	 */
+	static address_type toAddress(const value_type& value)
+	{
+		return IPv6Address(value);
+	}
+
+	/**
+	 * @brief Converts an address object to its value.
+	 *
+	 * @param ip The address object.
+	 * @return value_type The value of the address.
+	 */
+	static value_type toValue(const IPAddress& ip)
+	{
+		return ip.toUInt128();
+	}
+
+	/**
+	 * @brief The maximum length of the text of an IPv6 address.
+	 */
+	static constexpr size_t MAX_LENGTH = IPV6_MAX_LENGTH;
+
+	/**
+	 * @brief Whether the networks of the family have a broadcast address.
+	 */
+	static constexpr bool HAS_BROADCAST = false;
+
+	/**
+	 * @brief The number of addresses of a network that are not hosts: the network address.
+	 */
+	static constexpr int RESERVED_ADDRESSES = 1;
+
+	/**
+	 * @brief Writes the colon-hexadecimal text of an address value.
+	 *
+	 * @param value The value of the address.
+	 * @param buffer The buffer receiving the text, at least MAX_LENGTH characters long.
+	 * @return size_t The number of characters written.
+	 */
+	static size_t format(const value_type& value, char* buffer)
+	{
+		return formatIPv6(value, buffer);
+	}
+
+	/**
+	 * @brief Writes the bytes of an address value in network byte order.
+	 *
+	 * @param value The value of the address.
+	 * @param bytes The buffer receiving the ADDRESS_BITS / 8 bytes of the address.
+	 */
+	static void toBytes(const value_type& value, unsigned char* bytes)
+	{
+		for (int i = 0; i < ADDRESS_BITS / 8; ++i)
+		{
+			uint64_t word = (i < 8) ? value.getHigh() : value.getLow();
+			bytes[i] = (unsigned char)(word >> (56 - (i % 8) * 8));
+		}
+	}
+
+	/**
+	 * @brief Retrieves consecutive bits of an address value.
+	 *
+	 * The bits must not straddle the two 64-bit halves of the value.
+	 *
+	 * @param value The value of the address.
+	 * @param index The index of the first bit, 0 being the most significant bit.
+	 * @param count The number of bits, between 1 and 31.
+	 * @return unsigned The bits, the last one being the least significant bit.
+	 */
+	static unsigned bitsAt(const value_type& value, int index, int count)
+	{
+		uint64_t word = (index < 64) ? value.getHigh() : value.getLow();
+		return (unsigned)(word >> (64 - index % 64 - count)) & ((1u << count) - 1);
+	}
+};
+
+#endif // NETWORK_TRAITS_H
\ No newline at end of file
@@ -0,0 +1,187 @@
+#ifndef PREFIX_AGGREGATOR_H
+#define PREFIX_AGGREGATOR_H
+
+#include "network/network.h"
+#include "network/subnet.h"
+#include <algorithm>
+#include <vector>
+
+#define PREFIX_AGGREGATOR_CHUNK_SIZE (1u << 20) ///< The default number of prefixes buffered before they are aggregated.
+
+/**
+ * @class PrefixAggregator
+ * @brief Collapses a list of prefixes into the smallest set of prefixes covering the same addresses.
+ *
+ * The aggregation removes the prefixes contained in other prefixes and replaces
+ * every pair of sibling prefixes, the two halves of a same parent, with their
+ * parent, repeatedly. It is the inverse of a segmentation.
+ *
+ * The prefixes are added one at a time and buffered in chunks. Once a chunk is
+ * full, it is sorted, merged into the sorted result of the previous chunks and
+ * aggregated with it in a single pass. The memory used is therefore bounded by
+ * the size of the result plus the size of a chunk, whatever the number of
+ * prefixes added, and the whole aggregation takes O(n log n) time.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class PrefixAggregator
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+private:
+	/**
+	 * @brief The aggregated prefixes, sorted, followed by the pending prefixes.
+	 */
+	vector<Subnet<Traits>> _prefixes;
+
+	/**
+	 * @brief The number of aggregated prefixes at the beginning of the list.
+	 */
+	size_t _aggregated;
+
+	/**
+	 * @brief The number of pending prefixes that triggers an aggregation.
+	 */
+	size_t _chunkSize;
+
+	/**
+	 * @brief Orders prefixes by network address, then from the shortest to the longest.
+	 *
+	 * @param a The first prefix.
+	 * @param b The second prefix.
+	 * @return bool True if the first prefix comes before the second one, false otherwise.
+	 */
+	static bool before(const Subnet<Traits>& a, const Subnet<Traits>& b)
+	{
+		return (a.getValue() != b.getValue()) ? a.getValue() < b.getValue() : a.getPrefixLength() < b.getPrefixLength();
+	}
+
+	/**
+	 * @brief Aggregates the pending prefixes with the aggregated ones.
+	 */
+	inline void flush();
+
+public:
+	/**
+	 * @brief Constructs an empty aggregator.
+	 *
+	 * @param chunkSize The number of prefixes buffered before they are aggregated.
+	 */
+	explicit PrefixAggregator(size_t chunkSize = PREFIX_AGGREGATOR_CHUNK_SIZE)
+		: _aggregated(0), _chunkSize(max(chunkSize, (size_t)1)) {}
+
+	/**
+	 * @brief Adds a prefix to the aggregation.
+	 *
+	 * @param prefix The prefix to add.
+	 */
+	void add(const Subnet<Traits>& prefix)
+	{
+		_prefixes.push_back(prefix);
+
+		// Aggregate the chunk once it is full
+		if (_prefixes.size() - _aggregated >= _chunkSize)
+		{
+			flush();
+		}
+	}
+
+	/**
+	 * @brief Adds a network to the aggregation.
+	 *
+	 * @param network The network to add, of the family of the aggregator.
+	 */
+	void add(const Network& network)
+	{
+		add(Subnet<Traits>(Traits::toValue(*network.getIp()), network.getPrefixLength()));
+	}
+
+	/**
+	 * @brief Aggregates the prefixes added so far.
+	 *
+	 * @return const vector<Subnet<Traits>>& The aggregated prefixes, sorted by network address.
+	 */
+	const vector<Subnet<Traits>>& result()
+	{
+		flush();
+		return _prefixes;
+	}
+};
+
+/**
+ * @brief Aggregates the pending prefixes with the aggregated ones.
+ *
+ * This function sorts the pending prefixes, merges them with the sorted
+ * aggregated ones, then sweeps the list once with a stack of output prefixes.
+ * In the sorted order, a prefix can only be contained in the prefix on top of
+ * the stack, and can only be the sibling of that prefix, so each prefix is
+ * either skipped, or pushed then merged with the top of the stack as long as
+ * they are siblings.
+ */
+template <typename Traits>
+void PrefixAggregator<Traits>::flush()
+{
+	// Skip the aggregation if there is no pending prefix
+	if (_aggregated == _prefixes.size())
+	{
+		return;
+	}
+
+	// Sort the pending prefixes and merge them with the aggregated ones
+	sort(_prefixes.begin() + (ptrdiff_t)_aggregated, _prefixes.end(), before);
+	inplace_merge(_prefixes.begin(), _prefixes.begin() + (ptrdiff_t)_aggregated, _prefixes.end(), before);
+
+	// Sweep the prefixes, using the beginning of the list as the stack
+	size_t top = 0;
+
+	for (size_t i = 0; i < _prefixes.size(); ++i)
+	{
+		Subnet<Traits> prefix = _prefixes[i];
+
+		// Skip the prefix if it is contained in the top of the stack
+		if (top > 0 && _prefixes[top - 1].getPrefixLength() <= prefix.getPrefixLength() && _prefixes[top - 1].contains(prefix.getValue()))
+		{
+			continue;
+		}
+
+		// Merge the prefix with the top of the stack while they are siblings
+		while (top > 0 && prefix.getPrefixLength() > 0 && _prefixes[top - 1].getPrefixLength() == prefix.getPrefixLength()
+			&& (_prefixes[top - 1].getValue() ^ prefix.getValue()) == Traits::subnetOffset(1, prefix.getPrefixLength()))
+		{
+			prefix = Subnet<Traits>(_prefixes[top - 1].getValue(), prefix.getPrefixLength() - 1);
+			--top;
+		}
+
+		_prefixes[top++] = prefix;
+	}
+
+	_prefixes.erase(_prefixes.begin() + (ptrdiff_t)top, _prefixes.end());
+	_aggregated = top;
+}
+
+/**
+ * @brief Aggregates a list of prefixes.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param prefixes The prefixes to aggregate.
+ * @return vector<Subnet<Traits>> The smallest set of prefixes covering the same addresses, sorted by network address.
+ */
+template <typename Traits>
+vector<Subnet<Traits>> aggregate(const vector<Subnet<Traits>>& prefixes)
+{
+	PrefixAggregator<Traits> aggregator(prefixes.size());
+
+	for (const Subnet<Traits>& prefix : prefixes)
+	{
+		aggregator.add(prefix);
+	}
+
+	return aggregator.result();
+}
+
+#endif // PREFIX_AGGREGATOR_H
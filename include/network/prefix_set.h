@@ -0,0 +1,574 @@
+#ifndef PREFIX_SET_H
+#define PREFIX_SET_H
+
+#include "network/basic_network.h"
+#include "network/network.h"
+#include "network/subnet.h"
+#include <algorithm>
+#include <vector>
+
+/**
+ * @class PrefixSet
+ * @brief Set of addresses of a family, held as sorted disjoint intervals.
+ *
+ * A set is built from any collection of prefixes, overlapping or not. The
+ * intervals of the prefixes are sorted, unless they already are, then merged
+ * in one pass, so that the set holds the smallest number of intervals covering
+ * the same addresses. The union, intersection and difference of two sets are
+ * then computed with a single linear merge of their intervals, and a set is
+ * turned back into the smallest list of prefixes covering it.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class PrefixSet
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @struct Interval
+	 * @brief Range of consecutive addresses, both bounds included.
+	 */
+	struct Interval
+	{
+		/**
+		 * @brief The first address of the interval.
+		 */
+		value_type first;
+
+		/**
+		 * @brief The last address of the interval.
+		 */
+		value_type last;
+	};
+
+private:
+	/**
+	 * @brief The intervals of the set, sorted, disjoint and not adjacent.
+	 */
+	vector<Interval> _intervals;
+
+	/**
+	 * @brief Checks if an interval starting at an address joins an interval, which it overlaps or touches.
+	 *
+	 * @param interval The interval, starting before or at the address.
+	 * @param first The first address of the other interval.
+	 * @return bool True if the intervals overlap or touch, false otherwise.
+	 */
+	static bool joins(const Interval& interval, const value_type& first)
+	{
+		// The last address of the family cannot be followed by another one
+		return interval.last == Traits::hostMask(0) || first <= interval.last + 1;
+	}
+
+	/**
+	 * @brief Appends an interval to the sorted intervals, merging it with the last one if they overlap or touch.
+	 *
+	 * @param intervals The intervals, sorted by first address.
+	 * @param first The first address of the interval, not lower than the first address of the last interval.
+	 * @param last The last address of the interval.
+	 */
+	static void append(vector<Interval>& intervals, const value_type& first, const value_type& last)
+	{
+		if (!intervals.empty() && joins(intervals.back(), first))
+		{
+			intervals.back().last = max(intervals.back().last, last);
+			return;
+		}
+
+		intervals.push_back({ first, last });
+	}
+
+	/**
+	 * @brief Sorts the intervals if they are not sorted, then merges those overlapping or touching.
+	 */
+	inline void normalize();
+
+public:
+	/**
+	 * @brief Constructs an empty set.
+	 */
+	PrefixSet() = default;
+
+	/**
+	 * @brief Constructs the set of the addresses of a prefix.
+	 *
+	 * @param prefix The prefix.
+	 */
+	explicit PrefixSet(const Subnet<Traits>& prefix)
+		: _intervals{ { prefix.getValue(), prefix.getValue() | Traits::hostMask(prefix.getPrefixLength()) } } {}
+
+	/**
+	 * @brief Constructs the set of the addresses of a collection of prefixes.
+	 *
+	 * @tparam Iterator The type of the iterators of the prefixes, whose values are Subnet<Traits>.
+	 * @param begin The first prefix.
+	 * @param end The end of the prefixes.
+	 */
+	template <typename Iterator>
+	PrefixSet(Iterator begin, Iterator end)
+	{
+		for (Iterator it = begin; it != end; ++it)
+		{
+			Subnet<Traits> prefix = *it;
+			_intervals.push_back({ prefix.getValue(), prefix.getValue() | Traits::hostMask(prefix.getPrefixLength()) });
+		}
+
+		normalize();
+	}
+
+	/**
+	 * @brief Constructs the set of the addresses of a list of prefixes.
+	 *
+	 * @param prefixes The prefixes, in any order.
+	 */
+	explicit PrefixSet(const vector<Subnet<Traits>>& prefixes)
+		: PrefixSet(prefixes.begin(), prefixes.end()) {}
+
+	/**
+	 * @brief Constructs the set of the addresses of the subnets of a network.
+	 *
+	 * @param network The network, of the family of the set.
+	 * @return PrefixSet The set of the addresses of its subnets, empty if it is not segmented.
+	 */
+	inline static PrefixSet fromSubnets(const Network& network);
+
+	/**
+	 * @brief Retrieves the intervals of the set.
+	 *
+	 * @return const vector<Interval>& The intervals, sorted, disjoint and not adjacent.
+	 */
+	const vector<Interval>& getIntervals() const
+	{
+		return _intervals;
+	}
+
+	/**
+	 * @brief Checks if the set is empty.
+	 *
+	 * @return bool True if the set holds no address, false otherwise.
+	 */
+	bool empty() const
+	{
+		return _intervals.empty();
+	}
+
+	/**
+	 * @brief Checks if the set holds an address.
+	 *
+	 * @param ip The value of the address.
+	 * @return bool True if the address is in the set, false otherwise.
+	 */
+	bool contains(const value_type& ip) const
+	{
+		// Find the last interval starting at or before the address
+		auto it = upper_bound(_intervals.begin(), _intervals.end(), ip, [](const value_type& value, const Interval& interval)
+		{
+			return value < interval.first;
+		});
+
+		return it != _intervals.begin() && ip <= (it - 1)->last;
+	}
+
+	/**
+	 * @brief Computes the union of two sets.
+	 *
+	 * @param other The other set.
+	 * @return PrefixSet The addresses in either set.
+	 */
+	inline PrefixSet unite(const PrefixSet& other) const;
+
+	/**
+	 * @brief Computes the intersection of two sets.
+	 *
+	 * @param other The other set.
+	 * @return PrefixSet The addresses in both sets.
+	 */
+	inline PrefixSet intersect(const PrefixSet& other) const;
+
+	/**
+	 * @brief Computes the difference of two sets.
+	 *
+	 * @param other The set of the addresses to remove.
+	 * @return PrefixSet The addresses of this set that are not in the other set.
+	 */
+	inline PrefixSet subtract(const PrefixSet& other) const;
+
+	/**
+	 * @brief Checks if two sets have an address in common, without computing their intersection.
+	 *
+	 * @param other The other set.
+	 * @return bool True if the sets overlap, false otherwise.
+	 */
+	inline bool overlaps(const PrefixSet& other) const;
+
+	/**
+	 * @brief Converts the set into prefixes.
+	 *
+	 * @return vector<Subnet<Traits>> The smallest list of prefixes covering the set, sorted by network address.
+	 */
+	inline vector<Subnet<Traits>> toPrefixes() const;
+
+	/**
+	 * @brief Appends the smallest list of prefixes covering an interval.
+	 *
+	 * @param first The first address of the interval.
+	 * @param last The last address of the interval, not lower than the first one.
+	 * @param prefixes The list to which the prefixes are appended, in order.
+	 */
+	inline static void appendPrefixes(value_type first, const value_type& last, vector<Subnet<Traits>>& prefixes);
+};
+
+/**
+ * @brief Sorts the intervals if they are not sorted, then merges those overlapping or touching.
+ *
+ * Inventories and segmentations are usually sorted already, so the sort is
+ * skipped after a linear check, and only the merge pass is paid.
+ */
+template <typename Traits>
+void PrefixSet<Traits>::normalize()
+{
+	auto before = [](const Interval& a, const Interval& b)
+	{
+		return a.first < b.first;
+	};
+
+	// Sort the intervals only if needed
+	if (!is_sorted(_intervals.begin(), _intervals.end(), before))
+	{
+		sort(_intervals.begin(), _intervals.end(), before);
+	}
+
+	// Merge the intervals in place, the beginning of the list holding the merged ones
+	size_t top = 0;
+
+	for (size_t i = 0; i < _intervals.size(); ++i)
+	{
+		if (top > 0 && joins(_intervals[top - 1], _intervals[i].first))
+		{
+			_intervals[top - 1].last = max(_intervals[top - 1].last, _intervals[i].last);
+		}
+		else
+		{
+			_intervals[top++] = _intervals[i];
+		}
+	}
+
+	_intervals.resize(top);
+	_intervals.shrink_to_fit();
+}
+
+/**
+ * @brief Constructs the set of the addresses of the subnets of a network.
+ *
+ * The subnets of a segmentation are sorted and consecutive, so they are read in
+ * a single pass and collapse into a single interval.
+ *
+ * @param network The network, of the family of the set.
+ * @return PrefixSet The set of the addresses of its subnets, empty if it is not segmented.
+ */
+template <typename Traits>
+PrefixSet<Traits> PrefixSet<Traits>::fromSubnets(const Network& network)
+{
+	PrefixSet set;
+	set._intervals.reserve(network.getSubnetCount());
+
+	for (size_t i = 0; i < network.getSubnetCount(); ++i)
+	{
+		const Network* subnet = network.getSubnetUnchecked(i);
+		value_type value = Traits::toValue(*subnet->getIp());
+
+		set._intervals.push_back({ value, value | Traits::hostMask(subnet->getPrefixLength()) });
+	}
+
+	set.normalize();
+
+	return set;
+}
+
+/**
+ * @brief Computes the union of two sets.
+ *
+ * The intervals of both sets are merged by first address and appended in order,
+ * which joins the intervals that overlap or touch.
+ *
+ * @param other The other set.
+ * @return PrefixSet The addresses in either set.
+ */
+template <typename Traits>
+PrefixSet<Traits> PrefixSet<Traits>::unite(const PrefixSet& other) const
+{
+	PrefixSet result;
+	result._intervals.reserve(_intervals.size() + other._intervals.size());
+
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < _intervals.size() || j < other._intervals.size())
+	{
+		// Take the interval starting first
+		bool mine = j == other._intervals.size() || (i < _intervals.size() && _intervals[i].first <= other._intervals[j].first);
+		const Interval& interval = mine ? _intervals[i++] : other._intervals[j++];
+
+		append(result._intervals, interval.first, interval.last);
+	}
+
+	return result;
+}
+
+/**
+ * @brief Computes the intersection of two sets.
+ *
+ * Both lists are walked together, and the overlap of the current intervals is
+ * kept before the interval ending first is passed.
+ *
+ * @param other The other set.
+ * @return PrefixSet The addresses in both sets.
+ */
+template <typename Traits>
+PrefixSet<Traits> PrefixSet<Traits>::intersect(const PrefixSet& other) const
+{
+	PrefixSet result;
+
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < _intervals.size() && j < other._intervals.size())
+	{
+		const Interval& a = _intervals[i];
+		const Interval& b = other._intervals[j];
+
+		// Keep the overlap of the intervals if any
+		value_type first = max(a.first, b.first);
+		value_type last = min(a.last, b.last);
+
+		if (first <= last)
+		{
+			result._intervals.push_back({ first, last });
+		}
+
+		// Pass the interval ending first
+		if (a.last < b.last)
+		{
+			++i;
+		}
+		else
+		{
+			++j;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @brief Computes the difference of two sets.
+ *
+ * For each interval of this set, the intervals of the other set overlapping it
+ * are walked in order, and the gaps between them are kept. An interval of the
+ * other set can overlap several intervals of this set, so the walk resumes from
+ * the last one it reached.
+ *
+ * @param other The set of the addresses to remove.
+ * @return PrefixSet The addresses of this set that are not in the other set.
+ */
+template <typename Traits>
+PrefixSet<Traits> PrefixSet<Traits>::subtract(const PrefixSet& other) const
+{
+	PrefixSet result;
+
+	size_t j = 0;
+
+	for (const Interval& interval : _intervals)
+	{
+		value_type first = interval.first;
+		bool covered = false;
+
+		// Skip the intervals of the other set ending before the interval
+		while (j < other._intervals.size() && other._intervals[j].last < first)
+		{
+			++j;
+		}
+
+		// Keep the gaps between the intervals of the other set overlapping the interval
+		for (; j < other._intervals.size() && other._intervals[j].first <= interval.last; ++j)
+		{
+			const Interval& removed = other._intervals[j];
+
+			if (first < removed.first)
+			{
+				result._intervals.push_back({ first, removed.first - 1 });
+			}
+
+			// Stop if the rest of the interval is removed, the removed interval may overlap the next one
+			if (removed.last >= interval.last)
+			{
+				covered = true;
+				break;
+			}
+
+			first = removed.last + 1;
+		}
+
+		if (!covered)
+		{
+			result._intervals.push_back({ first, interval.last });
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @brief Checks if two sets have an address in common, without computing their intersection.
+ *
+ * @param other The other set.
+ * @return bool True if the sets overlap, false otherwise.
+ */
+template <typename Traits>
+bool PrefixSet<Traits>::overlaps(const PrefixSet& other) const
+{
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < _intervals.size() && j < other._intervals.size())
+	{
+		const Interval& a = _intervals[i];
+		const Interval& b = other._intervals[j];
+
+		if (a.first <= b.last && b.first <= a.last)
+		{
+			return true;
+		}
+
+		// Pass the interval ending first
+		if (a.last < b.last)
+		{
+			++i;
+		}
+		else
+		{
+			++j;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Converts the set into prefixes.
+ *
+ * @return vector<Subnet<Traits>> The smallest list of prefixes covering the set, sorted by network address.
+ */
+template <typename Traits>
+vector<Subnet<Traits>> PrefixSet<Traits>::toPrefixes() const
+{
+	vector<Subnet<Traits>> prefixes;
+
+	for (const Interval& interval : _intervals)
+	{
+		appendPrefixes(interval.first, interval.last, prefixes);
+	}
+
+	return prefixes;
+}
+
+/**
+ * @brief Appends the smallest list of prefixes covering an interval.
+ *
+ * The interval is covered from its first address with the largest prefix that
+ * starts there and does not go past its last address, repeatedly. An interval
+ * is covered by at most two prefixes per prefix length.
+ *
+ * @param first The first address of the interval.
+ * @param last The last address of the interval, not lower than the first one.
+ * @param prefixes The list to which the prefixes are appended, in order.
+ */
+template <typename Traits>
+void PrefixSet<Traits>::appendPrefixes(value_type first, const value_type& last, vector<Subnet<Traits>>& prefixes)
+{
+	while (true)
+	{
+		int prefixLength = Traits::ADDRESS_BITS;
+
+		// Grow the prefix while it stays aligned on the first address and within the interval
+		while (prefixLength > 0 && (first & Traits::hostMask(prefixLength - 1)) == 0 && (first | Traits::hostMask(prefixLength - 1)) <= last)
+		{
+			--prefixLength;
+		}
+
+		prefixes.push_back(Subnet<Traits>(first, prefixLength));
+
+		// Stop at the end of the interval, before it can wrap around the address space
+		value_type end = first | Traits::hostMask(prefixLength);
+
+		if (end == last)
+		{
+			break;
+		}
+
+		first = end + 1;
+	}
+}
+
+/**
+ * @brief Lists the free blocks of a segmented network, the addresses not in any of its subnets.
+ *
+ * The subnets are read in a single pass, whatever their number.
+ *
+ * @tparam Traits The address family traits of the network, IPv4Traits or IPv6Traits.
+ * @param network The network.
+ * @return vector<Subnet<Traits>> The smallest list of prefixes covering the free addresses, sorted by network address.
+ */
+template <typename Traits>
+vector<Subnet<Traits>> freeBlocks(const Network& network)
+{
+	PrefixSet<Traits> parent(Subnet<Traits>(Traits::toValue(*network.getIp()), network.getPrefixLength()));
+
+	return parent.subtract(PrefixSet<Traits>::fromSubnets(network)).toPrefixes();
+}
+
+/**
+ * @brief Lists the free blocks of a segmented network, the addresses not in any of its subnets.
+ *
+ * The subnets of a segmentation are consecutive from the network address, so
+ * the free addresses are the single interval following the last subnet, found
+ * without enumerating the subnets.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param network The network.
+ * @return vector<Subnet<Traits>> The smallest list of prefixes covering the free addresses, sorted by network address.
+ */
+template <typename Traits>
+vector<Subnet<Traits>> freeBlocks(const BasicNetwork<Traits>& network)
+{
+	const Subnet<Traits>& parent = network.getNetwork();
+	const SubnetRange<Traits>& subnets = network.getSubnets();
+
+	vector<Subnet<Traits>> prefixes;
+	typename Traits::value_type last = parent.getValue() | Traits::hostMask(parent.getPrefixLength());
+
+	// The whole network is free if it is not segmented
+	if (subnets.empty())
+	{
+		prefixes.push_back(parent);
+		return prefixes;
+	}
+
+	Subnet<Traits> lastSubnet = subnets[subnets.size() - 1];
+	typename Traits::value_type end = lastSubnet.getValue() | Traits::hostMask(lastSubnet.getPrefixLength());
+
+	// Cover the addresses after the last subnet
+	if (end != last)
+	{
+		PrefixSet<Traits>::appendPrefixes(end + 1, last, prefixes);
+	}
+
+	return prefixes;
+}
+
+#endif // PREFIX_SET_H
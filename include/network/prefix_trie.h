@@ -0,0 +1,435 @@
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include "network/network.h"
+#include "network/subnet_table.h"
+#include "utils/parallel.h"
+
+#define PREFIX_TRIE_STRIDE 4 ///< The number of address bits consumed by each level of a prefix trie.
+#define PREFIX_TRIE_NONE 0xFFFFFFFFu ///< The index meaning that an entry of a prefix trie has no child or no subnet.
+
+/**
+ * @struct PrefixTrieEntry
+ * @brief Entry of a node of a prefix trie, for one value of the bits consumed by the node.
+ *
+ * The entry is a plain structure of fixed size, so the nodes of a trie can be
+ * stored in a file and walked from its mapping as they are.
+ */
+struct PrefixTrieEntry
+{
+	/**
+	 * @brief The index of the node of the next level, or PREFIX_TRIE_NONE if there is none.
+	 */
+	uint32_t child;
+
+	/**
+	 * @brief The index of the longest subnet ending in this node and covering the entry, or PREFIX_TRIE_NONE.
+	 */
+	uint32_t subnet;
+};
+
+/**
+ * @class PrefixTrie
+ * @brief Longest-prefix-match index over a set of subnets.
+ *
+ * The subnets are stored in a multibit trie: each node consumes PREFIX_TRIE_STRIDE
+ * bits of the address and holds one entry per value of these bits. A subnet is
+ * stored in the node of the level its prefix ends in, and expanded to all the
+ * entries its prefix covers there, each entry keeping the longest subnet stored in
+ * it. A lookup therefore reads one entry per level, that is at most 8 entries for
+ * an IPv4 address and 32 for an IPv6 address, whatever the number of subnets.
+ *
+ * The nodes live in a single contiguous array of plain structures and refer to each
+ * other by index, so the trie is built with few allocations and walked without
+ * chasing heap pointers. Lookups do not modify the trie, so any number of threads
+ * may look up addresses concurrently as long as no subnet is inserted at the same time.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class PrefixTrie
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @brief The number of entries of a node.
+	 */
+	static constexpr unsigned ENTRIES = 1u << PREFIX_TRIE_STRIDE;
+
+private:
+	/**
+	 * @brief The index meaning that an entry has no child or no subnet.
+	 */
+	static constexpr uint32_t NONE = PREFIX_TRIE_NONE;
+
+	/**
+	 * @brief Entry of a node.
+	 */
+	typedef PrefixTrieEntry Entry;
+
+	/**
+	 * @struct Node
+	 * @brief Node of the trie.
+	 */
+	struct Node
+	{
+		/**
+		 * @brief The entries of the node, indexed by the bits they stand for.
+		 */
+		Entry entries[ENTRIES];
+	};
+
+	/**
+	 * @brief The nodes of the trie, the first one being the root.
+	 */
+	vector<Node> _nodes;
+
+	/**
+	 * @brief The subnets of the trie, in insertion order.
+	 */
+	vector<Subnet<Traits>> _subnets;
+
+	/**
+	 * @brief The index of the subnet with an empty prefix, or NONE.
+	 */
+	uint32_t _defaultSubnet;
+
+	/**
+	 * @brief Appends an empty node to the trie.
+	 *
+	 * @return uint32_t The index of the node.
+	 */
+	uint32_t addNode()
+	{
+		Node node;
+
+		for (Entry& entry : node.entries)
+		{
+			entry = Entry{ NONE, NONE };
+		}
+
+		_nodes.push_back(node);
+
+		return (uint32_t)(_nodes.size() - 1);
+	}
+
+	/**
+	 * @brief Appends a subnet to the list of subnets.
+	 *
+	 * @param subnet The subnet to append.
+	 * @return uint32_t The index of the subnet.
+	 */
+	uint32_t addSubnet(const Subnet<Traits>& subnet)
+	{
+		_subnets.push_back(subnet);
+		return (uint32_t)(_subnets.size() - 1);
+	}
+
+public:
+	/**
+	 * @brief Constructs an empty trie.
+	 */
+	PrefixTrie()
+		: _defaultSubnet(NONE)
+	{
+		addNode();
+	}
+
+	/**
+	 * @brief Constructs a trie holding the subnets of a table.
+	 *
+	 * @param table The table of subnets to index.
+	 */
+	explicit PrefixTrie(const SubnetTable<Traits>& table)
+		: PrefixTrie()
+	{
+		_subnets.reserve(table.size());
+
+		for (size_t i = 0; i < table.size(); ++i)
+		{
+			insert(table[i]);
+		}
+	}
+
+	/**
+	 * @brief Constructs a trie holding the subnets of a segmented network.
+	 *
+	 * @param network The network whose subnets are indexed, of the family of the trie.
+	 */
+	explicit PrefixTrie(const Network& network)
+		: PrefixTrie()
+	{
+		_subnets.reserve(network.getSubnetCount());
+
+		for (size_t i = 0; i < network.getSubnetCount(); ++i)
+		{
+			insert(*network.getSubnetUnchecked(i));
+		}
+	}
+
+	/**
+	 * @brief Retrieves the number of subnets in the trie.
+	 *
+	 * @return size_t The number of subnets.
+	 */
+	size_t size() const
+	{
+		return _subnets.size();
+	}
+
+	/**
+	 * @brief Checks if the trie contains no subnet.
+	 *
+	 * @return bool True if the trie is empty, false otherwise.
+	 */
+	bool empty() const
+	{
+		return _subnets.empty();
+	}
+
+	/**
+	 * @brief Inserts a subnet into the trie.
+	 *
+	 * @param subnet The subnet to insert.
+	 * @return size_t The index of the subnet, or the index of the equal subnet already in the trie.
+	 */
+	inline size_t insert(const Subnet<Traits>& subnet);
+
+	/**
+	 * @brief Inserts a network into the trie.
+	 *
+	 * @param network The network to insert, of the family of the trie.
+	 * @return size_t The index of the network, or the index of the equal subnet already in the trie.
+	 */
+	size_t insert(const Network& network)
+	{
+		return insert(Subnet<Traits>(Traits::toValue(*network.getIp()), network.getPrefixLength()));
+	}
+
+	/**
+	 * @brief Finds the most specific subnet containing an address.
+	 *
+	 * @param ip The value of the address to look up.
+	 * @return size_t The index of the longest subnet containing the address, or size() if there is none.
+	 */
+	inline size_t find(const value_type& ip) const;
+
+	/**
+	 * @brief Finds the most specific subnet containing each address of an array.
+	 *
+	 * @param ips The values of the addresses to look up.
+	 * @param count The number of addresses.
+	 * @param indices The array receiving the index of the subnet of each address, or size() if there is none.
+	 * @param threadCount The number of threads looking up the addresses, 0 meaning one per hardware thread.
+	 */
+	void find(const value_type* ips, size_t count, size_t* indices, unsigned threadCount = 1) const
+	{
+		parallelFor(count, threadCount, [this, ips, indices](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				indices[i] = find(ips[i]);
+			}
+		});
+	}
+
+	/**
+	 * @brief Retrieves the subnet at the given index.
+	 *
+	 * @param index The index of the subnet.
+	 * @return const Subnet<Traits>& The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	inline const Subnet<Traits>& operator [](size_t index) const;
+
+	/**
+	 * @brief Retrieves the entries of the nodes of the trie, node after node, the root first.
+	 *
+	 * @return const PrefixTrieEntry* A pointer to the ENTRIES entries of each of the getNodeCount() nodes.
+	 */
+	const PrefixTrieEntry* getEntries() const
+	{
+		return _nodes.data()->entries;
+	}
+
+	/**
+	 * @brief Retrieves the number of nodes of the trie.
+	 *
+	 * @return size_t The number of nodes, at least 1 for the root.
+	 */
+	size_t getNodeCount() const
+	{
+		return _nodes.size();
+	}
+
+	/**
+	 * @brief Retrieves the index of the subnet with an empty prefix.
+	 *
+	 * @return uint32_t The index of the subnet, or PREFIX_TRIE_NONE if there is none.
+	 */
+	uint32_t getDefaultSubnet() const
+	{
+		return _defaultSubnet;
+	}
+
+	/**
+	 * @brief Finds the most specific subnet containing an address in the nodes of a trie.
+	 *
+	 * @param entries The entries of the nodes, as returned by getEntries().
+	 * @param defaultSubnet The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+	 * @param ip The value of the address to look up.
+	 * @return uint32_t The index of the longest subnet containing the address, or PREFIX_TRIE_NONE if there is none.
+	 */
+	static inline uint32_t lookup(const PrefixTrieEntry* entries, uint32_t defaultSubnet, const value_type& ip);
+};
+
+/**
+ * @brief Inserts a subnet into the trie.
+ *
+ * This function walks down the levels the prefix of the subnet spans, creating
+ * the missing nodes, then stores the subnet in the entries of the last node its
+ * prefix covers, unless an entry already holds a longer subnet.
+ *
+ * @param subnet The subnet to insert.
+ * @return size_t The index of the subnet, or the index of the equal subnet already in the trie.
+ */
+template <typename Traits>
+size_t PrefixTrie<Traits>::insert(const Subnet<Traits>& subnet)
+{
+	value_type prefix = subnet.getValue();
+	int prefixLength = subnet.getPrefixLength();
+
+	// The subnet with an empty prefix covers every address
+	if (prefixLength == 0)
+	{
+		if (_defaultSubnet == NONE)
+		{
+			_defaultSubnet = addSubnet(subnet);
+		}
+
+		return _defaultSubnet;
+	}
+
+	uint32_t node = 0;
+	int level = 0;
+
+	// Walk down to the node of the level the prefix ends in
+	for (; prefixLength > (level + 1) * PREFIX_TRIE_STRIDE; ++level)
+	{
+		unsigned bits = Traits::bitsAt(prefix, level * PREFIX_TRIE_STRIDE, PREFIX_TRIE_STRIDE);
+
+		if (_nodes[node].entries[bits].child == NONE)
+		{
+			uint32_t child = addNode();
+			_nodes[node].entries[bits].child = child;
+		}
+
+		node = _nodes[node].entries[bits].child;
+	}
+
+	// Compute the entries covered by the prefix in the node
+	int length = prefixLength - level * PREFIX_TRIE_STRIDE;
+	unsigned first = Traits::bitsAt(prefix, level * PREFIX_TRIE_STRIDE, PREFIX_TRIE_STRIDE);
+	unsigned count = 1u << (PREFIX_TRIE_STRIDE - length);
+
+	// Return the equal subnet if the trie already holds it
+	uint32_t current = _nodes[node].entries[first].subnet;
+
+	if (current != NONE && _subnets[current].getPrefixLength() == prefixLength)
+	{
+		return current;
+	}
+
+	uint32_t index = addSubnet(subnet);
+
+	// Store the subnet in the entries that do not hold a longer subnet
+	for (unsigned bits = first; bits < first + count; ++bits)
+	{
+		Entry& entry = _nodes[node].entries[bits];
+
+		if (entry.subnet == NONE || _subnets[entry.subnet].getPrefixLength() < prefixLength)
+		{
+			entry.subnet = index;
+		}
+	}
+
+	return index;
+}
+
+/**
+ * @brief Finds the most specific subnet containing an address.
+ *
+ * @param ip The value of the address to look up.
+ * @return size_t The index of the longest subnet containing the address, or size() if there is none.
+ */
+template <typename Traits>
+size_t PrefixTrie<Traits>::find(const value_type& ip) const
+{
+	uint32_t best = lookup(getEntries(), _defaultSubnet, ip);
+
+	return (best == NONE) ? _subnets.size() : best;
+}
+
+/**
+ * @brief Finds the most specific subnet containing an address in the nodes of a trie.
+ *
+ * This function reads the entry of the address in each level, remembering the
+ * last subnet found, until an entry has no node below it. It only reads the
+ * entries, so it walks the nodes of a trie as well as their copy in a file.
+ *
+ * @param entries The entries of the nodes, as returned by getEntries().
+ * @param defaultSubnet The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+ * @param ip The value of the address to look up.
+ * @return uint32_t The index of the longest subnet containing the address, or PREFIX_TRIE_NONE if there is none.
+ */
+template <typename Traits>
+uint32_t PrefixTrie<Traits>::lookup(const PrefixTrieEntry* entries, uint32_t defaultSubnet, const value_type& ip)
+{
+	uint32_t node = 0;
+	uint32_t best = defaultSubnet;
+
+	for (int index = 0; index < Traits::ADDRESS_BITS; index += PREFIX_TRIE_STRIDE)
+	{
+		const Entry& entry = entries[(size_t)node * ENTRIES + Traits::bitsAt(ip, index, PREFIX_TRIE_STRIDE)];
+
+		if (entry.subnet != NONE)
+		{
+			best = entry.subnet;
+		}
+
+		if (entry.child == NONE)
+		{
+			break;
+		}
+
+		node = entry.child;
+	}
+
+	return best;
+}
+
+/**
+ * @brief Retrieves the subnet at the given index.
+ *
+ * @param index The index of the subnet.
+ * @return const Subnet<Traits>& The subnet at the given index.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename Traits>
+const Subnet<Traits>& PrefixTrie<Traits>::operator [](size_t index) const
+{
+	// Check if the index is out of range
+	if (index >= _subnets.size())
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(_subnets.size() - 1) + ".");
+	}
+
+	// Return the subnet at the specified index
+	return _subnets[index];
+}
+
+#endif // PREFIX_TRIE_H
@@ -0,0 +1,427 @@
+#ifndef SEGMENT_PLAN_H
+#define SEGMENT_PLAN_H
+
+#include "network/network.h"
+#include "network/subnet.h"
+#include "utils/utils.h"
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @struct PlanLevel
+ * @brief A level of a hierarchical segmentation plan.
+ */
+struct PlanLevel
+{
+	/**
+	 * @brief The prefix length of the subnets of the level.
+	 */
+	int prefixLength;
+
+	/**
+	 * @brief The number of subnets of the level in each subnet of the level above, 0 meaning all of them.
+	 */
+	uint64_t count;
+};
+
+/**
+ * @class SegmentPlan
+ * @brief Represents a lazily enumerated tree of subnets, segmented level by level.
+ *
+ * Each level splits every subnet of the level above, or the network for the
+ * first level, into its first subnets of a longer prefix length, such as region
+ * /16, then site /20, then VLAN /24, the leaves being the subnets of the last
+ * level. The plan only stores its levels and the size of a subtree of each
+ * level, so it uses constant memory whatever the number of subnets.
+ *
+ * Its subnets are enumerated depth-first, each subnet followed by the subtrees
+ * of its own subnets, and each one is computed on demand from its index by
+ * descending one level at a time. A subnet is therefore found in O(levels),
+ * and moving to the next one takes amortized constant time, so the plan can
+ * be cut into chunks written in parallel across sibling branches.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class SegmentPlan
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @class iterator
+	 * @brief Forward iterator over the subnets of a plan, depth-first.
+	 *
+	 * The iterator keeps the path from the network to its current subnet, so
+	 * advancing it only visits the levels it moves through. Adding an offset
+	 * to it descends the plan again from the network.
+	 */
+	class iterator
+	{
+	private:
+		/**
+		 * @brief The plan of the subnets.
+		 */
+		const SegmentPlan* _plan;
+
+		/**
+		 * @brief The index of the current subnet.
+		 */
+		uint64_t _index;
+
+		/**
+		 * @brief The level of the current subnet.
+		 */
+		size_t _depth;
+
+		/**
+		 * @brief The index of each subnet of the path among its siblings, by level.
+		 */
+		vector<uint64_t> _path;
+
+		/**
+		 * @brief The network address of each subnet of the path, by level.
+		 */
+		vector<typename Traits::value_type> _ips;
+
+		/**
+		 * @brief Moves the iterator to a subnet, descending the plan from the network.
+		 *
+		 * @param index The index of the subnet, less than the size of the plan.
+		 */
+		inline void seek(uint64_t index);
+
+	public:
+		typedef forward_iterator_tag iterator_category;
+		typedef Subnet<Traits> value_type;
+		typedef int64_t difference_type;
+		typedef Subnet<Traits> reference;
+		typedef void pointer;
+
+		/**
+		 * @brief Constructs an iterator over a plan at the given index.
+		 *
+		 * @param plan The plan of the subnets.
+		 * @param index The index of the subnet the iterator points to, the size of the plan for the end.
+		 */
+		iterator(const SegmentPlan& plan, uint64_t index)
+			: _plan(&plan), _index(index), _depth(0), _path(plan._levels.size()), _ips(plan._levels.size())
+		{
+			if (index < plan._size)
+			{
+				seek(index);
+			}
+		}
+
+		/**
+		 * @brief Retrieves the index of the subnet the iterator points to.
+		 *
+		 * @return uint64_t The index of the current subnet.
+		 */
+		uint64_t getIndex() const
+		{
+			return _index;
+		}
+
+		/**
+		 * @brief Retrieves the level of the subnet the iterator points to.
+		 *
+		 * @return size_t The level of the current subnet, 0 for the first level.
+		 */
+		size_t getDepth() const
+		{
+			return _depth;
+		}
+
+		/**
+		 * @brief Computes the subnet the iterator points to.
+		 *
+		 * @return Subnet<Traits> The current subnet.
+		 */
+		Subnet<Traits> operator *() const
+		{
+			return Subnet<Traits>(_ips[_depth], _plan->_levels[_depth].prefixLength);
+		}
+
+		/**
+		 * @brief Moves the iterator to the next subnet, depth-first.
+		 *
+		 * @return iterator& A reference to the iterator.
+		 */
+		inline iterator& operator ++();
+
+		// Index arithmetic and comparisons of the iterator
+		iterator operator ++(int) { iterator it = *this; ++(*this); return it; }
+		iterator operator +(difference_type offset) const { return iterator(*_plan, _index + offset); }
+		difference_type operator -(const iterator& other) const { return (difference_type)(_index - other._index); }
+		bool operator ==(const iterator& other) const { return _index == other._index; }
+		bool operator !=(const iterator& other) const { return _index != other._index; }
+	};
+
+private:
+	/**
+	 * @brief The network segmented by the plan.
+	 */
+	Subnet<Traits> _network;
+
+	/**
+	 * @brief The levels of the plan, their numbers of subnets resolved.
+	 */
+	vector<PlanLevel> _levels;
+
+	/**
+	 * @brief The number of subnets in the subtree of a subnet of each level, the subnet included.
+	 */
+	vector<uint64_t> _subtreeSizes;
+
+	/**
+	 * @brief The number of subnets of the plan, over all the levels.
+	 */
+	uint64_t _size;
+
+public:
+	/**
+	 * @brief Constructs the plan segmenting a network level by level.
+	 *
+	 * @param ip The address of the network, its host bits being ignored.
+	 * @param prefixLength The prefix length of the network.
+	 * @param levels The levels of the plan, from the first to the last.
+	 * @throws std::invalid_argument If the plan has no level, if the prefix lengths do not increase from the
+	 *         network up to the size of the address, if a level has more subnets than a subnet of the level
+	 *         above holds, or if the subnets cannot be counted on 64 bits.
+	 */
+	inline SegmentPlan(const value_type& ip, int prefixLength, const vector<PlanLevel>& levels);
+
+	/**
+	 * @brief Constructs the plan segmenting a network level by level.
+	 *
+	 * @param network The network, of the family of the plan.
+	 * @param levels The levels of the plan, from the first to the last.
+	 * @throws std::invalid_argument If the levels are not valid for the network.
+	 */
+	SegmentPlan(const Network& network, const vector<PlanLevel>& levels)
+		: SegmentPlan(Traits::toValue(*network.getIp()), network.getPrefixLength(), levels) {}
+
+	/**
+	 * @brief Retrieves the network segmented by the plan.
+	 *
+	 * @return const Subnet<Traits>& The network.
+	 */
+	const Subnet<Traits>& getNetwork() const
+	{
+		return _network;
+	}
+
+	/**
+	 * @brief Retrieves the levels of the plan.
+	 *
+	 * @return const vector<PlanLevel>& The levels, with the number of subnets of each one resolved.
+	 */
+	const vector<PlanLevel>& getLevels() const
+	{
+		return _levels;
+	}
+
+	/**
+	 * @brief Retrieves the number of subnets of the plan, over all the levels.
+	 *
+	 * @return uint64_t The number of subnets.
+	 */
+	uint64_t size() const
+	{
+		return _size;
+	}
+
+	/**
+	 * @brief Retrieves an iterator to the first subnet of the plan.
+	 *
+	 * @return iterator An iterator to the first subnet.
+	 */
+	iterator begin() const
+	{
+		return iterator(*this, 0);
+	}
+
+	/**
+	 * @brief Retrieves an iterator past the last subnet of the plan.
+	 *
+	 * @return iterator An iterator past the last subnet.
+	 */
+	iterator end() const
+	{
+		return iterator(*this, _size);
+	}
+
+	/**
+	 * @brief Computes the subnet at the given index, depth-first.
+	 *
+	 * @param index The index of the subnet.
+	 * @return Subnet<Traits> The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	Subnet<Traits> operator [](uint64_t index) const
+	{
+		if (index >= _size)
+		{
+			throwIndexOutOfRange((size_t)_size);
+		}
+
+		return *iterator(*this, index);
+	}
+};
+
+/**
+ * @brief Constructs the plan segmenting a network level by level.
+ *
+ * This function resolves the number of subnets of each level, then computes the
+ * size of a subtree of each level from the last level up, checking each product
+ * for an overflow.
+ *
+ * @param ip The address of the network, its host bits being ignored.
+ * @param prefixLength The prefix length of the network.
+ * @param levels The levels of the plan, from the first to the last.
+ * @throws std::invalid_argument If the plan has no level, if the prefix lengths do not increase from the
+ *         network up to the size of the address, if a level has more subnets than a subnet of the level
+ *         above holds, or if the subnets cannot be counted on 64 bits.
+ */
+template <typename Traits>
+SegmentPlan<Traits>::SegmentPlan(const value_type& ip, int prefixLength, const vector<PlanLevel>& levels)
+	: _network(ip, prefixLength), _levels(levels), _subtreeSizes(levels.size()), _size(0)
+{
+	// Check if the plan has a level
+	if (_levels.empty())
+	{
+		throw invalid_argument("Invalid plan: must have at least one level.");
+	}
+
+	int parentPrefixLength = prefixLength;
+
+	// Check the prefix lengths and resolve the number of subnets of each level
+	for (PlanLevel& level : _levels)
+	{
+		if (level.prefixLength <= parentPrefixLength || level.prefixLength > Traits::ADDRESS_BITS)
+		{
+			throw invalid_argument("Invalid plan: the prefix lengths must increase from the prefix length of the network up to "
+				+ to_string(Traits::ADDRESS_BITS) + ".");
+		}
+
+		int bits = level.prefixLength - parentPrefixLength;
+
+		if (level.count == 0 && bits >= 64)
+		{
+			throw invalid_argument("Invalid plan: the subnets cannot be counted on 64 bits.");
+		}
+
+		if (bits < 64 && level.count > (1ULL << bits))
+		{
+			throw invalid_argument("Invalid plan: a level has more subnets than a subnet of the level above holds.");
+		}
+
+		level.count = (level.count == 0) ? (1ULL << bits) : level.count;
+		parentPrefixLength = level.prefixLength;
+	}
+
+	// Compute the size of a subtree of each level, from the last level up
+	uint64_t subtreeSize = 1;
+
+	for (size_t i = _levels.size(); i-- > 0;)
+	{
+		_subtreeSizes[i] = subtreeSize;
+
+		uint64_t count = _levels[i].count;
+
+		if (subtreeSize > (UINT64_MAX - 1) / count)
+		{
+			throw invalid_argument("Invalid plan: the subnets cannot be counted on 64 bits.");
+		}
+
+		subtreeSize = 1 + count * subtreeSize;
+	}
+
+	_size = subtreeSize - 1;
+}
+
+/**
+ * @brief Moves the iterator to a subnet, descending the plan from the network.
+ *
+ * At each level, the index among the subtrees of the level gives the subnet of
+ * the level and the index left inside its subtree, 0 being the subnet itself.
+ *
+ * @param index The index of the subnet, less than the size of the plan.
+ */
+template <typename Traits>
+void SegmentPlan<Traits>::iterator::seek(uint64_t index)
+{
+	typename Traits::value_type parentIp = _plan->_network.getValue();
+	uint64_t remainder = index;
+
+	_index = index;
+
+	for (size_t depth = 0; ; ++depth)
+	{
+		uint64_t subtreeSize = _plan->_subtreeSizes[depth];
+
+		// Find the subnet of the level holding the index
+		_path[depth] = remainder / subtreeSize;
+		_ips[depth] = parentIp + Traits::subnetOffset(_path[depth], _plan->_levels[depth].prefixLength);
+		remainder %= subtreeSize;
+
+		// Stop at the subnet itself, or descend into its subtree
+		if (remainder == 0)
+		{
+			_depth = depth;
+			return;
+		}
+
+		remainder -= 1;
+		parentIp = _ips[depth];
+	}
+}
+
+/**
+ * @brief Moves the iterator to the next subnet, depth-first.
+ *
+ * The next subnet is the first subnet of the current one, unless it is on the
+ * last level. Otherwise it is the next sibling of the current subnet or of the
+ * closest of its parents that has one.
+ *
+ * @return iterator& A reference to the iterator.
+ */
+template <typename Traits>
+typename SegmentPlan<Traits>::iterator& SegmentPlan<Traits>::iterator::operator ++()
+{
+	const vector<PlanLevel>& levels = _plan->_levels;
+
+	++_index;
+
+	// Descend into the first subnet of the current subnet
+	if (_depth + 1 < levels.size())
+	{
+		++_depth;
+		_path[_depth] = 0;
+		_ips[_depth] = _ips[_depth - 1];
+
+		return *this;
+	}
+
+	// Go up to the closest level whose subnet has a next sibling
+	while (_depth > 0 && _path[_depth] + 1 == levels[_depth].count)
+	{
+		--_depth;
+	}
+
+	// Move to the next sibling, unless the plan is over
+	if (_path[_depth] + 1 < levels[_depth].count)
+	{
+		++_path[_depth];
+		_ips[_depth] = _ips[_depth] + Traits::subnetOffset(1, levels[_depth].prefixLength);
+	}
+
+	return *this;
+}
+
+#endif // SEGMENT_PLAN_H
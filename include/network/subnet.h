@@ -0,0 +1,149 @@
+#ifndef SUBNET_H
+#define SUBNET_H
+
+#include "network/network_traits.h"
+
+/**
+ * @class Subnet
+ * @brief Represents a subnet as a lightweight value.
+ *
+ * A subnet only holds its network address and its prefix length. The first host,
+ * last host and broadcast addresses are derived on demand, so a subnet can be
+ * copied freely and stored densely without any allocation.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class Subnet
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @brief The address class of the family.
+	 */
+	typedef typename Traits::address_type address_type;
+
+private:
+	/**
+	 * @brief The network address of the subnet.
+	 */
+	value_type _ip;
+
+	/**
+	 * @brief The prefix length of the subnet.
+	 */
+	int _prefixLength;
+
+public:
+	/**
+	 * @brief Constructs a Subnet object from an address and a prefix length.
+	 *
+	 * The host bits of the address are cleared to obtain the network address.
+	 *
+	 * @param ip The value of an address of the subnet.
+	 * @param prefixLength The prefix length of the subnet.
+	 */
+	Subnet(const value_type& ip, int prefixLength)
+		: _ip(ip & ~Traits::hostMask(prefixLength)), _prefixLength(prefixLength) {}
+
+	/**
+	 * @brief Retrieves the value of the network address of the subnet.
+	 *
+	 * @return value_type The value of the network address.
+	 */
+	value_type getValue() const
+	{
+		return _ip;
+	}
+
+	/**
+	 * @brief Retrieves the network address of the subnet.
+	 *
+	 * @return address_type The network address.
+	 */
+	address_type getIp() const
+	{
+		return Traits::toAddress(_ip);
+	}
+
+	/**
+	 * @brief Retrieves the first host address of the subnet.
+	 *
+	 * @return address_type The first host address.
+	 */
+	address_type getFirstIp() const
+	{
+		return Traits::toAddress(Traits::firstHost(_ip, _prefixLength));
+	}
+
+	/**
+	 * @brief Retrieves the last host address of the subnet.
+	 *
+	 * @return address_type The last host address.
+	 */
+	address_type getLastIp() const
+	{
+		return Traits::toAddress(Traits::lastHost(_ip, _prefixLength));
+	}
+
+	/**
+	 * @brief Retrieves the highest address of the subnet.
+	 *
+	 * On IPv4 this is the broadcast address of the subnet.
+	 *
+	 * @return address_type The highest address of the subnet.
+	 */
+	address_type getBroadcastIp() const
+	{
+		return Traits::toAddress(_ip | Traits::hostMask(_prefixLength));
+	}
+
+	/**
+	 * @brief Retrieves the prefix length of the subnet.
+	 *
+	 * @return int The prefix length.
+	 */
+	int getPrefixLength() const
+	{
+		return _prefixLength;
+	}
+
+	/**
+	 * @brief Checks if an address belongs to the subnet.
+	 *
+	 * @param ip The value of the address to check.
+	 * @return bool True if the address is within the subnet, false otherwise.
+	 */
+	bool contains(const value_type& ip) const
+	{
+		return (ip & ~Traits::hostMask(_prefixLength)) == _ip;
+	}
+
+	/**
+	 * @brief Checks if two subnets are equal.
+	 *
+	 * @param other The subnet to compare with.
+	 * @return bool True if both subnets have the same network address and prefix length.
+	 */
+	bool operator ==(const Subnet& other) const
+	{
+		return _ip == other._ip && _prefixLength == other._prefixLength;
+	}
+
+	/**
+	 * @brief Checks if two subnets differ.
+	 *
+	 * @param other The subnet to compare with.
+	 * @return bool True if the subnets differ in network address or prefix length.
+	 */
+	bool operator !=(const Subnet& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+#endif // SUBNET_H
\ No newline at end of file
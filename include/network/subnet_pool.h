@@ -0,0 +1,660 @@
+#ifndef SUBNET_POOL_H
+#define SUBNET_POOL_H
+
+#include "network/subnet_range.h"
+#include "utils/parallel.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#define SUBNET_POOL_MAX_SIZE (1ULL << 32) ///< The maximum number of subnets of a pool, whose bitmap then takes 512 MiB.
+#define SUBNET_POOL_WORD_BITS 64 ///< The number of subnets of a word of the bitmap.
+#define SUBNET_POOL_LINE_WORDS 8 ///< The number of words of the bitmap in a cache line, the shards being made of whole lines.
+
+/**
+ * @class SubnetPool
+ * @brief Thread-safe allocator of the subnets of a range.
+ *
+ * The pool holds one bit per subnet of the range, set if the subnet is
+ * allocated, in a bitmap split into shards of whole cache lines. Each shard
+ * has its own count of free subnets, held on a cache line of its own, and an
+ * allocation first reserves a subnet of a shard by decrementing its count,
+ * then claims a clear bit of the shard with a compare-and-swap, so that the
+ * allocations and the releases are lock-free and take a constant number of
+ * atomic operations when the shard is not exhausted. A shard with no free
+ * subnet is skipped without being scanned, and an allocation moves on to the
+ * next shards until one has a free subnet.
+ *
+ * The threads allocating concurrently should each use their own Cache, which
+ * spreads them over the shards and keeps the position of their last
+ * allocation, so that the threads work on different cache lines and the
+ * throughput grows with the number of cores. The allocations without a cache
+ * use the shard of the calling thread's identifier.
+ *
+ * A pool of host addresses is built from the range of the subnets of a network
+ * with the full prefix length, given by subnets(Traits::ADDRESS_BITS), with
+ * tryClaim() excluding the addresses that are not to be allocated.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class SubnetPool
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @class Cache
+	 * @brief Per-thread state of the allocations from a pool.
+	 *
+	 * A cache is assigned a shard of the pool in turn when it is constructed, and
+	 * keeps the word of its last allocation, where the next one starts. It moves
+	 * to the shard it allocated from when its own one is exhausted. A cache is
+	 * not thread-safe, each thread allocating with its own.
+	 */
+	class Cache
+	{
+	private:
+		/**
+		 * @brief The pool the subnets are allocated from.
+		 */
+		SubnetPool* _pool;
+
+		/**
+		 * @brief The shard the allocations start from.
+		 */
+		size_t _shard;
+
+		/**
+		 * @brief The word of the bitmap the allocations start from.
+		 */
+		uint64_t _cursor;
+
+	public:
+		/**
+		 * @brief Constructs a cache of a pool, assigned the next shard.
+		 *
+		 * @param pool The pool the subnets are allocated from, which must outlive the cache.
+		 */
+		explicit Cache(SubnetPool& pool)
+			: _pool(&pool), _shard(pool._nextShard.fetch_add(1, memory_order_relaxed) % pool._shardCount),
+			_cursor(pool._shards[_shard].firstWord) {}
+
+		/**
+		 * @brief Allocates a subnet without throwing.
+		 *
+		 * @param index The index of the allocated subnet in the range, only set if a subnet is allocated.
+		 * @return bool True if a subnet is allocated, false if all the subnets are allocated.
+		 */
+		bool tryAllocate(uint64_t& index)
+		{
+			return _pool->tryAllocateFrom(_shard, _cursor, index);
+		}
+
+		/**
+		 * @brief Allocates a subnet.
+		 *
+		 * @return uint64_t The index of the allocated subnet in the range.
+		 * @throws std::out_of_range If all the subnets are allocated.
+		 */
+		inline uint64_t allocate();
+
+		/**
+		 * @brief Releases an allocated subnet.
+		 *
+		 * @param index The index of the subnet in the range.
+		 * @throws std::out_of_range If the index is out of range.
+		 * @throws std::invalid_argument If the subnet is not allocated.
+		 */
+		void release(uint64_t index)
+		{
+			_pool->release(index);
+		}
+	};
+
+private:
+	/**
+	 * @struct Shard
+	 * @brief Consecutive words of the bitmap, allocated from independently of the other shards.
+	 *
+	 * The shard is aligned to a cache line of its own, so that updating its count
+	 * does not contend with the other shards.
+	 */
+	struct alignas(64) Shard
+	{
+		/**
+		 * @brief The number of free subnets of the shard not reserved by an allocation.
+		 */
+		atomic<uint64_t> free{ 0 };
+
+		/**
+		 * @brief The word of the last allocation without a cache, where the next one starts.
+		 */
+		atomic<uint64_t> cursor{ 0 };
+
+		/**
+		 * @brief The first word of the shard.
+		 */
+		uint64_t firstWord = 0;
+
+		/**
+		 * @brief The word following the last word of the shard.
+		 */
+		uint64_t endWord = 0;
+	};
+
+	/**
+	 * @brief The subnets of the pool.
+	 */
+	SubnetRange<Traits> _range;
+
+	/**
+	 * @brief The number of words of the bitmap.
+	 */
+	uint64_t _wordCount;
+
+	/**
+	 * @brief The bitmap of the allocated subnets, the bits past the last subnet being set.
+	 */
+	unique_ptr<atomic<uint64_t>[]> _words;
+
+	/**
+	 * @brief The number of words of a shard, a multiple of SUBNET_POOL_LINE_WORDS.
+	 */
+	uint64_t _shardWords;
+
+	/**
+	 * @brief The number of shards.
+	 */
+	size_t _shardCount;
+
+	/**
+	 * @brief The shards of the bitmap.
+	 */
+	unique_ptr<Shard[]> _shards;
+
+	/**
+	 * @brief The counter assigning their shard to the caches in turn.
+	 */
+	atomic<size_t> _nextShard{ 0 };
+
+	/**
+	 * @brief Allocates a subnet, starting from a shard and a word.
+	 *
+	 * @param shard The shard to start from, set to the shard of the allocated subnet.
+	 * @param cursor The word to start from, set to the word of the allocated subnet.
+	 * @param index The index of the allocated subnet, only set if a subnet is allocated.
+	 * @return bool True if a subnet is allocated, false if all the subnets are allocated.
+	 */
+	inline bool tryAllocateFrom(size_t& shard, uint64_t& cursor, uint64_t& index);
+
+	/**
+	 * @brief Reserves a free subnet of a shard.
+	 *
+	 * @param shard The shard.
+	 * @return bool True if a subnet is reserved, false if the shard has no free subnet.
+	 */
+	inline bool reserve(Shard& shard);
+
+public:
+	/**
+	 * @brief Constructs a pool of the subnets of a range, none of them being allocated.
+	 *
+	 * @param range The subnets of the pool.
+	 * @param shardCount The number of shards of the bitmap, 0 meaning one per hardware thread.
+	 * @throws std::invalid_argument If the range is empty or holds more than SUBNET_POOL_MAX_SIZE subnets.
+	 */
+	inline explicit SubnetPool(const SubnetRange<Traits>& range, unsigned shardCount = 0);
+
+	SubnetPool(const SubnetPool&) = delete;
+	SubnetPool& operator =(const SubnetPool&) = delete;
+
+	/**
+	 * @brief Retrieves the number of subnets of the pool.
+	 *
+	 * @return uint64_t The number of subnets, allocated or not.
+	 */
+	uint64_t size() const
+	{
+		return _range.size();
+	}
+
+	/**
+	 * @brief Retrieves the number of shards of the bitmap.
+	 *
+	 * @return size_t The number of shards.
+	 */
+	size_t getShardCount() const
+	{
+		return _shardCount;
+	}
+
+	/**
+	 * @brief Retrieves the subnets of the pool.
+	 *
+	 * @return const SubnetRange<Traits>& The range of the subnets, indexed as the pool.
+	 */
+	const SubnetRange<Traits>& getRange() const
+	{
+		return _range;
+	}
+
+	/**
+	 * @brief Computes the subnet at the given index.
+	 *
+	 * @param index The index of the subnet.
+	 * @return Subnet<Traits> The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	Subnet<Traits> operator [](uint64_t index) const
+	{
+		return _range[index];
+	}
+
+	/**
+	 * @brief Allocates a subnet without throwing, from the shard of the calling thread.
+	 *
+	 * @param index The index of the allocated subnet in the range, only set if a subnet is allocated.
+	 * @return bool True if a subnet is allocated, false if all the subnets are allocated.
+	 */
+	inline bool tryAllocate(uint64_t& index);
+
+	/**
+	 * @brief Allocates a subnet, from the shard of the calling thread.
+	 *
+	 * @return uint64_t The index of the allocated subnet in the range.
+	 * @throws std::out_of_range If all the subnets are allocated.
+	 */
+	inline uint64_t allocate();
+
+	/**
+	 * @brief Allocates a given subnet if it is free.
+	 *
+	 * @param index The index of the subnet in the range.
+	 * @return bool True if the subnet is allocated by the call, false if it already was.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	inline bool tryClaim(uint64_t index);
+
+	/**
+	 * @brief Releases an allocated subnet.
+	 *
+	 * @param index The index of the subnet in the range.
+	 * @throws std::out_of_range If the index is out of range.
+	 * @throws std::invalid_argument If the subnet is not allocated.
+	 */
+	inline void release(uint64_t index);
+
+	/**
+	 * @brief Checks if a subnet is allocated.
+	 *
+	 * @param index The index of the subnet in the range.
+	 * @return bool True if the subnet is allocated, false otherwise.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	inline bool isAllocated(uint64_t index) const;
+
+	/**
+	 * @brief Counts the allocated subnets.
+	 *
+	 * @return uint64_t The number of allocated subnets, the allocations in progress included.
+	 */
+	inline uint64_t getAllocatedCount() const;
+
+	/**
+	 * @brief Calls a function on the index of each allocated subnet, in order, without stopping the allocations.
+	 *
+	 * @tparam Function The type of the function, called as function(index).
+	 * @param function The function called on each allocated subnet.
+	 */
+	template <typename Function>
+	inline void forEachAllocated(Function function) const;
+};
+
+/**
+ * @brief Allocates a subnet.
+ *
+ * @return uint64_t The index of the allocated subnet in the range.
+ * @throws std::out_of_range If all the subnets are allocated.
+ */
+template <typename Traits>
+uint64_t SubnetPool<Traits>::Cache::allocate()
+{
+	uint64_t index = 0;
+
+	if (!tryAllocate(index))
+	{
+		throw out_of_range("Pool exhausted, all the " + to_string(_pool->size()) + " subnets are allocated.");
+	}
+
+	return index;
+}
+
+/**
+ * @brief Constructs a pool of the subnets of a range, none of them being allocated.
+ *
+ * The bitmap is split into at most shardCount shards of the same number of
+ * whole cache lines, the last one holding the remaining words.
+ *
+ * @param range The subnets of the pool.
+ * @param shardCount The number of shards of the bitmap, 0 meaning one per hardware thread.
+ * @throws std::invalid_argument If the range is empty or holds more than SUBNET_POOL_MAX_SIZE subnets.
+ */
+template <typename Traits>
+SubnetPool<Traits>::SubnetPool(const SubnetRange<Traits>& range, unsigned shardCount)
+	: _range(range), _wordCount((range.size() + SUBNET_POOL_WORD_BITS - 1) / SUBNET_POOL_WORD_BITS)
+{
+	// Check if the number of subnets is valid
+	if (range.empty() || range.size() > SUBNET_POOL_MAX_SIZE)
+	{
+		throw invalid_argument("Invalid pool: must hold between 1 and " + to_string(SUBNET_POOL_MAX_SIZE) + " subnets.");
+	}
+
+	// Split the bitmap into shards of whole cache lines
+	uint64_t lineCount = (_wordCount + SUBNET_POOL_LINE_WORDS - 1) / SUBNET_POOL_LINE_WORDS;
+	uint64_t maximumShards = min((uint64_t)resolveThreadCount(shardCount), lineCount);
+
+	_shardWords = (lineCount + maximumShards - 1) / maximumShards * SUBNET_POOL_LINE_WORDS;
+	_shardCount = (size_t)((_wordCount + _shardWords - 1) / _shardWords);
+	_words.reset(new atomic<uint64_t>[_wordCount]);
+	_shards.reset(new Shard[_shardCount]);
+
+	for (uint64_t i = 0; i < _wordCount; ++i)
+	{
+		_words[i].store(0, memory_order_relaxed);
+	}
+
+	// Set the bits past the last subnet so that they are never allocated
+	if (range.size() % SUBNET_POOL_WORD_BITS != 0)
+	{
+		_words[_wordCount - 1].store(~0ULL << (range.size() % SUBNET_POOL_WORD_BITS), memory_order_relaxed);
+	}
+
+	// Count the free subnets of each shard
+	for (size_t i = 0; i < _shardCount; ++i)
+	{
+		Shard& shard = _shards[i];
+
+		shard.firstWord = i * _shardWords;
+		shard.endWord = min(shard.firstWord + _shardWords, _wordCount);
+		shard.cursor.store(shard.firstWord, memory_order_relaxed);
+		shard.free.store(min(shard.endWord * SUBNET_POOL_WORD_BITS, range.size()) - shard.firstWord * SUBNET_POOL_WORD_BITS, memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Reserves a free subnet of a shard.
+ *
+ * The count of the free subnets of a shard is decremented before a bit is set
+ * and incremented after a bit is cleared, so it never exceeds the number of
+ * clear bits, and a reservation guarantees that a clear bit is left for it.
+ *
+ * @param shard The shard.
+ * @return bool True if a subnet is reserved, false if the shard has no free subnet.
+ */
+template <typename Traits>
+bool SubnetPool<Traits>::reserve(Shard& shard)
+{
+	uint64_t free = shard.free.load(memory_order_relaxed);
+
+	do
+	{
+		if (free == 0)
+		{
+			return false;
+		}
+	}
+	while (!shard.free.compare_exchange_weak(free, free - 1, memory_order_relaxed));
+
+	return true;
+}
+
+/**
+ * @brief Allocates a subnet, starting from a shard and a word.
+ *
+ * The first shard with a free subnet is reserved from, the shards being tried
+ * in turn, then its words are scanned from the cursor for a clear bit, the
+ * lowest one of a word being set with a compare-and-swap.
+ *
+ * @param shard The shard to start from, set to the shard of the allocated subnet.
+ * @param cursor The word to start from, set to the word of the allocated subnet.
+ * @param index The index of the allocated subnet, only set if a subnet is allocated.
+ * @return bool True if a subnet is allocated, false if all the subnets are allocated.
+ */
+template <typename Traits>
+bool SubnetPool<Traits>::tryAllocateFrom(size_t& shard, uint64_t& cursor, uint64_t& index)
+{
+	// Find a shard with a free subnet, starting from the given one
+	size_t tried = 0;
+
+	while (!reserve(_shards[shard]))
+	{
+		if (++tried == _shardCount)
+		{
+			return false;
+		}
+
+		shard = (shard + 1 == _shardCount) ? 0 : shard + 1;
+		cursor = _shards[shard].cursor.load(memory_order_relaxed);
+	}
+
+	Shard& reserved = _shards[shard];
+	uint64_t word = (cursor >= reserved.firstWord && cursor < reserved.endWord) ? cursor : reserved.firstWord;
+
+	// Claim a clear bit from the cursor, one being left for the reservation
+	while (true)
+	{
+		uint64_t bits = _words[word].load(memory_order_relaxed);
+
+		while (bits != ~0ULL)
+		{
+			uint64_t bit = ~bits & (bits + 1);
+
+			if (_words[word].compare_exchange_weak(bits, bits | bit, memory_order_acquire, memory_order_relaxed))
+			{
+				cursor = word;
+				index = word * SUBNET_POOL_WORD_BITS + (uint64_t)__builtin_ctzll(bit);
+
+				return true;
+			}
+		}
+
+		word = (word + 1 == reserved.endWord) ? reserved.firstWord : word + 1;
+	}
+}
+
+/**
+ * @brief Allocates a subnet without throwing, from the shard of the calling thread.
+ *
+ * The shard is chosen from the identifier of the thread, and its shared cursor
+ * is updated by the allocation, so the threads allocating often should rather
+ * use a Cache each.
+ *
+ * @param index The index of the allocated subnet in the range, only set if a subnet is allocated.
+ * @return bool True if a subnet is allocated, false if all the subnets are allocated.
+ */
+template <typename Traits>
+bool SubnetPool<Traits>::tryAllocate(uint64_t& index)
+{
+	size_t home = hash<thread::id>()(this_thread::get_id()) % _shardCount;
+	size_t shard = home;
+	uint64_t cursor = _shards[home].cursor.load(memory_order_relaxed);
+
+	if (!tryAllocateFrom(shard, cursor, index))
+	{
+		return false;
+	}
+
+	_shards[shard].cursor.store(cursor, memory_order_relaxed);
+
+	return true;
+}
+
+/**
+ * @brief Allocates a subnet, from the shard of the calling thread.
+ *
+ * @return uint64_t The index of the allocated subnet in the range.
+ * @throws std::out_of_range If all the subnets are allocated.
+ */
+template <typename Traits>
+uint64_t SubnetPool<Traits>::allocate()
+{
+	uint64_t index = 0;
+
+	if (!tryAllocate(index))
+	{
+		throw out_of_range("Pool exhausted, all the " + to_string(size()) + " subnets are allocated.");
+	}
+
+	return index;
+}
+
+/**
+ * @brief Allocates a given subnet if it is free.
+ *
+ * A subnet of the shard is reserved first, and given back if the bit of the
+ * subnet was already set.
+ *
+ * @param index The index of the subnet in the range.
+ * @return bool True if the subnet is allocated by the call, false if it already was.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename Traits>
+bool SubnetPool<Traits>::tryClaim(uint64_t index)
+{
+	// Check if the index is out of range
+	if (index >= size())
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(size() - 1) + ".");
+	}
+
+	Shard& shard = _shards[index / SUBNET_POOL_WORD_BITS / _shardWords];
+	uint64_t bit = 1ULL << (index % SUBNET_POOL_WORD_BITS);
+
+	if (!reserve(shard))
+	{
+		return false;
+	}
+
+	// Set the bit of the subnet, giving the reservation back if it already was
+	if (_words[index / SUBNET_POOL_WORD_BITS].fetch_or(bit, memory_order_acquire) & bit)
+	{
+		shard.free.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Releases an allocated subnet.
+ *
+ * The bit of the subnet is cleared before the count of the free subnets of its
+ * shard is incremented, with a release ordering so that the next allocation of
+ * the subnet sees the writes made before its release.
+ *
+ * @param index The index of the subnet in the range.
+ * @throws std::out_of_range If the index is out of range.
+ * @throws std::invalid_argument If the subnet is not allocated.
+ */
+template <typename Traits>
+void SubnetPool<Traits>::release(uint64_t index)
+{
+	// Check if the index is out of range
+	if (index >= size())
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(size() - 1) + ".");
+	}
+
+	uint64_t bit = 1ULL << (index % SUBNET_POOL_WORD_BITS);
+
+	// Clear the bit of the subnet, which must have been set
+	if (!(_words[index / SUBNET_POOL_WORD_BITS].fetch_and(~bit, memory_order_release) & bit))
+	{
+		throw invalid_argument("Invalid release: the subnet is not allocated.");
+	}
+
+	_shards[index / SUBNET_POOL_WORD_BITS / _shardWords].free.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Checks if a subnet is allocated.
+ *
+ * @param index The index of the subnet in the range.
+ * @return bool True if the subnet is allocated, false otherwise.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename Traits>
+bool SubnetPool<Traits>::isAllocated(uint64_t index) const
+{
+	// Check if the index is out of range
+	if (index >= size())
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(size() - 1) + ".");
+	}
+
+	return (_words[index / SUBNET_POOL_WORD_BITS].load(memory_order_acquire) >> (index % SUBNET_POOL_WORD_BITS)) & 1;
+}
+
+/**
+ * @brief Counts the allocated subnets.
+ *
+ * The count is computed from the counts of the shards, so it takes a load per
+ * shard, and includes the allocations that have reserved a subnet but not yet
+ * claimed its bit.
+ *
+ * @return uint64_t The number of allocated subnets, the allocations in progress included.
+ */
+template <typename Traits>
+uint64_t SubnetPool<Traits>::getAllocatedCount() const
+{
+	uint64_t free = 0;
+
+	for (size_t i = 0; i < _shardCount; ++i)
+	{
+		free += _shards[i].free.load(memory_order_relaxed);
+	}
+
+	return size() - min(free, size());
+}
+
+/**
+ * @brief Calls a function on the index of each allocated subnet, in order, without stopping the allocations.
+ *
+ * Each word of the bitmap is loaded once, so the allocations and the releases
+ * go on during the iteration, and each subnet is reported as it was when its
+ * word was loaded: the iteration is a snapshot of each word, not of the whole
+ * pool at once.
+ *
+ * @tparam Function The type of the function, called as function(index).
+ * @param function The function called on each allocated subnet.
+ */
+template <typename Traits>
+template <typename Function>
+void SubnetPool<Traits>::forEachAllocated(Function function) const
+{
+	for (uint64_t i = 0; i < _wordCount; ++i)
+	{
+		uint64_t bits = _words[i].load(memory_order_acquire);
+
+		// Ignore the bits past the last subnet
+		if (i == _wordCount - 1 && size() % SUBNET_POOL_WORD_BITS != 0)
+		{
+			bits &= ~(~0ULL << (size() % SUBNET_POOL_WORD_BITS));
+		}
+
+		// Report the set bits from the lowest one
+		while (bits != 0)
+		{
+			function(i * SUBNET_POOL_WORD_BITS + (uint64_t)__builtin_ctzll(bits));
+			bits &= bits - 1;
+		}
+	}
+}
+
+#endif // SUBNET_POOL_H
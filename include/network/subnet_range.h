@@ -0,0 +1,337 @@
+#ifndef SUBNET_RANGE_H
+#define SUBNET_RANGE_H
+
+#include "network/subnet.h"
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @class SubnetRange
+ * @brief Represents a lazily enumerated sequence of consecutive subnets.
+ *
+ * The range only stores the base address, the prefix length of its subnets and
+ * their number. Each subnet is computed on demand from its index, so the range uses
+ * constant memory whatever the number of subnets, and can be iterated, indexed,
+ * paged or stopped early without materializing any subnet.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class SubnetRange
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @class iterator
+	 * @brief Random access iterator over the subnets of a range.
+	 *
+	 * Dereferencing the iterator computes the subnet at its current index and
+	 * returns it by value.
+	 */
+	class iterator
+	{
+	private:
+		/**
+		 * @brief The base address of the range.
+		 */
+		typename Traits::value_type _base;
+
+		/**
+		 * @brief The prefix length of the subnets.
+		 */
+		int _prefixLength;
+
+		/**
+		 * @brief The index of the current subnet.
+		 */
+		uint64_t _index;
+
+	public:
+		typedef random_access_iterator_tag iterator_category;
+		typedef Subnet<Traits> value_type;
+		typedef int64_t difference_type;
+		typedef Subnet<Traits> reference;
+		typedef void pointer;
+
+		/**
+		 * @brief Constructs an iterator over the given range at the given index.
+		 *
+		 * @param base The base address of the range.
+		 * @param prefixLength The prefix length of the subnets.
+		 * @param index The index of the subnet the iterator points to.
+		 */
+		iterator(const typename Traits::value_type& base, int prefixLength, uint64_t index)
+			: _base(base), _prefixLength(prefixLength), _index(index) {}
+
+		/**
+		 * @brief Retrieves the index of the subnet the iterator points to.
+		 *
+		 * @return uint64_t The index of the current subnet.
+		 */
+		uint64_t getIndex() const
+		{
+			return _index;
+		}
+
+		/**
+		 * @brief Computes the subnet the iterator points to.
+		 *
+		 * @return Subnet<Traits> The current subnet.
+		 */
+		Subnet<Traits> operator *() const
+		{
+			return Subnet<Traits>(_base + Traits::subnetOffset(_index, _prefixLength), _prefixLength);
+		}
+
+		/**
+		 * @brief Computes the subnet at the given offset from the iterator.
+		 *
+		 * @param offset The offset from the current subnet.
+		 * @return Subnet<Traits> The subnet at the given offset.
+		 */
+		Subnet<Traits> operator [](difference_type offset) const
+		{
+			return *(*this + offset);
+		}
+
+		// Index arithmetic and comparisons of the iterator
+		iterator& operator ++() { ++_index; return *this; }
+		iterator& operator --() { --_index; return *this; }
+		iterator operator ++(int) { iterator it = *this; ++_index; return it; }
+		iterator operator --(int) { iterator it = *this; --_index; return it; }
+		iterator& operator +=(difference_type offset) { _index += offset; return *this; }
+		iterator& operator -=(difference_type offset) { _index -= offset; return *this; }
+		iterator operator +(difference_type offset) const { iterator it = *this; return it += offset; }
+		iterator operator -(difference_type offset) const { iterator it = *this; return it -= offset; }
+		difference_type operator -(const iterator& other) const { return (difference_type)(_index - other._index); }
+		bool operator ==(const iterator& other) const { return _index == other._index; }
+		bool operator !=(const iterator& other) const { return _index != other._index; }
+		bool operator <(const iterator& other) const { return _index < other._index; }
+		bool operator >(const iterator& other) const { return _index > other._index; }
+		bool operator <=(const iterator& other) const { return _index <= other._index; }
+		bool operator >=(const iterator& other) const { return _index >= other._index; }
+	};
+
+private:
+	/**
+	 * @brief The network address of the first subnet of the range.
+	 */
+	value_type _base;
+
+	/**
+	 * @brief The prefix length of the subnets of the range.
+	 */
+	int _prefixLength;
+
+	/**
+	 * @brief The number of subnets in the range.
+	 */
+	uint64_t _count;
+
+public:
+	/**
+	 * @brief Constructs a range of consecutive subnets.
+	 *
+	 * @param base The network address of the first subnet.
+	 * @param prefixLength The prefix length of the subnets.
+	 * @param count The number of subnets in the range.
+	 */
+	SubnetRange(const value_type& base, int prefixLength, uint64_t count)
+		: _base(base & ~Traits::hostMask(prefixLength)), _prefixLength(prefixLength), _count(count) {}
+
+	/**
+	 * @brief Creates the range of all the subnets of a network with a longer prefix length.
+	 *
+	 * @param network The network address of the network to split.
+	 * @param prefixLength The prefix length of the network to split.
+	 * @param newPrefixLength The prefix length of the subnets.
+	 * @return SubnetRange The range of the 2^(newPrefixLength - prefixLength) subnets.
+	 * @throws std::invalid_argument If the new prefix length is shorter than the prefix length
+	 *         or longer than the address, or if the subnets cannot be counted on 64 bits.
+	 */
+	static inline SubnetRange split(const value_type& network, int prefixLength, int newPrefixLength);
+
+	/**
+	 * @brief Retrieves the number of subnets in the range.
+	 *
+	 * @return uint64_t The number of subnets.
+	 */
+	uint64_t size() const
+	{
+		return _count;
+	}
+
+	/**
+	 * @brief Checks if the range contains no subnet.
+	 *
+	 * @return bool True if the range is empty, false otherwise.
+	 */
+	bool empty() const
+	{
+		return _count == 0;
+	}
+
+	/**
+	 * @brief Retrieves the prefix length of the subnets of the range.
+	 *
+	 * @return int The prefix length of the subnets.
+	 */
+	int getPrefixLength() const
+	{
+		return _prefixLength;
+	}
+
+	/**
+	 * @brief Retrieves an iterator to the first subnet of the range.
+	 *
+	 * @return iterator An iterator to the first subnet.
+	 */
+	iterator begin() const
+	{
+		return iterator(_base, _prefixLength, 0);
+	}
+
+	/**
+	 * @brief Retrieves an iterator past the last subnet of the range.
+	 *
+	 * @return iterator An iterator past the last subnet.
+	 */
+	iterator end() const
+	{
+		return iterator(_base, _prefixLength, _count);
+	}
+
+	/**
+	 * @brief Computes the subnet at the given index.
+	 *
+	 * @param index The index of the subnet.
+	 * @return Subnet<Traits> The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	inline Subnet<Traits> operator [](uint64_t index) const;
+
+	/**
+	 * @brief Restricts the range to a page of its subnets.
+	 *
+	 * @param offset The index of the first subnet of the page.
+	 * @param limit The maximum number of subnets of the page.
+	 * @return SubnetRange The range of the subnets with an index in [offset, offset + limit), empty if the offset is past the end.
+	 */
+	inline SubnetRange slice(uint64_t offset, uint64_t limit) const;
+
+	/**
+	 * @brief Finds the index of the subnet of the range holding an address.
+	 *
+	 * @param ip The value of the address.
+	 * @param index The index of the subnet, only set if the address is in the range.
+	 * @return bool True if a subnet of the range holds the address, false otherwise.
+	 */
+	inline bool find(const value_type& ip, uint64_t& index) const;
+};
+
+/**
+ * @brief Creates the range of all the subnets of a network with a longer prefix length.
+ *
+ * @param network The network address of the network to split.
+ * @param prefixLength The prefix length of the network to split.
+ * @param newPrefixLength The prefix length of the subnets.
+ * @return SubnetRange The range of the 2^(newPrefixLength - prefixLength) subnets.
+ * @throws std::invalid_argument If the new prefix length is shorter than the prefix length
+ *         or longer than the address, or if the subnets cannot be counted on 64 bits.
+ */
+template <typename Traits>
+SubnetRange<Traits> SubnetRange<Traits>::split(const value_type& network, int prefixLength, int newPrefixLength)
+{
+	// Check if the new prefix length is valid
+	if (newPrefixLength < prefixLength || newPrefixLength > Traits::ADDRESS_BITS)
+	{
+		throw invalid_argument("New prefix length must be between " + to_string(prefixLength) + " and " + to_string(Traits::ADDRESS_BITS) + ".");
+	}
+
+	// Check if the number of subnets can be counted
+	if (newPrefixLength - prefixLength >= 64)
+	{
+		throw invalid_argument("Number of subnets is too large to be enumerated.");
+	}
+
+	return SubnetRange(network, newPrefixLength, 1ULL << (newPrefixLength - prefixLength));
+}
+
+/**
+ * @brief Computes the subnet at the given index.
+ *
+ * @param index The index of the subnet.
+ * @return Subnet<Traits> The subnet at the given index.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename Traits>
+Subnet<Traits> SubnetRange<Traits>::operator [](uint64_t index) const
+{
+	// Check if the index is out of range
+	if (index >= _count)
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(_count - 1) + ".");
+	}
+
+	// Return the subnet at the specified index
+	return begin()[(int64_t)index];
+}
+
+/**
+ * @brief Restricts the range to a page of its subnets.
+ *
+ * The page is a range of its own, starting at the subnet at the offset, so it
+ * is computed in constant time and its subnets are computed from their index
+ * like those of any range, whatever the size of the whole range.
+ *
+ * @param offset The index of the first subnet of the page.
+ * @param limit The maximum number of subnets of the page.
+ * @return SubnetRange The range of the subnets with an index in [offset, offset + limit), empty if the offset is past the end.
+ */
+template <typename Traits>
+SubnetRange<Traits> SubnetRange<Traits>::slice(uint64_t offset, uint64_t limit) const
+{
+	// An offset past the end gives an empty page at the end of the range
+	offset = min(offset, _count);
+
+	return SubnetRange(_base + Traits::subnetOffset(offset, _prefixLength), _prefixLength, min(limit, _count - offset));
+}
+
+/**
+ * @brief Finds the index of the subnet of the range holding an address.
+ *
+ * The index is the distance from the first subnet to the address divided by
+ * the size of a subnet, computed with a shift on 128 bits, so the lookup runs
+ * in constant time.
+ *
+ * @param ip The value of the address.
+ * @param index The index of the subnet, only set if the address is in the range.
+ * @return bool True if a subnet of the range holds the address, false otherwise.
+ */
+template <typename Traits>
+bool SubnetRange<Traits>::find(const value_type& ip, uint64_t& index) const
+{
+	// Check if the address is before the first subnet
+	if (ip < _base)
+	{
+		return false;
+	}
+
+	UInt128 offset = UInt128(ip - _base) >> (Traits::ADDRESS_BITS - _prefixLength);
+
+	// Check if the address is after the last subnet
+	if (offset >= UInt128(_count))
+	{
+		return false;
+	}
+
+	index = offset.getLow();
+
+	return true;
+}
+
+#endif // SUBNET_RANGE_H
\ No newline at end of file
@@ -0,0 +1,218 @@
+#ifndef SUBNET_TABLE_H
+#define SUBNET_TABLE_H
+
+#include "network/subnet_range.h"
+#include "utils/parallel.h"
+#include <algorithm>
+
+/**
+ * @class SubnetTable
+ * @brief Stores a materialized set of subnets sharing the same prefix length.
+ *
+ * The network addresses of the subnets are kept in a single contiguous array of
+ * raw values, and the first host, last host and broadcast addresses are derived
+ * from the shared prefix length when a subnet is accessed. Building a table from
+ * a range takes one allocation, and scanning, sorting or exporting it walks
+ * memory sequentially.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class SubnetTable
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+	/**
+	 * @brief Iterator over the network addresses of the table.
+	 */
+	typedef typename vector<value_type>::const_iterator const_iterator;
+
+private:
+	/**
+	 * @brief The network addresses of the subnets.
+	 */
+	vector<value_type> _ips;
+
+	/**
+	 * @brief The prefix length shared by all the subnets.
+	 */
+	int _prefixLength;
+
+public:
+	/**
+	 * @brief Constructs a table holding all the subnets of a range.
+	 *
+	 * The table is allocated once, then its partitions are filled in parallel.
+	 *
+	 * @param range The range of subnets to materialize.
+	 * @param threadCount The number of threads filling the table, 0 meaning one per hardware thread.
+	 */
+	explicit SubnetTable(const SubnetRange<Traits>& range, unsigned threadCount = 1)
+		: _ips((size_t)range.size()), _prefixLength(range.getPrefixLength())
+	{
+		// Fill each partition of the table with the network addresses of the range
+		parallelFor(_ips.size(), threadCount, [this, &range](size_t begin, size_t end)
+		{
+			typename SubnetRange<Traits>::iterator it = range.begin() + (int64_t)begin;
+
+			for (size_t i = begin; i < end; ++i, ++it)
+			{
+				_ips[i] = (*it).getValue();
+			}
+		});
+	}
+
+	/**
+	 * @brief Constructs a table from a list of addresses and a shared prefix length.
+	 *
+	 * The host bits of each address are cleared to obtain the network addresses.
+	 *
+	 * @param ips The addresses of the subnets.
+	 * @param prefixLength The prefix length of the subnets.
+	 */
+	SubnetTable(vector<value_type> ips, int prefixLength)
+		: _ips(std::move(ips)), _prefixLength(prefixLength)
+	{
+		// Clear the host bits of each address
+		value_type networkMask = ~Traits::hostMask(prefixLength);
+
+		for (value_type& ip : _ips)
+		{
+			ip = ip & networkMask;
+		}
+	}
+
+	/**
+	 * @brief Retrieves the number of subnets in the table.
+	 *
+	 * @return size_t The number of subnets.
+	 */
+	size_t size() const
+	{
+		return _ips.size();
+	}
+
+	/**
+	 * @brief Checks if the table contains no subnet.
+	 *
+	 * @return bool True if the table is empty, false otherwise.
+	 */
+	bool empty() const
+	{
+		return _ips.empty();
+	}
+
+	/**
+	 * @brief Retrieves the prefix length shared by the subnets.
+	 *
+	 * @return int The prefix length of the subnets.
+	 */
+	int getPrefixLength() const
+	{
+		return _prefixLength;
+	}
+
+	/**
+	 * @brief Retrieves the contiguous array of network addresses.
+	 *
+	 * @return const value_type* A pointer to the first network address.
+	 */
+	const value_type* data() const
+	{
+		return _ips.data();
+	}
+
+	/**
+	 * @brief Retrieves an iterator to the first network address.
+	 *
+	 * @return const_iterator An iterator to the first network address.
+	 */
+	const_iterator begin() const
+	{
+		return _ips.begin();
+	}
+
+	/**
+	 * @brief Retrieves an iterator past the last network address.
+	 *
+	 * @return const_iterator An iterator past the last network address.
+	 */
+	const_iterator end() const
+	{
+		return _ips.end();
+	}
+
+	/**
+	 * @brief Sorts the subnets by network address.
+	 */
+	void sort()
+	{
+		std::sort(_ips.begin(), _ips.end());
+	}
+
+	/**
+	 * @brief Finds the index of the subnet containing an address.
+	 *
+	 * The table must be sorted by network address.
+	 *
+	 * @param ip The value of the address to look up.
+	 * @return size_t The index of the subnet containing the address, or size() if there is none.
+	 */
+	inline size_t find(const value_type& ip) const;
+
+	/**
+	 * @brief Retrieves the subnet at the given index.
+	 *
+	 * @param index The index of the subnet.
+	 * @return Subnet<Traits> The subnet at the given index.
+	 * @throws std::out_of_range If the index is out of range.
+	 */
+	inline Subnet<Traits> operator [](size_t index) const;
+};
+
+/**
+ * @brief Finds the index of the subnet containing an address.
+ *
+ * This function clears the host bits of the address and searches for the
+ * resulting network address with a binary search over the sorted table.
+ *
+ * @param ip The value of the address to look up.
+ * @return size_t The index of the subnet containing the address, or size() if there is none.
+ */
+template <typename Traits>
+size_t SubnetTable<Traits>::find(const value_type& ip) const
+{
+	// Compute the network address the address would belong to
+	value_type network = ip & ~Traits::hostMask(_prefixLength);
+
+	// Search for the network address in the table
+	const_iterator it = lower_bound(_ips.begin(), _ips.end(), network);
+
+	return (it != _ips.end() && *it == network) ? (size_t)(it - _ips.begin()) : _ips.size();
+}
+
+/**
+ * @brief Retrieves the subnet at the given index.
+ *
+ * @param index The index of the subnet.
+ * @return Subnet<Traits> The subnet at the given index.
+ * @throws std::out_of_range If the index is out of range.
+ */
+template <typename Traits>
+Subnet<Traits> SubnetTable<Traits>::operator [](size_t index) const
+{
+	// Check if the index is out of range
+	if (index >= _ips.size())
+	{
+		throw out_of_range("Index out of range, must be between 0 and " + to_string(_ips.size() - 1) + ".");
+	}
+
+	// Return the subnet at the specified index
+	return Subnet<Traits>(_ips[index], _prefixLength);
+}
+
+#endif // SUBNET_TABLE_H
\ No newline at end of file
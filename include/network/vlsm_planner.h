@@ -0,0 +1,350 @@
+#ifndef VLSM_PLANNER_H
+#define VLSM_PLANNER_H
+
+#include "network/network.h"
+#include "network/subnet.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+/**
+ * @class VlsmPlanner
+ * @brief Allocates subnets of variable sizes inside a parent network.
+ *
+ * The planner is a buddy allocator over the address space of the parent
+ * network. It keeps one sorted free list per prefix length. A request takes the
+ * lowest free block of the smallest sufficient size, splitting a larger block in
+ * halves if needed. A released block is merged with its free buddy, repeatedly,
+ * so that the free space stays in the largest possible blocks. Allocating and
+ * releasing a block take O(log n) time for n blocks, and every allocation is
+ * aligned on its own size.
+ *
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ */
+template <typename Traits>
+class VlsmPlanner
+{
+public:
+	/**
+	 * @brief The integer type holding an address of the family.
+	 */
+	typedef typename Traits::value_type value_type;
+
+private:
+	/**
+	 * @brief The parent network.
+	 */
+	Subnet<Traits> _network;
+
+	/**
+	 * @brief The network addresses of the free blocks, indexed by prefix length.
+	 */
+	vector<set<value_type>> _free;
+
+	/**
+	 * @brief The prefix lengths of the allocated blocks, indexed by network address.
+	 */
+	map<value_type, int> _allocated;
+
+	/**
+	 * @brief Computes the address of the buddy of a block.
+	 *
+	 * @param ip The network address of the block.
+	 * @param prefixLength The prefix length of the block.
+	 * @return value_type The network address of the other half of the parent block.
+	 */
+	static value_type buddyOf(const value_type& ip, int prefixLength)
+	{
+		return ip ^ Traits::subnetOffset(1, prefixLength);
+	}
+
+	/**
+	 * @brief Checks if a prefix length is valid for the family.
+	 *
+	 * @param prefixLength The prefix length to check.
+	 * @return int The prefix length.
+	 * @throws std::invalid_argument If the prefix length is not valid for the family.
+	 */
+	static int checkPrefixLength(int prefixLength)
+	{
+		if (prefixLength < 0 || prefixLength > Traits::ADDRESS_BITS)
+		{
+			throw invalid_argument("Invalid prefix length: must be between 0 and " + to_string(Traits::ADDRESS_BITS) + ".");
+		}
+
+		return prefixLength;
+	}
+
+public:
+	/**
+	 * @brief Constructs a planner whose whole parent network is free.
+	 *
+	 * @param ip The address of the parent network, its host bits being ignored.
+	 * @param prefixLength The prefix length of the parent network.
+	 * @throws std::invalid_argument If the prefix length is not valid for the family.
+	 */
+	VlsmPlanner(const value_type& ip, int prefixLength)
+		: _network(ip, checkPrefixLength(prefixLength)), _free(Traits::ADDRESS_BITS + 1)
+	{
+		_free[prefixLength].insert(_network.getValue());
+	}
+
+	/**
+	 * @brief Constructs a planner whose whole parent network is free.
+	 *
+	 * @param network The parent network, of the family of the planner.
+	 */
+	explicit VlsmPlanner(const Network& network)
+		: VlsmPlanner(Traits::toValue(*network.getIp()), network.getPrefixLength()) {}
+
+	/**
+	 * @brief Retrieves the parent network.
+	 *
+	 * @return const Subnet<Traits>& The parent network.
+	 */
+	const Subnet<Traits>& getNetwork() const
+	{
+		return _network;
+	}
+
+	/**
+	 * @brief Retrieves the number of allocated subnets.
+	 *
+	 * @return size_t The number of allocated subnets.
+	 */
+	size_t getAllocatedCount() const
+	{
+		return _allocated.size();
+	}
+
+	/**
+	 * @brief Computes the prefix length of the smallest subnet holding a number of hosts.
+	 *
+	 * @param hosts The number of hosts, at least 1.
+	 * @return int The prefix length of the smallest subnet with as many hosts.
+	 * @throws std::invalid_argument If the number of hosts is 0 or cannot fit in any subnet.
+	 */
+	static inline int prefixLengthFor(uint64_t hosts);
+
+	/**
+	 * @brief Allocates the lowest free subnet of the given prefix length.
+	 *
+	 * @param prefixLength The prefix length of the subnet.
+	 * @return Subnet<Traits> The allocated subnet.
+	 * @throws std::invalid_argument If the prefix length is shorter than the parent or no block is free.
+	 */
+	inline Subnet<Traits> allocatePrefix(int prefixLength);
+
+	/**
+	 * @brief Allocates the lowest free subnet holding a number of hosts.
+	 *
+	 * @param hosts The number of hosts of the subnet, at least 1.
+	 * @return Subnet<Traits> The allocated subnet.
+	 * @throws std::invalid_argument If the number of hosts is invalid or no block is large enough.
+	 */
+	Subnet<Traits> allocate(uint64_t hosts)
+	{
+		return allocatePrefix(prefixLengthFor(hosts));
+	}
+
+	/**
+	 * @brief Releases an allocated subnet, merging it with its free buddies.
+	 *
+	 * @param subnet The subnet to release, as returned by an allocation.
+	 * @throws std::invalid_argument If the subnet is not allocated.
+	 */
+	inline void release(const Subnet<Traits>& subnet);
+
+	/**
+	 * @brief Allocates a subnet for each of a list of host requirements.
+	 *
+	 * The requirements are allocated from the largest to the smallest, which packs
+	 * them without gaps in the lowest addresses. If any requirement cannot be
+	 * allocated, the subnets already allocated by this call are released and the
+	 * planner is left unchanged.
+	 *
+	 * @param hosts The number of hosts of each subnet.
+	 * @return vector<Subnet<Traits>> The allocated subnets, in the order of the requirements.
+	 * @throws std::invalid_argument If a number of hosts is invalid or the requirements do not fit.
+	 */
+	inline vector<Subnet<Traits>> plan(const vector<uint64_t>& hosts);
+};
+
+/**
+ * @brief Computes the prefix length of the smallest subnet holding a number of hosts.
+ *
+ * The subnet must hold the hosts and the reserved addresses of the family, so
+ * its host part is the number of bits needed to count them.
+ *
+ * @param hosts The number of hosts, at least 1.
+ * @return int The prefix length of the smallest subnet with as many hosts.
+ * @throws std::invalid_argument If the number of hosts is 0 or cannot fit in any subnet.
+ */
+template <typename Traits>
+int VlsmPlanner<Traits>::prefixLengthFor(uint64_t hosts)
+{
+	// Check if the number of hosts is valid
+	if (hosts < 1)
+	{
+		throw invalid_argument("Number of hosts must be greater than 0.");
+	}
+
+	// Count the bits needed to number the hosts and the reserved addresses, 65 if they overflow 64 bits
+	uint64_t last = hosts + (Traits::RESERVED_ADDRESSES - 1);
+	int hostBits = (last < hosts) ? 65 : 64 - __builtin_clzll(last);
+
+	if (hostBits > Traits::ADDRESS_BITS)
+	{
+		throw invalid_argument("Number of hosts is too large for the address family.");
+	}
+
+	return Traits::ADDRESS_BITS - hostBits;
+}
+
+/**
+ * @brief Allocates the lowest free subnet of the given prefix length.
+ *
+ * This function looks for the smallest free block at least as large as the
+ * subnet, then splits it in halves, freeing the upper half each time, until
+ * the lower half has the requested size.
+ *
+ * @param prefixLength The prefix length of the subnet.
+ * @return Subnet<Traits> The allocated subnet.
+ * @throws std::invalid_argument If the prefix length is shorter than the parent or no block is free.
+ */
+template <typename Traits>
+Subnet<Traits> VlsmPlanner<Traits>::allocatePrefix(int prefixLength)
+{
+	// Check if the subnet fits in the parent network
+	if (prefixLength < _network.getPrefixLength() || prefixLength > Traits::ADDRESS_BITS)
+	{
+		throw invalid_argument("Subnet prefix length must be between " + to_string(_network.getPrefixLength()) + " and " + to_string(Traits::ADDRESS_BITS) + ".");
+	}
+
+	// Find the smallest free block large enough for the subnet
+	int blockLength = prefixLength;
+
+	while (blockLength >= _network.getPrefixLength() && _free[blockLength].empty())
+	{
+		--blockLength;
+	}
+
+	if (blockLength < _network.getPrefixLength())
+	{
+		throw invalid_argument("Not enough free address space for a /" + to_string(prefixLength) + " subnet.");
+	}
+
+	// Take the lowest free block of that size
+	value_type ip = *_free[blockLength].begin();
+	_free[blockLength].erase(_free[blockLength].begin());
+
+	// Split the block, freeing the upper halves
+	for (; blockLength < prefixLength; ++blockLength)
+	{
+		_free[blockLength + 1].insert(buddyOf(ip, blockLength + 1));
+	}
+
+	_allocated.emplace(ip, prefixLength);
+
+	return Subnet<Traits>(ip, prefixLength);
+}
+
+/**
+ * @brief Releases an allocated subnet, merging it with its free buddies.
+ *
+ * This function frees the block of the subnet, and as long as the buddy of the
+ * block is free, replaces both with the block they form together.
+ *
+ * @param subnet The subnet to release, as returned by an allocation.
+ * @throws std::invalid_argument If the subnet is not allocated.
+ */
+template <typename Traits>
+void VlsmPlanner<Traits>::release(const Subnet<Traits>& subnet)
+{
+	// Check if the subnet is allocated
+	auto it = _allocated.find(subnet.getValue());
+
+	if (it == _allocated.end() || it->second != subnet.getPrefixLength())
+	{
+		throw invalid_argument("Subnet is not allocated.");
+	}
+
+	_allocated.erase(it);
+
+	value_type ip = subnet.getValue();
+	int prefixLength = subnet.getPrefixLength();
+
+	// Merge the block with its buddy while the buddy is free
+	for (; prefixLength > _network.getPrefixLength(); --prefixLength)
+	{
+		auto buddy = _free[prefixLength].find(buddyOf(ip, prefixLength));
+
+		if (buddy == _free[prefixLength].end())
+		{
+			break;
+		}
+
+		_free[prefixLength].erase(buddy);
+		ip = ip & ~Traits::hostMask(prefixLength - 1);
+	}
+
+	_free[prefixLength].insert(ip);
+}
+
+/**
+ * @brief Allocates a subnet for each of a list of host requirements.
+ *
+ * This function sorts the requirements by decreasing size, allocates them in
+ * that order, and stores each subnet at the position of its requirement.
+ *
+ * @param hosts The number of hosts of each subnet.
+ * @return vector<Subnet<Traits>> The allocated subnets, in the order of the requirements.
+ * @throws std::invalid_argument If a number of hosts is invalid or the requirements do not fit.
+ */
+template <typename Traits>
+vector<Subnet<Traits>> VlsmPlanner<Traits>::plan(const vector<uint64_t>& hosts)
+{
+	// Compute the prefix length of each requirement
+	vector<int> prefixLengths(hosts.size());
+
+	for (size_t i = 0; i < hosts.size(); ++i)
+	{
+		prefixLengths[i] = prefixLengthFor(hosts[i]);
+	}
+
+	// Order the requirements from the largest to the smallest, keeping ties in order
+	vector<size_t> order(hosts.size());
+	iota(order.begin(), order.end(), (size_t)0);
+	stable_sort(order.begin(), order.end(), [&prefixLengths](size_t a, size_t b)
+	{
+		return prefixLengths[a] < prefixLengths[b];
+	});
+
+	vector<Subnet<Traits>> subnets(hosts.size(), _network);
+	size_t allocated = 0;
+
+	try
+	{
+		// Allocate the requirements in order
+		for (; allocated < order.size(); ++allocated)
+		{
+			subnets[order[allocated]] = allocatePrefix(prefixLengths[order[allocated]]);
+		}
+	}
+	catch (...)
+	{
+		// Release the subnets allocated so far
+		for (size_t i = 0; i < allocated; ++i)
+		{
+			release(subnets[order[i]]);
+		}
+
+		throw;
+	}
+
+	return subnets;
+}
+
+#endif // VLSM_PLANNER_H
@@ -0,0 +1,151 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "utils/stats.h"
+
+using namespace std;
+
+#define ARENA_BLOCK_SIZE 65536 ///< The default size of a block of an arena, in bytes.
+
+/**
+ * @class Arena
+ * @brief Monotonic allocator handing out memory from a few large blocks.
+ *
+ * An allocation only moves a cursor through the current block, and a new block
+ * is taken from the heap when the current one is full. The memory is never
+ * released piecewise: all the blocks are released at once when the arena is
+ * destroyed. The objects created in an arena must therefore be destroyed in
+ * place, by calling their destructor, and never deleted.
+ *
+ * An arena is not thread-safe. Threads filling a structure in parallel each use
+ * their own arena, and the arenas are then merged into one with adopt().
+ */
+class Arena
+{
+private:
+	/**
+	 * @brief The blocks of the arena, the last one being the current block.
+	 */
+	vector<unique_ptr<char[]>> _blocks;
+
+	/**
+	 * @brief The next free byte of the current block.
+	 */
+	char* _cursor;
+
+	/**
+	 * @brief The end of the current block.
+	 */
+	char* _end;
+
+	/**
+	 * @brief The minimum size of a new block.
+	 */
+	size_t _blockSize;
+
+	/**
+	 * @brief Takes a new block from the heap and makes it the current block.
+	 *
+	 * @param size The minimum size of the block.
+	 */
+	void addBlock(size_t size)
+	{
+		size = max(size, _blockSize);
+
+		STATS_COUNT(StatsCounter::Allocations, 1);
+
+		_blocks.emplace_back(new char[size]);
+		_cursor = _blocks.back().get();
+		_end = _cursor + size;
+	}
+
+public:
+	/**
+	 * @brief Constructs an empty arena.
+	 *
+	 * No memory is taken from the heap before the first allocation.
+	 *
+	 * @param blockSize The minimum size of a block, sized to hold the expected allocations in one block.
+	 */
+	explicit Arena(size_t blockSize = ARENA_BLOCK_SIZE)
+		: _cursor(nullptr), _end(nullptr), _blockSize(max(blockSize, (size_t)1)) {}
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/**
+	 * @brief Allocates memory from the arena.
+	 *
+	 * @param size The number of bytes to allocate.
+	 * @param alignment The alignment of the memory, a power of 2 not greater than alignof(max_align_t).
+	 * @return void* The allocated memory, valid until the arena is destroyed.
+	 * @throws std::bad_alloc If a new block cannot be allocated.
+	 */
+	void* allocate(size_t size, size_t alignment = alignof(max_align_t))
+	{
+		// Align the cursor, taking a new block if the memory does not fit in the current one,
+		// the padding alone possibly going past the end of a block whose size is not aligned
+		uintptr_t address = ((uintptr_t)_cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+		if (_cursor == nullptr || address > (uintptr_t)_end || size > (size_t)((uintptr_t)_end - address))
+		{
+			addBlock(size);
+			address = (uintptr_t)_cursor;
+		}
+
+		_cursor = (char*)address + size;
+
+		return (void*)address;
+	}
+
+	/**
+	 * @brief Creates an object in the arena.
+	 *
+	 * @tparam T The type of the object.
+	 * @tparam Arguments The types of the arguments of the constructor.
+	 * @param arguments The arguments of the constructor.
+	 * @return T* The object, to be destroyed in place before the arena is destroyed.
+	 */
+	template <typename T, typename... Arguments>
+	T* create(Arguments&&... arguments)
+	{
+		return new (allocate(sizeof(T), alignof(T))) T(forward<Arguments>(arguments)...);
+	}
+
+	/**
+	 * @brief Takes the blocks of another arena, which is left empty.
+	 *
+	 * The memory allocated from the other arena stays valid and is now released with this arena.
+	 *
+	 * @param other The arena whose blocks are taken.
+	 */
+	void adopt(Arena& other)
+	{
+		// Keep the current block last so that allocations can go on in it
+		_blocks.insert(_blocks.empty() ? _blocks.end() : _blocks.end() - 1,
+			make_move_iterator(other._blocks.begin()), make_move_iterator(other._blocks.end()));
+
+		other._blocks.clear();
+		other._cursor = nullptr;
+		other._end = nullptr;
+	}
+
+	/**
+	 * @brief Retrieves the number of blocks taken from the heap.
+	 *
+	 * @return size_t The number of blocks.
+	 */
+	size_t getBlockCount() const
+	{
+		return _blocks.size();
+	}
+};
+
+#endif // ARENA_H
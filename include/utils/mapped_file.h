@@ -0,0 +1,111 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+#define MAPPED_FILE_CHUNK_SIZE 1048576 ///< The default size of a chunk of lines, in bytes.
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file mapped in memory.
+ *
+ * The file is mapped with mmap on POSIX systems and with MapViewOfFile on
+ * Windows, and the system is told that it will be read sequentially, so that
+ * it reads ahead of the parser. Its contents are then parsed in place, without
+ * being copied into lines or strings. The view stays valid until the file is
+ * closed or the object is destroyed.
+ */
+class MappedFile
+{
+private:
+	/**
+	 * @brief The first byte of the mapping, or nullptr if no file or an empty file is mapped.
+	 */
+	const char* _data;
+
+	/**
+	 * @brief The size of the file, in bytes.
+	 */
+	size_t _size;
+
+#ifdef _WIN32
+	/**
+	 * @brief The handle of the file, kept open as long as it is mapped.
+	 */
+	void* _file;
+
+	/**
+	 * @brief The handle of the mapping of the file.
+	 */
+	void* _mapping;
+#endif
+
+public:
+	/**
+	 * @brief Constructs an object mapping no file.
+	 */
+	MappedFile();
+
+	/**
+	 * @brief Destructor for the MappedFile class, unmapping the file.
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * @brief Maps a file in memory, unmapping the previous one.
+	 *
+	 * @param path The path of the file.
+	 * @param sequential Whether the file is read sequentially, like a text to parse, or randomly, like an index.
+	 * @return bool True if the file is mapped, false if it cannot be opened or mapped.
+	 */
+	bool open(const string& path, bool sequential = true);
+
+	/**
+	 * @brief Unmaps the file, invalidating the view.
+	 */
+	void close();
+
+	/**
+	 * @brief Retrieves the contents of the file.
+	 *
+	 * @return string_view The contents of the file, empty if no file is mapped.
+	 */
+	string_view getView() const
+	{
+		return string_view(_data, _size);
+	}
+
+	/**
+	 * @brief Retrieves the size of the file.
+	 *
+	 * @return size_t The size of the file in bytes, 0 if no file is mapped.
+	 */
+	size_t getSize() const
+	{
+		return _size;
+	}
+};
+
+/**
+ * @brief Splits a text into chunks made of whole lines.
+ *
+ * Each chunk but the last one ends with a newline, so that the chunks can be
+ * parsed independently, by different threads, and hold every line exactly once.
+ * A chunk ends at the first newline after its first chunkSize bytes, so it is
+ * longer than chunkSize only by the end of its last line.
+ *
+ * @param text The text to split.
+ * @param chunkSize The minimum size of a chunk in bytes, except for the last one.
+ * @return vector<string_view> The chunks, in order, empty if the text is empty.
+ */
+vector<string_view> splitLines(string_view text, size_t chunkSize = MAPPED_FILE_CHUNK_SIZE);
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,124 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+using namespace std;
+
+#define PARALLEL_GRAIN_SIZE 4096 ///< The minimum number of items processed by a thread.
+
+/**
+ * @brief Resolves a requested number of threads.
+ *
+ * @param threadCount The requested number of threads, 0 meaning one thread per hardware thread.
+ * @return unsigned The number of threads to use, at least 1.
+ */
+inline unsigned resolveThreadCount(unsigned threadCount)
+{
+	// Use one thread per hardware thread if no number is given
+	if (threadCount == 0)
+	{
+		threadCount = thread::hardware_concurrency();
+	}
+
+	return max(threadCount, 1u);
+}
+
+/**
+ * @brief Processes a range of indices in parallel.
+ *
+ * This function splits the indices [0, count) into contiguous partitions of nearly
+ * equal size, one per thread, and calls the function on each partition as
+ * function(begin, end). Each index belongs to exactly one partition, so the function
+ * can write the results of its partition into preallocated output without any
+ * synchronization, and the results end up in index order. Partitions are never
+ * smaller than grainSize indices, and the calling thread processes the
+ * first partition itself, as well as the partitions whose thread could not be
+ * started, so that no started thread is left unjoined.
+ *
+ * @param count The number of indices to process.
+ * @param threadCount The number of threads to use, 0 meaning one thread per hardware thread.
+ * @param function The function called on each partition.
+ * @param grainSize The minimum number of indices of a partition, 1 for indices that are large tasks.
+ * @throws The first exception thrown by the function, once all the threads have finished.
+ */
+template <typename Function>
+void parallelFor(size_t count, unsigned threadCount, Function function, size_t grainSize = PARALLEL_GRAIN_SIZE)
+{
+	// Limit the number of threads so that each one has enough work
+	size_t partitions = min((size_t)resolveThreadCount(threadCount), max(count / max(grainSize, (size_t)1), (size_t)1));
+
+	// Process the indices on the calling thread if there is a single partition
+	if (partitions == 1)
+	{
+		function((size_t)0, count);
+		return;
+	}
+
+	vector<thread> threads;
+	vector<exception_ptr> errors(partitions);
+
+	// Calculate the bounds of a partition
+	auto bound = [count, partitions](size_t partition)
+	{
+		return (size_t)((unsigned long long)count * partition / partitions);
+	};
+
+	// Process a partition, storing its error if any
+	auto process = [&](size_t partition)
+	{
+		try
+		{
+			function(bound(partition), bound(partition + 1));
+		}
+		catch (...)
+		{
+			errors[partition] = current_exception();
+		}
+	};
+
+	// Start a thread for each partition but the first one, as long as threads can be started
+	size_t started = 1;
+
+	try
+	{
+		threads.reserve(partitions - 1);
+
+		for (; started < partitions; ++started)
+		{
+			threads.emplace_back(process, started);
+		}
+	}
+	catch (...)
+	{
+		// Leave the partitions without a thread to the calling thread
+	}
+
+	// Process the first partition and the partitions without a thread on the calling thread
+	process(0);
+
+	for (size_t partition = started; partition < partitions; ++partition)
+	{
+		process(partition);
+	}
+
+	// Wait for all the threads to finish
+	for (thread& t : threads)
+	{
+		t.join();
+	}
+
+	// Rethrow the first error
+	for (const exception_ptr& error : errors)
+	{
+		if (error)
+		{
+			rethrow_exception(error);
+		}
+	}
+}
+
+#endif // PARALLEL_H
\ No newline at end of file
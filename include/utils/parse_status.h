@@ -0,0 +1,30 @@
+#ifndef PARSE_STATUS_H
+#define PARSE_STATUS_H
+
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @enum ParseStatus
+ * @brief Result of parsing the text representation of an address, or of creating a mask or a network.
+ */
+enum class ParseStatus
+{
+	Success, ///< The text is a valid address.
+	InvalidPartCount, ///< The text does not have the number of parts of an address.
+	InvalidPart, ///< A part of the text is empty or contains an invalid character.
+	PartOutOfRange, ///< A part of the text exceeds the maximum value of a part.
+	InvalidPrefixLength ///< The prefix length is not compatible with the mask or the address.
+};
+
+/**
+ * @brief Retrieves the message of an error of an address of a family.
+ * 
+ * @param status The error, as returned by the parsers or by the creation of a mask or a network.
+ * @param addressSize The number of octets of the addresses of the family, 4 for IPv4 and 16 for IPv6.
+ * @return const char* The message, the one the throwing constructors report, empty for ParseStatus::Success.
+ */
+const char* getParseStatusMessage(ParseStatus status, size_t addressSize);
+
+#endif // PARSE_STATUS_H
@@ -0,0 +1,241 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+#define STATS_PHASE_COUNT 5 ///< The number of timed phases.
+#define STATS_COUNTER_COUNT 3 ///< The number of counters.
+
+/**
+ * @enum StatsPhase
+ * @brief Phase of a run whose calls are timed.
+ */
+enum class StatsPhase
+{
+	Parse, ///< Parsing of an address.
+	Mask, ///< Construction of the mask of a network.
+	Network, ///< Construction of a network.
+	Segment, ///< Segmentation of a network into its subnets.
+	Print ///< Writing of subnets.
+};
+
+/**
+ * @enum StatsCounter
+ * @brief Quantity counted over a run.
+ */
+enum class StatsCounter
+{
+	Allocations, ///< Heap allocations of addresses and arena blocks.
+	Subnets, ///< Subnets computed by segmentations.
+	BytesWritten ///< Bytes written to the output streams by the output buffers.
+};
+
+/**
+ * @class Stats
+ * @brief Process-wide timings and counters of the hot paths, reported by --stats.
+ *
+ * The instrumentation is disabled until enable() is called, and then costs a
+ * relaxed atomic load and a branch per instrumented call. The timings and the
+ * counters are atomic so that the threads of a segmentation update them
+ * concurrently, and the time of a phase is summed over the threads, so it can
+ * exceed the wall time of a parallel run. The time of a phase includes the
+ * phases it calls, such as the construction of the subnets of a segmentation.
+ *
+ * Building with NO_STATS defined compiles the instrumentation out entirely:
+ * the STATS_TIMER and STATS_COUNT macros then expand to nothing.
+ */
+class Stats
+{
+private:
+	/**
+	 * @brief Whether the instrumentation is enabled.
+	 */
+	inline static atomic<bool> _enabled{ false };
+
+	/**
+	 * @brief The number of timed calls of each phase.
+	 */
+	inline static atomic<uint64_t> _calls[STATS_PHASE_COUNT]{};
+
+	/**
+	 * @brief The time spent in each phase, in nanoseconds.
+	 */
+	inline static atomic<uint64_t> _nanoseconds[STATS_PHASE_COUNT]{};
+
+	/**
+	 * @brief The value of each counter.
+	 */
+	inline static atomic<uint64_t> _counters[STATS_COUNTER_COUNT]{};
+
+	/**
+	 * @brief The time at which the instrumentation was enabled.
+	 */
+	inline static chrono::steady_clock::time_point _start;
+
+public:
+	/**
+	 * @brief Resets the timings and the counters, then enables the instrumentation.
+	 */
+	static void enable();
+
+	/**
+	 * @brief Disables the instrumentation, keeping the timings and the counters.
+	 */
+	static void disable()
+	{
+		_enabled.store(false, memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Checks if the instrumentation is enabled.
+	 *
+	 * @return bool True if the calls are timed and counted, false otherwise.
+	 */
+	static bool isEnabled()
+	{
+		return _enabled.load(memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Adds a timed call to a phase.
+	 *
+	 * @param phase The phase of the call.
+	 * @param nanoseconds The duration of the call, in nanoseconds.
+	 */
+	static void addCall(StatsPhase phase, uint64_t nanoseconds)
+	{
+		_calls[(int)phase].fetch_add(1, memory_order_relaxed);
+		_nanoseconds[(int)phase].fetch_add(nanoseconds, memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Adds to a counter if the instrumentation is enabled.
+	 *
+	 * @param counter The counter.
+	 * @param value The value to add.
+	 */
+	static void count(StatsCounter counter, uint64_t value)
+	{
+		if (isEnabled())
+		{
+			_counters[(int)counter].fetch_add(value, memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Retrieves the number of timed calls of a phase.
+	 *
+	 * @param phase The phase.
+	 * @return uint64_t The number of calls.
+	 */
+	static uint64_t getCalls(StatsPhase phase)
+	{
+		return _calls[(int)phase].load(memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Retrieves the time spent in a phase.
+	 *
+	 * @param phase The phase.
+	 * @return uint64_t The time, in nanoseconds, summed over the threads.
+	 */
+	static uint64_t getNanoseconds(StatsPhase phase)
+	{
+		return _nanoseconds[(int)phase].load(memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Retrieves the value of a counter.
+	 *
+	 * @param counter The counter.
+	 * @return uint64_t The value.
+	 */
+	static uint64_t getCount(StatsCounter counter)
+	{
+		return _counters[(int)counter].load(memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Retrieves the peak resident set size of the process.
+	 *
+	 * @return uint64_t The peak resident set size in bytes, 0 if it is not known.
+	 */
+	static uint64_t getPeakResidentSize();
+
+	/**
+	 * @brief Writes the per-phase breakdown, the counters, the wall time since enable() and the peak resident set size.
+	 *
+	 * @param s The output stream to which the report is written.
+	 * @return ostream& A reference to the output stream.
+	 */
+	static ostream& report(ostream& s);
+};
+
+/**
+ * @class StatsTimer
+ * @brief Times the scope it lives in as a call of a phase.
+ *
+ * The clock is only read if the instrumentation is enabled when the timer is constructed.
+ */
+class StatsTimer
+{
+private:
+	/**
+	 * @brief The phase of the timed call.
+	 */
+	StatsPhase _phase;
+
+	/**
+	 * @brief Whether the call is timed.
+	 */
+	bool _enabled;
+
+	/**
+	 * @brief The time at which the call started.
+	 */
+	chrono::steady_clock::time_point _start;
+
+public:
+	/**
+	 * @brief Starts timing a call of a phase.
+	 *
+	 * @param phase The phase of the call.
+	 */
+	explicit StatsTimer(StatsPhase phase)
+		: _phase(phase), _enabled(Stats::isEnabled())
+	{
+		if (_enabled)
+		{
+			_start = chrono::steady_clock::now();
+		}
+	}
+
+	/**
+	 * @brief Stops timing the call and adds it to its phase.
+	 */
+	~StatsTimer()
+	{
+		if (_enabled)
+		{
+			Stats::addCall(_phase, (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - _start).count());
+		}
+	}
+
+	StatsTimer(const StatsTimer&) = delete;
+	StatsTimer& operator =(const StatsTimer&) = delete;
+};
+
+#ifdef NO_STATS
+#define STATS_TIMER(phase) ((void)0) ///< Times the enclosing scope as a call of a phase, compiled out.
+#define STATS_COUNT(counter, value) ((void)0) ///< Adds to a counter, compiled out.
+#else
+#define STATS_TIMER(phase) StatsTimer statsTimer_(phase) ///< Times the enclosing scope as a call of a phase.
+#define STATS_COUNT(counter, value) Stats::count(counter, value) ///< Adds to a counter.
+#endif
+
+#endif // STATS_H
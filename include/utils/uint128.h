@@ -0,0 +1,303 @@
+#ifndef UINT128_H
+#define UINT128_H
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @class UInt128
+ * @brief Represents an unsigned 128-bit integer.
+ *
+ * The value is stored as two 64-bit words and behaves like a built-in unsigned
+ * integer: arithmetic wraps modulo 2^128 and shifts by 128 bits or more yield zero.
+ * The class is trivially copyable and does not allocate, so it can be stored
+ * densely in arrays.
+ */
+class UInt128
+{
+private:
+	/**
+	 * @brief The most significant 64 bits of the value.
+	 */
+	uint64_t _high;
+
+	/**
+	 * @brief The least significant 64 bits of the value.
+	 */
+	uint64_t _low;
+
+public:
+	/**
+	 * @brief Constructs a UInt128 object from a 64-bit value.
+	 *
+	 * @param low The value of the least significant 64 bits. Defaults to 0.
+	 */
+	constexpr UInt128(uint64_t low = 0)
+		: _high(0), _low(low) {}
+
+	/**
+	 * @brief Constructs a UInt128 object from its two 64-bit halves.
+	 *
+	 * @param high The value of the most significant 64 bits.
+	 * @param low The value of the least significant 64 bits.
+	 */
+	constexpr UInt128(uint64_t high, uint64_t low)
+		: _high(high), _low(low) {}
+
+	/**
+	 * @brief Retrieves the most significant 64 bits of the value.
+	 *
+	 * @return uint64_t The most significant 64 bits.
+	 */
+	constexpr uint64_t getHigh() const
+	{
+		return _high;
+	}
+
+	/**
+	 * @brief Retrieves the least significant 64 bits of the value.
+	 *
+	 * @return uint64_t The least significant 64 bits.
+	 */
+	constexpr uint64_t getLow() const
+	{
+		return _low;
+	}
+
+	/**
+	 * @brief Creates a value with the given number of least significant bits set.
+	 *
+	 * @param bits The number of bits to set, between 0 and 128.
+	 * @return UInt128 A value whose lowest bits are set to one.
+	 */
+	static constexpr UInt128 lowBits(int bits)
+	{
+		return (bits >= 128) ? UInt128(~0ULL, ~0ULL)
+			: (bits >= 64) ? UInt128((bits == 64) ? 0 : (~0ULL >> (128 - bits)), ~0ULL)
+			: UInt128(0, (bits <= 0) ? 0 : (~0ULL >> (64 - bits)));
+	}
+
+	/**
+	 * @brief Counts the leading zero bits of the value.
+	 *
+	 * @return int The number of zero bits above the most significant set bit, 128 for zero.
+	 */
+	constexpr int countLeadingZeros() const
+	{
+		return (_high != 0) ? __builtin_clzll(_high)
+			: (_low != 0) ? 64 + __builtin_clzll(_low)
+			: 128;
+	}
+
+	/**
+	 * @brief Adds two values, wrapping modulo 2^128.
+	 */
+	friend constexpr UInt128 operator +(const UInt128& a, const UInt128& b)
+	{
+		return UInt128(a._high + b._high + ((a._low + b._low) < a._low ? 1 : 0), a._low + b._low);
+	}
+
+	/**
+	 * @brief Subtracts two values, wrapping modulo 2^128.
+	 */
+	friend constexpr UInt128 operator -(const UInt128& a, const UInt128& b)
+	{
+		return UInt128(a._high - b._high - (a._low < b._low ? 1 : 0), a._low - b._low);
+	}
+
+	/**
+	 * @brief Computes the bitwise AND of two values.
+	 */
+	friend constexpr UInt128 operator &(const UInt128& a, const UInt128& b)
+	{
+		return UInt128(a._high & b._high, a._low & b._low);
+	}
+
+	/**
+	 * @brief Computes the bitwise OR of two values.
+	 */
+	friend constexpr UInt128 operator |(const UInt128& a, const UInt128& b)
+	{
+		return UInt128(a._high | b._high, a._low | b._low);
+	}
+
+	/**
+	 * @brief Computes the bitwise XOR of two values.
+	 */
+	friend constexpr UInt128 operator ^(const UInt128& a, const UInt128& b)
+	{
+		return UInt128(a._high ^ b._high, a._low ^ b._low);
+	}
+
+	/**
+	 * @brief Computes the bitwise complement of the value.
+	 */
+	constexpr UInt128 operator ~() const
+	{
+		return UInt128(~_high, ~_low);
+	}
+
+	/**
+	 * @brief Shifts the value to the left by the given number of bits.
+	 *
+	 * @param shift The number of bits to shift by. Shifts of 128 bits or more yield zero.
+	 */
+	constexpr UInt128 operator <<(int shift) const
+	{
+		return (shift <= 0) ? *this
+			: (shift >= 128) ? UInt128(0, 0)
+			: (shift >= 64) ? UInt128(_low << (shift - 64), 0)
+			: UInt128((_high << shift) | (_low >> (64 - shift)), _low << shift);
+	}
+
+	/**
+	 * @brief Shifts the value to the right by the given number of bits.
+	 *
+	 * @param shift The number of bits to shift by. Shifts of 128 bits or more yield zero.
+	 */
+	constexpr UInt128 operator >>(int shift) const
+	{
+		return (shift <= 0) ? *this
+			: (shift >= 128) ? UInt128(0, 0)
+			: (shift >= 64) ? UInt128(0, _high >> (shift - 64))
+			: UInt128(_high >> shift, (_low >> shift) | (_high << (64 - shift)));
+	}
+
+	/**
+	 * @brief Adds the given value to this value.
+	 */
+	UInt128& operator +=(const UInt128& other)
+	{
+		return *this = *this + other;
+	}
+
+	/**
+	 * @brief Subtracts the given value from this value.
+	 */
+	UInt128& operator -=(const UInt128& other)
+	{
+		return *this = *this - other;
+	}
+
+	/**
+	 * @brief Applies a bitwise AND with the given value.
+	 */
+	UInt128& operator &=(const UInt128& other)
+	{
+		return *this = *this & other;
+	}
+
+	/**
+	 * @brief Applies a bitwise OR with the given value.
+	 */
+	UInt128& operator |=(const UInt128& other)
+	{
+		return *this = *this | other;
+	}
+
+	/**
+	 * @brief Applies a bitwise XOR with the given value.
+	 */
+	UInt128& operator ^=(const UInt128& other)
+	{
+		return *this = *this ^ other;
+	}
+
+	/**
+	 * @brief Shifts this value to the left by the given number of bits.
+	 */
+	UInt128& operator <<=(int shift)
+	{
+		return *this = *this << shift;
+	}
+
+	/**
+	 * @brief Shifts this value to the right by the given number of bits.
+	 */
+	UInt128& operator >>=(int shift)
+	{
+		return *this = *this >> shift;
+	}
+
+	/**
+	 * @brief Increments this value by one, wrapping modulo 2^128.
+	 */
+	UInt128& operator ++()
+	{
+		return *this += 1;
+	}
+
+	/**
+	 * @brief Decrements this value by one, wrapping modulo 2^128.
+	 */
+	UInt128& operator --()
+	{
+		return *this -= 1;
+	}
+
+	/**
+	 * @brief Checks whether two values are equal.
+	 */
+	friend constexpr bool operator ==(const UInt128& a, const UInt128& b)
+	{
+		return a._high == b._high && a._low == b._low;
+	}
+
+	/**
+	 * @brief Checks whether two values differ.
+	 */
+	friend constexpr bool operator !=(const UInt128& a, const UInt128& b)
+	{
+		return !(a == b);
+	}
+
+	/**
+	 * @brief Checks whether the first value is less than the second.
+	 */
+	friend constexpr bool operator <(const UInt128& a, const UInt128& b)
+	{
+		return a._high < b._high || (a._high == b._high && a._low < b._low);
+	}
+
+	/**
+	 * @brief Checks whether the first value is greater than the second.
+	 */
+	friend constexpr bool operator >(const UInt128& a, const UInt128& b)
+	{
+		return b < a;
+	}
+
+	/**
+	 * @brief Checks whether the first value is less than or equal to the second.
+	 */
+	friend constexpr bool operator <=(const UInt128& a, const UInt128& b)
+	{
+		return !(b < a);
+	}
+
+	/**
+	 * @brief Checks whether the first value is greater than or equal to the second.
+	 */
+	friend constexpr bool operator >=(const UInt128& a, const UInt128& b)
+	{
+		return !(a < b);
+	}
+};
+
+/**
+ * @brief Computes the base 2 logarithm of an integer, rounded up.
+ *
+ * The logarithm is computed exactly from the count of leading zero bits, so
+ * that, unlike ceil(log2(value)) in floating point, it is exact for every
+ * 64-bit value.
+ *
+ * @param value The integer, at least 1.
+ * @return int The smallest number of bits b such that value <= 2^b.
+ */
+constexpr int ceilLog2(uint64_t value)
+{
+	return (value <= 1) ? 0 : 64 - __builtin_clzll(value - 1);
+}
+
+#endif // UINT128_H
\ No newline at end of file
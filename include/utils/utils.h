@@ -18,4 +18,16 @@ using namespace std;
  */
 vector<string> split(const string& s, const string& delimiter);
 
+/**
+ * @brief Throws the error of an index out of the range of a container.
+ * 
+ * The bounds-checked accessors call this function on their failure path, so that
+ * building the message of the error stays out of line, away from the accessors
+ * inlined in the loops of their callers.
+ * 
+ * @param size The number of elements of the container.
+ * @throws std::out_of_range Always.
+ */
+[[noreturn]] void throwIndexOutOfRange(size_t size);
+
 #endif // UTILS_H
\ No newline at end of file
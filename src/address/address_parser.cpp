@@ -0,0 +1,329 @@
+#include "address/address_parser.h"
+
+#define IPV4_PARTS 4 ///< The number of parts in an IPv4 address.
+#define IPV6_PARTS 8 ///< The number of parts in an IPv6 address.
+
+/**
+ * @brief Converts a hexadecimal digit to its value.
+ *
+ * @param c The character to convert.
+ * @return int The value of the digit, or -1 if the character is not a hexadecimal digit.
+ */
+static inline int hexDigitValue(char c)
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+
+	if (c >= 'a' && c <= 'f')
+	{
+		return c - 'a' + 10;
+	}
+
+	if (c >= 'A' && c <= 'F')
+	{
+		return c - 'A' + 10;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Parses the dotted-decimal representation of an IPv4 address.
+ *
+ * This function reads the parts of the address one character at a time, accumulating
+ * the value of each part and validating it as soon as its terminating period or the
+ * end of the text is reached. The first part error is remembered while the remaining
+ * parts are counted, so that an invalid number of parts is reported first.
+ *
+ * @param text The text to parse.
+ * @param value The value of the address, only set if the text is valid.
+ * @return ParseStatus ParseStatus::Success if the text is a valid IPv4 address, the error otherwise.
+ */
+ParseStatus parseIPv4(string_view text, uint32_t& value)
+{
+	const char* it = text.data();
+	const char* end = it + text.size();
+
+	// Initialize the result and the number of parts
+	uint32_t result = 0;
+	size_t parts = 0;
+	ParseStatus error = ParseStatus::Success;
+
+	while (true)
+	{
+		const char* start = it;
+		uint32_t part = 0;
+		bool digitsOnly = true;
+
+		// Accumulate the digits of the part, saturating past the maximum value
+		for (; it != end && *it != '.'; ++it)
+		{
+			unsigned digit = (unsigned)(*it - '0');
+
+			if (digit > 9)
+			{
+				digitsOnly = false;
+			}
+			else if (part <= 255)
+			{
+				part = part * 10 + digit;
+			}
+		}
+
+		// Remember the error of the first invalid part
+		if (error == ParseStatus::Success)
+		{
+			if (it == start || !digitsOnly)
+			{
+				error = ParseStatus::InvalidPart;
+			}
+			else if (part > 255)
+			{
+				error = ParseStatus::PartOutOfRange;
+			}
+		}
+
+		// Append the part to the result
+		result = (result << 8) | (part & 0xFF);
+		++parts;
+
+		// Stop at the end of the text, otherwise skip the period
+		if (it == end)
+		{
+			break;
+		}
+
+		++it;
+	}
+
+	// Check if the address has the correct number of parts
+	if (parts != IPV4_PARTS)
+	{
+		return ParseStatus::InvalidPartCount;
+	}
+
+	if (error != ParseStatus::Success)
+	{
+		return error;
+	}
+
+	value = result;
+
+	return ParseStatus::Success;
+}
+
+/**
+ * @brief Parses a sequence of hextets separated by colons.
+ *
+ * An empty text contains no hextet. Only the first IPV6_PARTS hextets are stored,
+ * but all of them are counted, and the error of the first invalid hextet is stored
+ * in the given status if no error was stored yet.
+ *
+ * @param it The beginning of the text.
+ * @param end The end of the text.
+ * @param hextets The array receiving the values of the hextets.
+ * @param error The error of the first invalid hextet.
+ * @return size_t The number of hextets in the text.
+ */
+static size_t parseHextets(const char* it, const char* end, uint16_t* hextets, ParseStatus& error)
+{
+	// An empty text contains no hextet
+	if (it == end)
+	{
+		return 0;
+	}
+
+	size_t count = 0;
+
+	while (true)
+	{
+		const char* start = it;
+		uint32_t hextet = 0;
+		bool digitsOnly = true;
+
+		// Accumulate the digits of the hextet, saturating past the maximum value
+		for (; it != end && *it != ':'; ++it)
+		{
+			int digit = hexDigitValue(*it);
+
+			if (digit < 0)
+			{
+				digitsOnly = false;
+			}
+			else if (hextet <= 0xFFFF)
+			{
+				hextet = (hextet << 4) | (uint32_t)digit;
+			}
+		}
+
+		// Remember the error of the first invalid hextet
+		if (error == ParseStatus::Success)
+		{
+			if (it == start || !digitsOnly)
+			{
+				error = ParseStatus::InvalidPart;
+			}
+			else if (hextet > 0xFFFF)
+			{
+				error = ParseStatus::PartOutOfRange;
+			}
+		}
+
+		// Store the hextet if there is room for it
+		if (count < IPV6_PARTS)
+		{
+			hextets[count] = (uint16_t)hextet;
+		}
+
+		++count;
+
+		// Stop at the end of the text, otherwise skip the colon
+		if (it == end)
+		{
+			return count;
+		}
+
+		++it;
+	}
+}
+
+/**
+ * @brief Parses the colon-hexadecimal representation of an IPv6 address.
+ *
+ * This function locates the "::" compression, parses the hextets on each side of it,
+ * and fills the gap between them with zero hextets. Without compression, the text
+ * must contain exactly eight hextets.
+ *
+ * @param text The text to parse.
+ * @param value The value of the address, only set if the text is valid.
+ * @return ParseStatus ParseStatus::Success if the text is a valid IPv6 address, the error otherwise.
+ */
+ParseStatus parseIPv6(string_view text, UInt128& value)
+{
+	const char* begin = text.data();
+	const char* end = begin + text.size();
+
+	uint16_t left[IPV6_PARTS];
+	uint16_t right[IPV6_PARTS];
+	size_t leftCount = 0;
+	size_t rightCount = 0;
+	ParseStatus error = ParseStatus::Success;
+
+	// Find the "::" compression
+	size_t compression = text.find("::");
+
+	if (compression == string_view::npos)
+	{
+		// Parse all the hextets of the address
+		leftCount = parseHextets(begin, end, left, error);
+
+		// Check if the address has the correct number of hextets
+		if (leftCount != IPV6_PARTS)
+		{
+			return ParseStatus::InvalidPartCount;
+		}
+	}
+	else
+	{
+		// Only one compression is allowed
+		if (text.find("::", compression + 2) != string_view::npos)
+		{
+			return ParseStatus::InvalidPartCount;
+		}
+
+		// Parse the hextets before and after the compression
+		leftCount = parseHextets(begin, begin + compression, left, error);
+		rightCount = parseHextets(begin + compression + 2, end, right, error);
+
+		// Check if the explicit hextets fit in the address
+		if (leftCount + rightCount > IPV6_PARTS)
+		{
+			return ParseStatus::InvalidPartCount;
+		}
+	}
+
+	if (error != ParseStatus::Success)
+	{
+		return error;
+	}
+
+	// Combine the left hextets, the zero hextets, then the right hextets
+	uint64_t words[2] = { 0, 0 };
+
+	for (size_t i = 0; i < leftCount; ++i)
+	{
+		words[i / 4] |= (uint64_t)left[i] << ((3 - i % 4) * 16);
+	}
+
+	for (size_t i = 0; i < rightCount; ++i)
+	{
+		size_t j = IPV6_PARTS - rightCount + i;
+		words[j / 4] |= (uint64_t)right[i] << ((3 - j % 4) * 16);
+	}
+
+	value = UInt128(words[0], words[1]);
+
+	return ParseStatus::Success;
+}
+
+/**
+ * @brief Parses a batch of IPv4 addresses.
+ *
+ * @param texts The texts to parse.
+ * @param count The number of texts.
+ * @param values The values of the addresses, zero for an invalid text.
+ * @param statuses The result of parsing each text, or nullptr if it is not needed.
+ * @return size_t The number of valid addresses.
+ */
+size_t parseIPv4Batch(const string_view* texts, size_t count, uint32_t* values, ParseStatus* statuses)
+{
+	size_t valid = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t value = 0;
+		ParseStatus status = parseIPv4(texts[i], value);
+
+		values[i] = value;
+		valid += (status == ParseStatus::Success);
+
+		if (statuses != nullptr)
+		{
+			statuses[i] = status;
+		}
+	}
+
+	return valid;
+}
+
+/**
+ * @brief Parses a batch of IPv6 addresses.
+ *
+ * @param texts The texts to parse.
+ * @param count The number of texts.
+ * @param values The values of the addresses, zero for an invalid text.
+ * @param statuses The result of parsing each text, or nullptr if it is not needed.
+ * @return size_t The number of valid addresses.
+ */
+size_t parseIPv6Batch(const string_view* texts, size_t count, UInt128* values, ParseStatus* statuses)
+{
+	size_t valid = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		UInt128 value = 0;
+		ParseStatus status = parseIPv6(texts[i], value);
+
+		values[i] = value;
+		valid += (status == ParseStatus::Success);
+
+		if (statuses != nullptr)
+		{
+			statuses[i] = status;
+		}
+	}
+
+	return valid;
+}
\ No newline at end of file
@@ -3,26 +3,16 @@
 /**
  * @brief Pre-increment operator for IPAddress.
  *
- * This operator increments the IP address by one. It iterates through the 
- * address in reverse order (from the least significant octet to the most 
- * significant octet). If an octet is not 255, it increments that octet and 
- * stops. This ensures that the address is incremented correctly, handling 
- * overflow from lower-order octets to higher-order octets.
+ * This operator increments the IP address by one. The address is treated as an
+ * unsigned integer of its own width, so incrementing the highest address wraps
+ * around to the lowest one.
  *
  * @return IPAddress& A reference to the incremented IP address.
  */
 IPAddress& IPAddress::operator++()
 {
-	// Iterate through the address in reverse order
-	for (vector<uint8_t>::reverse_iterator it = _address.rbegin(); it != _address.rend(); ++it)
-	{
-		// If the octet is not 255, increment it and break
-		if ((*it) != 255)
-		{
-			(*it)++;
-			break;
-		}
-	}
+	// Add one to the address, wrapping around at the width of the address
+	_address = (_address + 1) & getWidthMask();
 
 	return *this;
 }
@@ -30,23 +20,15 @@ IPAddress& IPAddress::operator++()
 /**
  * @brief Decrements the IP address by one.
  * 
- * This operator overload function iterates through the IP address octets in reverse order.
- * If an octet is not zero, it decrements the octet by one and breaks the loop.
+ * This operator decrements the address, treated as an unsigned integer of its own
+ * width, by one. Decrementing the lowest address wraps around to the highest one.
  * 
  * @return IPAddress& A reference to the decremented IP address.
  */
 IPAddress& IPAddress::operator--()
 {
-	// Iterate through the address in reverse order
-	for (vector<uint8_t>::reverse_iterator it = _address.rbegin(); it != _address.rend(); ++it)
-	{
-		// If the octet is not 0, decrement it and break
-		if ((*it) != 0)
-		{
-			(*it)--;
-			break;
-		}
-	}
+	// Subtract one from the address, wrapping around at the width of the address
+	_address = (_address - 1) & getWidthMask();
 
 	return *this;
 }
@@ -54,64 +36,53 @@ IPAddress& IPAddress::operator--()
 /**
  * @brief Overloads the += operator to increment the IP address by a given integer value.
  *
- * This function adds the specified increment to the IP address, handling overflow
- * by carrying over to the next octet as necessary. The operation is performed in
- * reverse order, starting from the least significant octet.
+ * This function adds the specified increment to the IP address. The addition is
+ * performed on the whole address at once, carrying across octet boundaries and
+ * wrapping around at the width of the address. A negative increment is subtracted.
  *
  * @param increment The integer value to add to the IP address.
  * @return IPAddress& A reference to the modified IPAddress object.
  */
 IPAddress& IPAddress::operator +=(int increment)
 {
-	// Initialize the carry value to the increment
-	int carry = increment;
-
-	// Iterate through the address in reverse order
-	for (vector<uint8_t>::reverse_iterator it = _address.rbegin(); it != _address.rend(); ++it)
-	{
-		// If the carry is zero, break
-		if (carry == 0)
-		{
-			break;
-		}
-
-		// Add the octet and the carry value
-		int sum = (*it) + carry;
-		(*it) = sum % 256;
-		carry = sum / 256;
-	}
-
-	return *this;
+	return addOffset(increment);
 }
 
 /**
  * @brief Overloads the -= operator to decrement the IP address by a specified integer value.
  *
  * This operator modifies the current IP address by subtracting the given decrement value.
- * The subtraction is performed on the IP address octets in reverse order, handling any necessary
- * borrow operations to ensure proper subtraction across octet boundaries.
+ * The subtraction is performed on the whole address at once, borrowing across octet
+ * boundaries and wrapping around at the width of the address.
  *
  * @param decrement The integer value to subtract from the IP address.
  * @return IPAddress& A reference to the modified IPAddress object.
  */
 IPAddress& IPAddress::operator -=(int decrement)
 {
-	// Initialize the borrow value to the decrement
-	int borrow = decrement;
+	// Negate the decrement on 64 bits, where the opposite of every int fits
+	return addOffset(-(int64_t)decrement);
+}
 
-	// Iterate through the address in reverse order
-	for (vector<uint8_t>::reverse_iterator it = _address.rbegin(); it != _address.rend(); ++it)
+/**
+ * @brief Adds a signed offset to the address, wrapping around at the width of the address.
+ *
+ * The magnitude of the offset is computed as an unsigned value, so that every offset,
+ * the lowest one included, is added or subtracted without overflow.
+ *
+ * @param offset The offset to add, subtracted if it is negative.
+ * @return IPAddress& A reference to the modified IPAddress object.
+ */
+IPAddress& IPAddress::addOffset(int64_t offset)
+{
+	// Add or subtract the magnitude of the offset
+	if (offset >= 0)
 	{
-		// If the borrow is zero, break
-		if (borrow == 0)
-		{
-			break;
-		}
-
-		// Subtract the octet and the borrow value
-		int difference = (*it) - borrow;
-		(*it) = difference % 256;
-		borrow = difference / 256;
+		_address = (_address + UInt128((uint64_t)offset)) & getWidthMask();
+	}
+	else
+	{
+		_address = (_address - UInt128(0 - (uint64_t)offset)) & getWidthMask();
 	}
 
 	return *this;
@@ -129,26 +100,8 @@ IPAddress& IPAddress::operator -=(int decrement)
  */
 IPAddress& IPAddress::operator&=(const Mask& mask)
 {
-	// Get the size of the mask
-	size_t maskSize = mask.getSize();
-
-	// Initialize the mask index
-	size_t maskIndex = 0;
-
-	// Iterate through the address octets
-	for (vector<uint8_t>::iterator it = _address.begin(); it != _address.end(); ++it)
-	{
-		if (maskIndex < maskSize)
-		{
-			// Apply the mask to the octet
-			(*it) &= mask[maskIndex++];
-		}
-		else
-		{
-			// Set the octet to zero if the mask is exhausted
-			(*it) = 0;
-		}
-	}
+	// Apply the mask to the whole address at once, clearing the octets past the mask
+	_address &= mask.toValue(_size, false);
 
 	return *this;
 }
@@ -165,26 +118,8 @@ IPAddress& IPAddress::operator&=(const Mask& mask)
  */
 IPAddress& IPAddress::operator|=(const Mask& mask)
 {
-	// Get the size of the mask
-	size_t maskSize = mask.getSize();
-
-	// Initialize the mask index
-	size_t maskIndex = 0;
-
-	// Iterate through the address octets
-	for (vector<uint8_t>::iterator it = _address.begin(); it != _address.end(); ++it)
-	{
-		if (maskIndex < maskSize)
-		{
-			// Apply the mask to the octet
-			(*it) |= mask[maskIndex++];
-		}
-		else
-		{
-			// Set the octet to 255 if the mask is exhausted
-			(*it) = 255;
-		}
-	}
+	// Apply the mask to the whole address at once, setting the octets past the mask
+	_address |= mask.toValue(_size, true);
 	
 	return *this;
 }
\ No newline at end of file
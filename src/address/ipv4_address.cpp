@@ -1,12 +1,43 @@
-#include "utils/utils.h"
 #include "address/ipv4_address.h"
-#include <algorithm>
+
+/**
+ * @brief Parses an IPv4 address without throwing.
+ *
+ * @param text The dotted-decimal representation of the address.
+ * @param address The parsed address, only set if the text is valid.
+ * @return ParseStatus ParseStatus::Success if the text is a valid IPv4 address, the error otherwise.
+ */
+ParseStatus IPv4Address::tryParse(string_view text, IPv4Address& address)
+{
+	STATS_TIMER(StatsPhase::Parse);
+
+	uint32_t value = 0;
+	ParseStatus status = parseIPv4(text, value);
+
+	if (status == ParseStatus::Success)
+	{
+		address._address = value;
+	}
+
+	return status;
+}
+
+/**
+ * @brief Retrieves the message of an error of an IPv4 address.
+ *
+ * @param status The error, as returned by tryParse() or by the creation of a network.
+ * @return const char* The message, the one the throwing constructors report.
+ */
+const char* IPv4Address::getErrorMessage(ParseStatus status)
+{
+	return getParseStatusMessage(status, IPV4_NUM_OCTETS);
+}
 
 /**
  * @brief Sets the IPv4 address from a string representation.
  *
- * This function takes a string representation of an IPv4 address, splits it into octets,
- * validates each octet, and sets the address if all parts are valid.
+ * This function parses a string representation of an IPv4 address with tryParse(),
+ * which validates each octet in a single pass, and sets the address if all parts are valid.
  *
  * @param address The string representation of the IPv4 address.
  * @throws std::invalid_argument if the address does not have exactly 4 parts,
@@ -15,37 +46,11 @@
  */
 void IPv4Address::setAddress(const string& address)
 {
-	// Split the address into octets
-	vector<string> octets = split(address, ".");
+	ParseStatus status = tryParse(address, *this);
 
-	// Check if the address has the correct number of parts
-	if (octets.size() != IPV4_NUM_OCTETS)
+	// Report the error of an invalid address
+	if (status != ParseStatus::Success)
 	{
-		throw invalid_argument("Invalid IPv4 address: must have " + to_string(IPV4_NUM_OCTETS) + " parts.");
-	}
-
-	// Iterate over the octets and validate each part
-	for (size_t i = 0; i < IPV4_NUM_OCTETS; ++i)
-	{
-		// Get the current octet
-		const string& octet = octets[i];
-
-		// Check if the octet is empty or contains non-digit characters
-		if (octet.empty() || !all_of(octet.begin(), octet.end(), ::isdigit))
-		{
-			throw invalid_argument("Invalid IPv4 address: parts must be non-empty and contain only digits.");
-		}
-
-		// Convert the octet to an integer
-		int octetValue = stoi(octet);
-
-		// Check if the octet is within the valid range
-		if (octetValue < 0 || octetValue > 255)
-		{
-			throw invalid_argument("Invalid IPv4 address: parts must be between 0 and 255.");
-		}
-
-		// Set the octet value in the address
-		_address[i] = octetValue;
+		throw invalid_argument(getErrorMessage(status));
 	}
-}
\ No newline at end of file
+}
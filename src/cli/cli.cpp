@@ -0,0 +1,1005 @@
+#include "cli/cli.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include "network/prefix_aggregator.h"
+#include "format/pipeline.h"
+#include "address/address_parser.h"
+#include "utils/mapped_file.h"
+#include "utils/parallel.h"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+
+#define CLI_BUFFERED_OUTPUT_SIZE MAPPED_FILE_CHUNK_SIZE ///< The size of the buffered output of a chunk of a batch from which its remaining jobs are run by the writing thread.
+#define CLI_SEGMENT_MAX_SUBNETS PIPELINE_CHUNK_SIZE ///< The largest segmentation stored as subnet networks before being printed, larger ones being streamed from their lazy range.
+
+/**
+ * @brief Parses a non-negative decimal integer.
+ * 
+ * @param text The text to parse.
+ * @param maximum The maximum accepted value.
+ * @param value The parsed value, only set if the text is valid.
+ * @return bool True if the text is a decimal integer not greater than the maximum, false otherwise.
+ */
+static bool parseUnsigned(string_view text, uint64_t maximum, uint64_t& value)
+{
+	// Check if the text is a non-empty sequence of digits
+	if (text.empty() || !all_of(text.begin(), text.end(), ::isdigit))
+	{
+		return false;
+	}
+
+	uint64_t result = 0;
+
+	// Accumulate the digits, checking the maximum before each step so that the result cannot overflow
+	for (char c : text)
+	{
+		uint64_t digit = (uint64_t)(c - '0');
+
+		if (result > (maximum - digit) / 10)
+		{
+			return false;
+		}
+
+		result = result * 10 + digit;
+	}
+
+	value = result;
+
+	return true;
+}
+
+/**
+ * @brief Parses the levels of a hierarchical plan.
+ * 
+ * @param text The levels, separated by commas, each one as /<prefix length>[:<number of subnets>].
+ * @param levels The parsed levels, only set if the text is valid.
+ * @return bool True if the text is a valid list of levels, false otherwise.
+ */
+static bool parsePlan(string_view text, vector<PlanLevel>& levels)
+{
+	vector<PlanLevel> result;
+	size_t start = 0;
+
+	while (start <= text.size())
+	{
+		size_t end = min(text.find(',', start), text.size());
+		string_view level = text.substr(start, end - start);
+
+		// Split the level into its prefix length and its optional number of subnets
+		if (level.empty() || level[0] != '/')
+		{
+			return false;
+		}
+
+		size_t colon = level.find(':');
+		uint64_t prefixLength = 0;
+		uint64_t count = 0;
+
+		if (!parseUnsigned(level.substr(1, colon - 1), MASK_MAX_PREFIX, prefixLength)
+			|| (colon != string_view::npos && (!parseUnsigned(level.substr(colon + 1), UINT64_MAX, count) || count == 0)))
+		{
+			return false;
+		}
+
+		result.push_back(PlanLevel{ (int)prefixLength, count });
+		start = end + 1;
+	}
+
+	levels = result;
+
+	return true;
+}
+
+/**
+ * @brief Parses the command line.
+ * 
+ * This function scans the arguments in order. The file of "--batch" and "--aggregate"
+ * is optional and taken from the next argument unless it starts with "--"; "-" stands
+ * for the standard input.
+ * 
+ * @param argc The number of arguments, including the program name.
+ * @param argv The arguments, including the program name.
+ * @return CliOptions The options given on the command line.
+ * @throws std::invalid_argument If an option is malformed.
+ */
+CliOptions parseOptions(int argc, const char* const argv[])
+{
+	CliOptions options;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		string argument = argv[i];
+
+		if (argument == "--batch" || argument == "--aggregate")
+		{
+			bool& mode = (argument == "--batch") ? options.batch : options.aggregate;
+			mode = true;
+
+			// Read the optional file of the jobs or of the prefixes
+			if (i + 1 < argc && string(argv[i + 1]).compare(0, 2, "--") != 0)
+			{
+				string file = argv[++i];
+				options.inputFile = (file == "-") ? "" : file;
+			}
+		}
+		else if (argument == "--threads")
+		{
+			uint64_t threadCount = 0;
+
+			// Read the number of threads
+			if (i + 1 >= argc || !parseUnsigned(argv[++i], 1024, threadCount))
+			{
+				throw invalid_argument("Invalid number of threads: must be an integer between 0 and 1024.");
+			}
+
+			options.threadCount = (unsigned)threadCount;
+		}
+		else if (argument == "--offset" || argument == "--limit")
+		{
+			uint64_t& value = (argument == "--offset") ? options.offset : options.limit;
+
+			// Read the index of the first subnet or the number of subnets
+			if (i + 1 >= argc || !parseUnsigned(argv[++i], UINT64_MAX, value))
+			{
+				throw invalid_argument("Invalid " + argument.substr(2) + ": must be a non-negative integer.");
+			}
+		}
+		else if (argument == "--plan")
+		{
+			// Read the levels of the plan
+			if (i + 1 >= argc || !parsePlan(argv[++i], options.plan))
+			{
+				throw invalid_argument("Invalid plan: must be a list of /<prefix length>[:<number of subnets>] levels separated by commas.");
+			}
+		}
+		else if (argument == "--stats")
+		{
+			options.stats = true;
+		}
+		else if (argument == "--format")
+		{
+			// Read the output format
+			if (i + 1 >= argc || !parseOutputFormat(argv[++i], options.format))
+			{
+				throw invalid_argument("Invalid output format: must be table, csv, ndjson or binary.");
+			}
+		}
+		else
+		{
+			options.arguments.push_back(argument);
+		}
+	}
+
+	return options;
+}
+
+/**
+ * @brief Segments a network and writes its subnets in the format of the options.
+ * 
+ * A page of the subnets, and a segmentation of more than CLI_SEGMENT_MAX_SUBNETS
+ * subnets, are computed, formatted and written by the stages of the pipeline, with the
+ * threads of the options, so that the output starts at once, no subnet is stored, and
+ * only the subnets of the page are computed. Any number of subnets the network can
+ * hold is thus written in constant memory, up to 2^64 - 1. Otherwise the table is
+ * printed from the segmented network, which stores one network per subnet, while the
+ * other formats are streamed from the lazy range of the subnets, one record at a time.
+ * 
+ * @tparam NetworkType The type of the network, IPv4Network or IPv6Network.
+ * @param network The network to segment.
+ * @param numberOfSubnets The number of subnets to create.
+ * @param s The output stream to which the subnets will be written.
+ * @param options The options of the run.
+ */
+template <typename NetworkType>
+static void writeJob(NetworkType& network, uint64_t numberOfSubnets, ostream& s, const CliOptions& options)
+{
+	if (options.offset > 0 || options.limit < numberOfSubnets || numberOfSubnets > CLI_SEGMENT_MAX_SUBNETS)
+	{
+		// Overlap the computation, the formatting and the writing of the subnets of the page
+		writePipelined(s, network.segmentRange(numberOfSubnets).slice(options.offset, options.limit), options.format, options.threadCount);
+	}
+	else if (options.format == OutputFormat::Table)
+	{
+		// Segment and print the network
+		network.segment(numberOfSubnets, options.threadCount);
+		s << network;
+	}
+	else
+	{
+		// Stream the records of the subnets
+		OutputBuffer out(s);
+		writeRecords(out, network.segmentRange(numberOfSubnets), options.format);
+	}
+}
+
+/**
+ * @brief Creates a network of a family, checks its segmentation and writes its subnets.
+ * 
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @tparam NetworkType The type of the network, IPv4Network or IPv6Network.
+ * @param address The text of the address of the network.
+ * @param prefixLength The prefix length of the network.
+ * @param numberOfSubnets The number of subnets to create.
+ * @param s The output stream to which the subnets will be written.
+ * @param error The message of the error, only set if the job fails.
+ * @param options The options of the run.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+template <typename Traits, typename NetworkType>
+static bool tryRunNetwork(string_view address, int prefixLength, uint64_t numberOfSubnets, ostream& s, string& error, const CliOptions& options)
+{
+	typedef typename Traits::address_type AddressType;
+
+	// Parse the address
+	AddressType ip{typename Traits::value_type()};
+	ParseStatus status = AddressType::tryParse(address, ip);
+
+	if (status != ParseStatus::Success)
+	{
+		error = AddressType::getErrorMessage(status);
+		return false;
+	}
+
+	// Create the network
+	unique_ptr<NetworkType> network;
+	status = NetworkType::tryCreate(ip, prefixLength, network);
+
+	if (status != ParseStatus::Success)
+	{
+		error = AddressType::getErrorMessage(status);
+		return false;
+	}
+
+	// Check the segmentation before segmenting the network
+	SegmentStatus segmentStatus = network->checkSegment(numberOfSubnets);
+
+	if (segmentStatus != SegmentStatus::Success)
+	{
+		error = BasicNetwork<Traits>::getErrorMessage(segmentStatus);
+		return false;
+	}
+
+	writeJob(*network, numberOfSubnets, s, options);
+
+	return true;
+}
+
+/**
+ * @brief Segments a network given in CIDR notation and prints its subnets, without throwing on invalid input.
+ * 
+ * This function splits the CIDR notation into the address and the prefix length,
+ * parses them and the number of subnets, creates the network of the family of the
+ * address, checks its segmentation, and writes its subnets in the format of the
+ * options. Every step reports its error as a status, so an invalid job costs no
+ * more than a valid one. The table is not terminated by a newline.
+ * 
+ * @param cidr The network in CIDR notation, such as 192.168.0.0/24 or 2001:db8::/32.
+ * @param numberOfSubnets The number of subnets to create, as a decimal string.
+ * @param s The output stream to which the subnets will be printed.
+ * @param error The message of the error, only set if the job fails.
+ * @param options The options of the run.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+bool tryRunJob(string_view cidr, string_view numberOfSubnets, ostream& s, string& error, const CliOptions& options)
+{
+	// Split the network into its address and its prefix length
+	size_t slash = cidr.find('/');
+
+	if (slash == string_view::npos || cidr.find('/', slash + 1) != string_view::npos)
+	{
+		error = "Invalid IP address/prefix format. Use the format <IP address>/<prefix length>.";
+		return false;
+	}
+
+	string_view address = cidr.substr(0, slash);
+	uint64_t prefixLength = 0;
+	uint64_t count = 0;
+
+	// Parse the prefix length and the number of subnets
+	if (!parseUnsigned(cidr.substr(slash + 1), MASK_MAX_PREFIX, prefixLength))
+	{
+		error = "Invalid prefix length: must be between " + to_string(MASK_MIN_PREFIX) + " and " + to_string(MASK_MAX_PREFIX) + ".";
+		return false;
+	}
+
+	if (!parseUnsigned(numberOfSubnets, UINT64_MAX, count))
+	{
+		error = "Invalid number of subnets: must be an integer between 1 and " + to_string(UINT64_MAX) + ".";
+		return false;
+	}
+
+	// Check if the IP address is IPv4 or IPv6, then run the job of its family
+	if (address.find(':') != string_view::npos)
+	{
+		return tryRunNetwork<IPv6Traits, IPv6Network>(address, (int)prefixLength, count, s, error, options);
+	}
+
+	return tryRunNetwork<IPv4Traits, IPv4Network>(address, (int)prefixLength, count, s, error, options);
+}
+
+/**
+ * @brief Segments a network given in CIDR notation and prints its subnets.
+ * 
+ * This function runs the job with tryRunJob() and throws its error.
+ * 
+ * @param cidr The network in CIDR notation, such as 192.168.0.0/24 or 2001:db8::/32.
+ * @param numberOfSubnets The number of subnets to create, as a decimal string.
+ * @param s The output stream to which the subnets will be printed.
+ * @param options The options of the run.
+ * @throws std::invalid_argument If the network or the number of subnets is invalid.
+ */
+void runJob(const string& cidr, const string& numberOfSubnets, ostream& s, const CliOptions& options)
+{
+	string error;
+
+	if (!tryRunJob(cidr, numberOfSubnets, s, error, options))
+	{
+		throw invalid_argument(error);
+	}
+}
+
+/**
+ * @brief Creates the plan of a network of a family and writes its subnets.
+ * 
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param address The text of the address of the network.
+ * @param prefixLength The prefix length of the network.
+ * @param s The output stream to which the subnets will be written.
+ * @param error The message of the error, only set if the plan fails.
+ * @param options The options of the run.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+template <typename Traits>
+static bool tryRunPlanNetwork(string_view address, int prefixLength, ostream& s, string& error, const CliOptions& options)
+{
+	typedef typename Traits::address_type AddressType;
+
+	// Parse the address
+	AddressType ip{typename Traits::value_type()};
+	ParseStatus status = AddressType::tryParse(address, ip);
+
+	if (status != ParseStatus::Success)
+	{
+		error = AddressType::getErrorMessage(status);
+		return false;
+	}
+
+	if (!ip.isPrefixLengthCompatible(prefixLength))
+	{
+		error = AddressType::getErrorMessage(ParseStatus::InvalidPrefixLength);
+		return false;
+	}
+
+	unique_ptr<SegmentPlan<Traits>> plan;
+
+	// Create the plan, whose errors are reported by its constructor
+	try
+	{
+		plan.reset(new SegmentPlan<Traits>(Traits::toValue(ip), prefixLength, options.plan));
+	}
+	catch (const invalid_argument& e)
+	{
+		error = e.what();
+		return false;
+	}
+
+	// Write the tree of the subnets depth-first
+	writePipelined(s, *plan, options.format, options.threadCount);
+
+	return true;
+}
+
+/**
+ * @brief Segments a network given in CIDR notation level by level and prints the tree of its subnets, without throwing on invalid input.
+ * 
+ * @param cidr The network in CIDR notation, such as 10.0.0.0/8 or 2001:db8::/32.
+ * @param s The output stream to which the subnets will be printed.
+ * @param error The message of the error, only set if the plan fails.
+ * @param options The options of the run, holding the levels of the plan.
+ * @return bool True if the subnets are written, false otherwise.
+ */
+bool tryRunPlan(string_view cidr, ostream& s, string& error, const CliOptions& options)
+{
+	// Split the network into its address and its prefix length
+	size_t slash = cidr.find('/');
+	uint64_t prefixLength = 0;
+
+	if (slash == string_view::npos || cidr.find('/', slash + 1) != string_view::npos)
+	{
+		error = "Invalid IP address/prefix format. Use the format <IP address>/<prefix length>.";
+		return false;
+	}
+
+	if (!parseUnsigned(cidr.substr(slash + 1), MASK_MAX_PREFIX, prefixLength))
+	{
+		error = "Invalid prefix length: must be between " + to_string(MASK_MIN_PREFIX) + " and " + to_string(MASK_MAX_PREFIX) + ".";
+		return false;
+	}
+
+	string_view address = cidr.substr(0, slash);
+
+	// Check if the IP address is IPv4 or IPv6, then run the plan of its family
+	if (address.find(':') != string_view::npos)
+	{
+		return tryRunPlanNetwork<IPv6Traits>(address, (int)prefixLength, s, error, options);
+	}
+
+	return tryRunPlanNetwork<IPv4Traits>(address, (int)prefixLength, s, error, options);
+}
+
+/**
+ * @brief Segments a network given in CIDR notation level by level and prints the tree of its subnets.
+ * 
+ * This function runs the plan with tryRunPlan() and throws its error.
+ * 
+ * @param cidr The network in CIDR notation, such as 10.0.0.0/8 or 2001:db8::/32.
+ * @param s The output stream to which the subnets will be printed.
+ * @param options The options of the run, holding the levels of the plan.
+ * @throws std::invalid_argument If the network or the plan is invalid.
+ */
+void runPlan(const string& cidr, ostream& s, const CliOptions& options)
+{
+	string error;
+
+	if (!tryRunPlan(cidr, s, error, options))
+	{
+		throw invalid_argument(error);
+	}
+}
+
+/**
+ * @brief Calls a function on each line of a text, until it returns false.
+ * 
+ * The lines are cut in place, like getline() cuts them, without their newline
+ * and without a last empty line after the final newline.
+ * 
+ * @tparam Function The type of the function, called as function(line, lineNumber), returning false to stop before the line.
+ * @param text The text holding the lines.
+ * @param firstLineNumber The number of the first line of the text.
+ * @param function The function called on each line.
+ * @return size_t The length of the text before the line the function stopped at, the length of the whole text if it did not stop.
+ */
+template <typename Function>
+static size_t forEachLine(string_view text, size_t firstLineNumber, Function function)
+{
+	size_t lineNumber = firstLineNumber;
+	size_t start = 0;
+
+	while (start < text.size())
+	{
+		size_t end = min(text.find('\n', start), text.size());
+
+		if (!function(text.substr(start, end - start), lineNumber++))
+		{
+			return start;
+		}
+
+		start = end + 1;
+	}
+
+	return text.size();
+}
+
+/**
+ * @brief Calls a function on the chunks of lines of an input, in parallel, writing their outputs in order.
+ * 
+ * With a single thread, or an input of a single chunk, the function is called once on
+ * the whole input and writes to the output stream directly. Otherwise the input is split
+ * into chunks of whole lines, processed in rounds of one chunk per thread. In each round,
+ * the threads first count the lines of their chunks, which gives the number of the first
+ * line of each chunk, then call the function on their chunks. The first chunk of the
+ * round writes to the output stream directly, and the others each write into a buffer of
+ * their own, which is written to the output stream in order at the end of the round, so
+ * the output is the same as with a single thread.
+ * 
+ * A function writing into a buffer may stop before the end of its chunk, such as before a
+ * job whose output is large or once its buffer is large enough. The rest of the chunk is
+ * then processed by the calling thread, writing to the output stream directly, right after
+ * the buffer is written. The memory used is thus bounded by what the function accepts to
+ * buffer, whatever the size of the outputs.
+ * 
+ * @tparam Function The type of the function, called as function(slot, chunk, firstLineNumber, output, buffered)
+ *         and returning the length of the chunk it processed, the whole chunk if its output is not buffered.
+ *         The slot is the index of the chunk in its round, so the function can keep state per slot.
+ * @param input The input holding the lines.
+ * @param s The output stream to which the outputs are written.
+ * @param threadCount The number of threads, 0 meaning one per hardware thread.
+ * @param function The function called on each chunk.
+ * @return unsigned The number of slots.
+ */
+template <typename Function>
+static unsigned forEachChunk(string_view input, ostream& s, unsigned threadCount, Function function)
+{
+	threadCount = resolveThreadCount(threadCount);
+
+	// Process the input directly if it is not worth splitting
+	if (threadCount == 1 || input.size() <= MAPPED_FILE_CHUNK_SIZE)
+	{
+		function((size_t)0, input, (size_t)1, s, false);
+		return 1;
+	}
+
+	vector<string_view> chunks = splitLines(input);
+	vector<size_t> firstLineNumbers(threadCount);
+	vector<size_t> processed(threadCount);
+	vector<ostringstream> outputs(threadCount);
+	size_t lineNumber = 1;
+
+	for (size_t round = 0; round < chunks.size(); round += threadCount)
+	{
+		size_t count = min((size_t)threadCount, chunks.size() - round);
+
+		// Count the lines of the chunks of the round
+		parallelFor(count, threadCount, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				string_view chunk = chunks[round + i];
+				firstLineNumbers[i] = (size_t)std::count(chunk.begin(), chunk.end(), '\n');
+			}
+		}, 1);
+
+		// Turn the counts into the numbers of the first lines
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t lines = firstLineNumbers[i];
+			firstLineNumbers[i] = lineNumber;
+			lineNumber += lines;
+		}
+
+		// Process the chunks of the round, the first one straight to the stream and the others into their buffers
+		parallelFor(count, threadCount, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				processed[i] = (i == 0) ? function(i, chunks[round], firstLineNumbers[0], s, false)
+					: function(i, chunks[round + i], firstLineNumbers[i], (ostream&)outputs[i], true);
+			}
+		}, 1);
+
+		// Write the buffers in order, each followed by the rest of its chunk
+		for (size_t i = 1; i < count; ++i)
+		{
+			string_view chunk = chunks[round + i];
+
+			s << outputs[i].str();
+			outputs[i].str(string());
+
+			if (processed[i] < chunk.size())
+			{
+				string_view head = chunk.substr(0, processed[i]);
+				function(i, chunk.substr(processed[i]), firstLineNumbers[i] + (size_t)std::count(head.begin(), head.end(), '\n'), s, false);
+			}
+		}
+	}
+
+	return threadCount;
+}
+
+/**
+ * @brief The characters separating the tokens of a line of a batch.
+ */
+static const char BATCH_WHITESPACE[] = " \t\r";
+
+/**
+ * @brief Splits a line of a batch into the tokens of its job.
+ * 
+ * @param line The line, without its newline.
+ * @param cidr The network of the job, only set if the line holds two tokens.
+ * @param numberOfSubnets The number of subnets of the job, only set if the line holds two tokens.
+ * @return bool True if the line holds exactly two tokens, false otherwise.
+ */
+static bool splitBatchLine(string_view line, string_view& cidr, string_view& numberOfSubnets)
+{
+	size_t start = line.find_first_not_of(BATCH_WHITESPACE);
+	size_t end = line.find_first_of(BATCH_WHITESPACE, start);
+	size_t countStart = line.find_first_not_of(BATCH_WHITESPACE, end);
+	size_t countEnd = line.find_first_of(BATCH_WHITESPACE, countStart);
+
+	if (start == string_view::npos || end == string_view::npos || countStart == string_view::npos
+		|| line.find_first_not_of(BATCH_WHITESPACE, countEnd) != string_view::npos)
+	{
+		return false;
+	}
+
+	cidr = line.substr(start, end - start);
+	numberOfSubnets = line.substr(countStart, countEnd - countStart);
+
+	return true;
+}
+
+/**
+ * @brief Checks if a line of a batch is a job streamed through the pipeline, whose output can be of any size.
+ * 
+ * @param line The line, without its newline.
+ * @param options The options of the run.
+ * @return bool True if the line is a job writing more than CLI_SEGMENT_MAX_SUBNETS subnets, false otherwise.
+ */
+static bool isStreamedBatchLine(string_view line, const CliOptions& options)
+{
+	string_view cidr;
+	string_view numberOfSubnets;
+	uint64_t count = 0;
+
+	return splitBatchLine(line, cidr, numberOfSubnets) && cidr[0] != '#'
+		&& parseUnsigned(numberOfSubnets, UINT64_MAX, count) && min(count, options.limit) > CLI_SEGMENT_MAX_SUBNETS;
+}
+
+/**
+ * @brief Runs the segmentation job of a line of a batch.
+ * 
+ * Blank lines and comments are skipped. The result of the job, or its error, is
+ * written to the output stream.
+ * 
+ * @param line The line, without its newline.
+ * @param lineNumber The number of the line, reported with its error.
+ * @param s The output stream to which the result is written.
+ * @param error The buffer of the message of the error.
+ * @param options The options of the run.
+ * @return bool True if the line is a job that failed, false otherwise.
+ */
+static bool runBatchLine(string_view line, size_t lineNumber, ostream& s, string& error, const CliOptions& options)
+{
+	// Find the first token, skipping blank lines and comments
+	size_t start = line.find_first_not_of(BATCH_WHITESPACE);
+
+	if (start == string_view::npos || line[start] == '#')
+	{
+		return false;
+	}
+
+	// Split the line into its two tokens
+	string_view cidr;
+	string_view numberOfSubnets;
+	bool succeeded = false;
+
+	if (!splitBatchLine(line, cidr, numberOfSubnets))
+	{
+		error = "Invalid job format. Use the format <IP address>/<prefix length> <number of subnets>.";
+	}
+	else
+	{
+		succeeded = tryRunJob(cidr, numberOfSubnets, s, error, options);
+	}
+
+	if (!succeeded)
+	{
+		s << "Error: line " << lineNumber << ": " << error << '\n';
+		return true;
+	}
+
+	// Terminate the table, the records already end with a newline
+	if (options.format == OutputFormat::Table)
+	{
+		s << '\n';
+	}
+
+	return false;
+}
+
+/**
+ * @brief Runs the segmentation jobs read line by line from an input stream.
+ * 
+ * This function reads the jobs one line at a time, so that results start to be written
+ * before the whole input is read. The jobs are run with tryRunJob(), which returns the
+ * errors instead of throwing them, and the errors are reported inline.
+ * 
+ * @param in The input stream from which the jobs are read.
+ * @param s The output stream to which the results are written.
+ * @param options The options of the run.
+ * @return size_t The number of jobs that failed.
+ */
+size_t runBatch(istream& in, ostream& s, const CliOptions& options)
+{
+	string line;
+	string error;
+	size_t lineNumber = 0;
+	size_t failures = 0;
+
+	while (getline(in, line))
+	{
+		failures += runBatchLine(line, ++lineNumber, s, error, options);
+	}
+
+	return failures;
+}
+
+/**
+ * @brief Runs the segmentation jobs of an input held in memory, such as a mapped file.
+ * 
+ * The lines are parsed in place. With several threads, the input is split into chunks
+ * of whole lines whose jobs are run in parallel, each job then being segmented by a
+ * single thread, and the results are written in the order of the input.
+ * 
+ * @param input The jobs, one per line.
+ * @param s The output stream to which the results are written.
+ * @param options The options of the run.
+ * @return size_t The number of jobs that failed.
+ */
+size_t runBatch(string_view input, ostream& s, const CliOptions& options)
+{
+	unsigned threadCount = resolveThreadCount(options.threadCount);
+	vector<size_t> failures(threadCount, 0);
+	CliOptions chunkOptions = options;
+
+	// Segment each network with a single thread if the chunks are run in parallel
+	chunkOptions.threadCount = (input.size() <= MAPPED_FILE_CHUNK_SIZE) ? options.threadCount : 1;
+
+	forEachChunk(input, s, threadCount, [&](size_t slot, string_view chunk, size_t firstLineNumber, ostream& out, bool buffered)
+	{
+		string error;
+
+		return forEachLine(chunk, firstLineNumber, [&](string_view line, size_t lineNumber)
+		{
+			// Leave the rest of a buffered chunk to the writing thread once its buffer is full or from a streamed job
+			if (buffered && ((size_t)(streamoff)out.tellp() >= CLI_BUFFERED_OUTPUT_SIZE || isStreamedBatchLine(line, chunkOptions)))
+			{
+				return false;
+			}
+
+			failures[slot] += runBatchLine(line, lineNumber, out, error, chunkOptions);
+			return true;
+		});
+	});
+
+	return accumulate(failures.begin(), failures.end(), (size_t)0);
+}
+
+/**
+ * @brief Parses a prefix of a family and adds it to the aggregation of the family.
+ * 
+ * The address is parsed with the allocation-free parser of the family, and
+ * the errors are returned instead of thrown.
+ * 
+ * @tparam Traits The address family traits, IPv4Traits or IPv6Traits.
+ * @param address The text of the address.
+ * @param prefixLength The text of the prefix length.
+ * @param aggregator The aggregation of the family.
+ * @param error The message of the error, only set if the prefix is invalid.
+ * @return bool True if the prefix is added, false otherwise.
+ */
+template <typename Traits>
+static bool tryAddPrefix(string_view address, string_view prefixLength, PrefixAggregator<Traits>& aggregator, string& error)
+{
+	typedef typename Traits::address_type AddressType;
+
+	AddressType ip{typename Traits::value_type()};
+	uint64_t length = 0;
+
+	// Parse the address
+	ParseStatus status = AddressType::tryParse(address, ip);
+
+	if (status != ParseStatus::Success)
+	{
+		error = AddressType::getErrorMessage(status);
+		return false;
+	}
+
+	// Parse the prefix length
+	if (!parseUnsigned(prefixLength, Traits::ADDRESS_BITS, length))
+	{
+		error = "Invalid prefix length: must be between 0 and " + to_string(Traits::ADDRESS_BITS) + ".";
+		return false;
+	}
+
+	aggregator.add(Subnet<Traits>(Traits::toValue(ip), (int)length));
+
+	return true;
+}
+
+/**
+ * @brief Adds the prefix of a line to the aggregation of its family.
+ * 
+ * Blank lines and comments are skipped. The error of an invalid line is written
+ * to the output stream.
+ * 
+ * @param line The line, without its newline.
+ * @param lineNumber The number of the line, reported with its error.
+ * @param s The output stream to which the error is written.
+ * @param ipv4 The aggregation of the IPv4 prefixes.
+ * @param ipv6 The aggregation of the IPv6 prefixes.
+ * @return bool True if the line failed, false otherwise.
+ */
+static bool aggregateLine(string_view line, size_t lineNumber, ostream& s, PrefixAggregator<IPv4Traits>& ipv4, PrefixAggregator<IPv6Traits>& ipv6)
+{
+	static const char* whitespace = " \t\r";
+
+	// Find the prefix, skipping blank lines and comments
+	size_t start = line.find_first_not_of(whitespace);
+
+	if (start == string_view::npos || line[start] == '#')
+	{
+		return false;
+	}
+
+	size_t end = min(line.find_first_of(whitespace, start), line.size());
+	string_view cidr = line.substr(start, end - start);
+	size_t slash = cidr.find('/');
+
+	string error;
+	bool succeeded = false;
+
+	// Check if the line holds a single prefix in CIDR notation
+	if (line.find_first_not_of(whitespace, end) != string_view::npos || slash == string_view::npos)
+	{
+		error = "Invalid prefix format. Use the format <IP address>/<prefix length>.";
+	}
+	else if (cidr.substr(0, slash).find(':') != string_view::npos)
+	{
+		// Add the prefix to the aggregation of its family
+		succeeded = tryAddPrefix(cidr.substr(0, slash), cidr.substr(slash + 1), ipv6, error);
+	}
+	else
+	{
+		succeeded = tryAddPrefix(cidr.substr(0, slash), cidr.substr(slash + 1), ipv4, error);
+	}
+
+	if (!succeeded)
+	{
+		s << "Error: line " << lineNumber << ": " << error << '\n';
+	}
+
+	return !succeeded;
+}
+
+/**
+ * @brief Writes the aggregated prefixes of both families in the format of the options.
+ * 
+ * @param s The output stream to which the aggregated prefixes are written.
+ * @param ipv4 The aggregation of the IPv4 prefixes.
+ * @param ipv6 The aggregation of the IPv6 prefixes.
+ * @param options The options of the run.
+ */
+static void writeAggregation(ostream& s, PrefixAggregator<IPv4Traits>& ipv4, PrefixAggregator<IPv6Traits>& ipv6, const CliOptions& options)
+{
+	const vector<Subnet<IPv4Traits>>& ipv4Prefixes = ipv4.result();
+	const vector<Subnet<IPv6Traits>>& ipv6Prefixes = ipv6.result();
+
+	OutputBuffer out(s);
+
+	if (options.format == OutputFormat::Table)
+	{
+		// Write one prefix per line
+		for (const Subnet<IPv4Traits>& prefix : ipv4Prefixes)
+		{
+			writeCidrRecord(out, prefix);
+		}
+
+		for (const Subnet<IPv6Traits>& prefix : ipv6Prefixes)
+		{
+			writeCidrRecord(out, prefix);
+		}
+	}
+	else
+	{
+		// Write the records of each family that has prefixes
+		if (!ipv4Prefixes.empty())
+		{
+			writeRecords(out, ipv4Prefixes, options.format);
+		}
+
+		if (!ipv6Prefixes.empty())
+		{
+			writeRecords(out, ipv6Prefixes, options.format);
+		}
+	}
+}
+
+/**
+ * @brief Aggregates the prefixes read line by line from an input stream.
+ * 
+ * This function reads the prefixes one line at a time into one aggregator per family,
+ * which bounds the memory used by the size of the result, then writes both results.
+ * The errors are returned by the parsers instead of thrown, and reported inline.
+ * 
+ * @param in The input stream from which the prefixes are read.
+ * @param s The output stream to which the aggregated prefixes are written.
+ * @param options The options of the run.
+ * @return size_t The number of lines that failed.
+ */
+size_t runAggregate(istream& in, ostream& s, const CliOptions& options)
+{
+	PrefixAggregator<IPv4Traits> ipv4;
+	PrefixAggregator<IPv6Traits> ipv6;
+
+	string line;
+	size_t lineNumber = 0;
+	size_t failures = 0;
+
+	while (getline(in, line))
+	{
+		failures += aggregateLine(line, ++lineNumber, s, ipv4, ipv6);
+	}
+
+	writeAggregation(s, ipv4, ipv6, options);
+
+	return failures;
+}
+
+/**
+ * @brief Aggregates the prefixes of an input held in memory, such as a mapped file.
+ * 
+ * The lines are parsed in place. With several threads, the input is split into chunks
+ * of whole lines, each thread aggregating its chunks into aggregators of its own, which
+ * are merged once the whole input is read. Aggregation does not depend on the order of
+ * the prefixes, so the result is the same as with a single thread.
+ * 
+ * @param input The prefixes, one per line.
+ * @param s The output stream to which the aggregated prefixes are written.
+ * @param options The options of the run.
+ * @return size_t The number of lines that failed.
+ */
+size_t runAggregate(string_view input, ostream& s, const CliOptions& options)
+{
+	unsigned threadCount = resolveThreadCount(options.threadCount);
+
+	vector<PrefixAggregator<IPv4Traits>> ipv4(threadCount);
+	vector<PrefixAggregator<IPv6Traits>> ipv6(threadCount);
+	vector<size_t> failures(threadCount, 0);
+
+	unsigned slots = forEachChunk(input, s, threadCount, [&](size_t slot, string_view chunk, size_t firstLineNumber, ostream& out, bool)
+	{
+		return forEachLine(chunk, firstLineNumber, [&](string_view line, size_t lineNumber)
+		{
+			failures[slot] += aggregateLine(line, lineNumber, out, ipv4[slot], ipv6[slot]);
+			return true;
+		});
+	});
+
+	// Merge the aggregations of the slots into the first one
+	for (unsigned slot = 1; slot < slots; ++slot)
+	{
+		for (const Subnet<IPv4Traits>& prefix : ipv4[slot].result())
+		{
+			ipv4[0].add(prefix);
+		}
+
+		for (const Subnet<IPv6Traits>& prefix : ipv6[slot].result())
+		{
+			ipv6[0].add(prefix);
+		}
+	}
+
+	writeAggregation(s, ipv4[0], ipv6[0], options);
+
+	return accumulate(failures.begin(), failures.end(), (size_t)0);
+}
+
+/**
+ * @brief Runs the batch jobs, or the aggregation if the options request it, of an input file, without throwing if it cannot be opened.
+ * 
+ * Mapping the file is the fast path. It fails for the paths that are not regular files,
+ * which are then read as streams, so that pipes and FIFOs work as with the standard input.
+ * 
+ * @param path The path of the input file.
+ * @param s The output stream to which the results are written.
+ * @param failures The number of lines that failed, only set if the file is opened.
+ * @param options The options of the run.
+ * @return bool True if the file is opened and processed, false if it cannot be opened.
+ */
+bool tryRunInputFile(const string& path, ostream& s, size_t& failures, const CliOptions& options)
+{
+	MappedFile file;
+
+	// Process a regular file in place
+	if (file.open(path))
+	{
+		failures = options.aggregate ? runAggregate(file.getView(), s, options) : runBatch(file.getView(), s, options);
+		return true;
+	}
+
+	// Read any other file as a stream
+	ifstream in(path, ios::binary);
+
+	if (!in)
+	{
+		return false;
+	}
+
+	failures = options.aggregate ? runAggregate(in, s, options) : runBatch(in, s, options);
+
+	return true;
+}
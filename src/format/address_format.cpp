@@ -0,0 +1,391 @@
+#include "format/address_format.h"
+#include <cstring>
+
+#define IPV4_PARTS 4 ///< The number of parts in an IPv4 address.
+#define IPV6_PARTS 8 ///< The number of parts in an IPv6 address.
+
+/**
+ * @brief The lowercase hexadecimal digits.
+ */
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+/**
+ * @struct OctetTexts
+ * @brief Decimal texts of the 256 values of an octet.
+ *
+ * Each text is padded to four characters with the period that follows an octet
+ * in an IPv4 address, so that it can be copied as a single 32-bit word.
+ */
+struct OctetTexts
+{
+	/**
+	 * @brief The digits of each octet, followed by a period.
+	 */
+	char texts[256][4];
+
+	/**
+	 * @brief The number of digits of each octet.
+	 */
+	uint8_t lengths[256];
+};
+
+/**
+ * @brief Computes the decimal texts of the 256 values of an octet.
+ *
+ * @return OctetTexts The texts and their lengths.
+ */
+static constexpr OctetTexts makeOctetTexts()
+{
+	OctetTexts octets = {};
+
+	for (unsigned octet = 0; octet < 256; ++octet)
+	{
+		uint8_t length = 0;
+
+		// Write the digits of the octet without leading zeros
+		if (octet >= 100)
+		{
+			octets.texts[octet][length++] = (char)('0' + octet / 100);
+		}
+
+		if (octet >= 10)
+		{
+			octets.texts[octet][length++] = (char)('0' + octet / 10 % 10);
+		}
+
+		octets.texts[octet][length++] = (char)('0' + octet % 10);
+		octets.lengths[octet] = length;
+
+		// Pad the text with the period that follows the octet
+		for (uint8_t i = length; i < 4; ++i)
+		{
+			octets.texts[octet][i] = '.';
+		}
+	}
+
+	return octets;
+}
+
+/**
+ * @brief The texts of the octets, computed at compile time.
+ */
+static constexpr OctetTexts OCTET_TEXTS = makeOctetTexts();
+
+/**
+ * @brief Writes an unsigned integer in decimal.
+ *
+ * This function writes the digits from the least significant one into a local
+ * buffer, then copies them in order.
+ *
+ * @param value The integer to write.
+ * @param out The buffer receiving the digits, at least DECIMAL_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatDecimal(uint64_t value, char* out)
+{
+	char digits[DECIMAL_MAX_LENGTH];
+	size_t count = 0;
+
+	// Write the digits from the least significant one
+	do
+	{
+		digits[count++] = (char)('0' + value % 10);
+		value /= 10;
+	}
+	while (value != 0);
+
+	// Copy the digits in order
+	for (size_t i = 0; i < count; ++i)
+	{
+		out[i] = digits[count - 1 - i];
+	}
+
+	return count;
+}
+
+/**
+ * @brief Writes an IPv4 address in dotted-decimal notation.
+ *
+ * The first three octets are copied from the table of the octet texts as whole
+ * 32-bit words, their period included, and the last one without its period.
+ *
+ * @param value The value of the address.
+ * @param out The buffer receiving the text, at least IPV4_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv4(uint32_t value, char* out)
+{
+	char* it = out;
+
+	// Write the first three octets followed by their periods
+	for (int i = 0; i < IPV4_PARTS - 1; ++i)
+	{
+		unsigned octet = (value >> ((IPV4_PARTS - 1 - i) * 8)) & 0xFF;
+
+		memcpy(it, OCTET_TEXTS.texts[octet], 4);
+		it += OCTET_TEXTS.lengths[octet] + 1;
+	}
+
+	// Write the last octet, which fits in the buffer without its period
+	unsigned octet = value & 0xFF;
+
+	memcpy(it, OCTET_TEXTS.texts[octet], OCTET_TEXTS.lengths[octet]);
+	it += OCTET_TEXTS.lengths[octet];
+
+	return (size_t)(it - out);
+}
+
+/**
+ * @struct ZeroRuns
+ * @brief Longest runs of zero hextets of the 256 zero masks of an IPv6 address.
+ *
+ * Bit 7 - i of a mask is set if hextet i of the address is zero, the hextets
+ * being numbered from the most significant one.
+ */
+struct ZeroRuns
+{
+	/**
+	 * @brief The first hextet of the run of each mask, IPV6_PARTS if there is none.
+	 */
+	uint8_t starts[256];
+
+	/**
+	 * @brief The hextet following the run of each mask, IPV6_PARTS if there is none.
+	 */
+	uint8_t ends[256];
+};
+
+/**
+ * @brief Computes the longest runs of zero hextets of the 256 zero masks.
+ *
+ * As required by RFC 5952, the run is the longest one of at least two zero
+ * hextets, the first one in case of a tie, and a single zero hextet is not a run.
+ *
+ * @return ZeroRuns The runs of the masks.
+ */
+static constexpr ZeroRuns makeZeroRuns()
+{
+	ZeroRuns runs = {};
+
+	for (unsigned mask = 0; mask < 256; ++mask)
+	{
+		int start = IPV6_PARTS;
+		int end = IPV6_PARTS;
+		int i = 0;
+
+		// Measure each run of zero hextets, keeping the first longest one
+		while (i < IPV6_PARTS)
+		{
+			int runStart = i;
+
+			while (i < IPV6_PARTS && (mask >> (IPV6_PARTS - 1 - i)) & 1)
+			{
+				++i;
+			}
+
+			if (i - runStart >= 2 && i - runStart > end - start)
+			{
+				start = runStart;
+				end = i;
+			}
+
+			if (i == runStart)
+			{
+				++i;
+			}
+		}
+
+		runs.starts[mask] = (uint8_t)start;
+		runs.ends[mask] = (uint8_t)end;
+	}
+
+	return runs;
+}
+
+/**
+ * @brief The runs of the zero masks, computed at compile time.
+ */
+static constexpr ZeroRuns ZERO_RUNS = makeZeroRuns();
+
+/**
+ * @brief Computes the nonzero hextets of a half of an IPv6 address.
+ *
+ * The bits of each hextet are folded onto its lowest bit, then the four lowest
+ * bits are gathered into the top of the word by a single multiplication, whose
+ * partial products never overlap.
+ *
+ * @param word The half of the address.
+ * @return unsigned The nonzero mask, bit 3 - i being set if hextet i of the half is not zero.
+ */
+static inline unsigned findNonzeroHextets(uint64_t word)
+{
+	word |= word >> 8;
+	word |= word >> 4;
+	word |= word >> 2;
+	word |= word >> 1;
+
+	return (unsigned)(((word & 0x0001000100010001ull) * 0x0001000200040008ull) >> 48) & 0xF;
+}
+
+/**
+ * @brief Computes the zero mask of an IPv6 address.
+ *
+ * @param value The value of the address.
+ * @return unsigned The zero mask, bit 7 - i being set if hextet i is zero.
+ */
+static inline unsigned findZeroHextets(const UInt128& value)
+{
+	return ~((findNonzeroHextets(value.getHigh()) << 4) | findNonzeroHextets(value.getLow())) & 0xFF;
+}
+
+/**
+ * @brief Writes the hextets of a half of an IPv6 address.
+ *
+ * The run of zero hextets is replaced by "::", written as the colon that
+ * follows the previous hextet and a second one, or as two colons if the run
+ * starts the address.
+ *
+ * @param word The half of the address.
+ * @param first The number of the first hextet of the half, 0 or 4.
+ * @param start The first hextet of the run of zero hextets.
+ * @param end The hextet following the run of zero hextets.
+ * @param out The buffer receiving the text.
+ * @return char* The end of the text.
+ */
+static inline char* writeHextets(uint64_t word, int first, int start, int end, char* out)
+{
+	for (int i = first; i < first + IPV6_PARTS / 2; ++i)
+	{
+		if (i == start)
+		{
+			*out++ = ':';
+
+			if (i == 0)
+			{
+				*out++ = ':';
+			}
+		}
+
+		if (i >= start && i < end)
+		{
+			continue;
+		}
+
+		// Write the digits of the hextet without leading zeros
+		unsigned hextet = (unsigned)(word >> ((first + 3 - i) * 16)) & 0xFFFF;
+		int shift = (hextet >= 0x1000) ? 12 : (hextet >= 0x100) ? 8 : (hextet >= 0x10) ? 4 : 0;
+
+		for (; shift >= 0; shift -= 4)
+		{
+			*out++ = HEX_DIGITS[(hextet >> shift) & 0xF];
+		}
+
+		// Write a colon after the hextet if it is not the last one
+		if (i < IPV6_PARTS - 1)
+		{
+			*out++ = ':';
+		}
+	}
+
+	return out;
+}
+
+/**
+ * @brief Writes an IPv6 address in the canonical text representation of RFC 5952.
+ *
+ * The zero hextets are found on the two 64-bit halves of the address at once,
+ * and their mask indexes the table of the longest runs, so the address is
+ * written in a single pass without extracting its hextets first.
+ *
+ * @param value The value of the address.
+ * @param out The buffer receiving the text, at least IPV6_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv6(const UInt128& value, char* out)
+{
+	unsigned zeros = findZeroHextets(value);
+	int start = ZERO_RUNS.starts[zeros];
+	int end = ZERO_RUNS.ends[zeros];
+
+	char* it = writeHextets(value.getHigh(), 0, start, end, out);
+	it = writeHextets(value.getLow(), IPV6_PARTS / 2, start, end, it);
+
+	return (size_t)(it - out);
+}
+
+/**
+ * @brief Writes an IPv6 address, reusing the text of the first half of the previous one if it is the same.
+ *
+ * The text of the first four hextets only depends on the high half of the
+ * address and on the run of zero hextets, so it is copied as a whole from the
+ * cache when both are those of the previous address, and rendered and cached
+ * otherwise. The last four hextets are always rendered.
+ *
+ * @param value The value of the address.
+ * @param out The buffer receiving the text, at least IPV6_MAX_LENGTH characters long.
+ * @return size_t The number of characters written.
+ */
+size_t IPv6Formatter::format(const UInt128& value, char* out)
+{
+	unsigned zeros = findZeroHextets(value);
+	int start = ZERO_RUNS.starts[zeros];
+	int end = ZERO_RUNS.ends[zeros];
+
+	// Render and cache the text of the first half if it differs from the previous one
+	if (value.getHigh() != _high || start != _start || end != _end)
+	{
+		_high = value.getHigh();
+		_start = (uint8_t)start;
+		_end = (uint8_t)end;
+		_headLength = (uint8_t)(writeHextets(_high, 0, start, end, _head) - _head);
+	}
+
+	// Copy the whole cache, the buffer being longer than it
+	memcpy(out, _head, IPV6_HEAD_MAX_LENGTH);
+
+	return (size_t)(writeHextets(value.getLow(), IPV6_PARTS / 2, start, end, out + _headLength) - out);
+}
+
+/**
+ * @brief Writes a batch of IPv4 addresses in dotted-decimal notation.
+ *
+ * @param values The values of the addresses.
+ * @param count The number of addresses.
+ * @param out The buffer receiving the texts, at least count * (IPV4_MAX_LENGTH + 1) characters long.
+ * @param separator The character written after each address.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv4Batch(const uint32_t* values, size_t count, char* out, char separator)
+{
+	char* it = out;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		it += formatIPv4(values[i], it);
+		*it++ = separator;
+	}
+
+	return (size_t)(it - out);
+}
+
+/**
+ * @brief Writes a batch of IPv6 addresses in colon-hexadecimal notation.
+ *
+ * @param values The values of the addresses.
+ * @param count The number of addresses.
+ * @param out The buffer receiving the texts, at least count * (IPV6_MAX_LENGTH + 1) characters long.
+ * @param separator The character written after each address.
+ * @return size_t The number of characters written.
+ */
+size_t formatIPv6Batch(const UInt128* values, size_t count, char* out, char separator)
+{
+	char* it = out;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		it += formatIPv6(values[i], it);
+		*it++ = separator;
+	}
+
+	return (size_t)(it - out);
+}
@@ -0,0 +1,31 @@
+#include "format/record_format.h"
+
+/**
+ * @brief Parses the name of an output format.
+ *
+ * @param name The name of the format: "table", "csv", "ndjson" or "binary".
+ * @param format The format, only set if the name is valid.
+ * @return bool True if the name is the name of a format, false otherwise.
+ */
+bool parseOutputFormat(const string& name, OutputFormat& format)
+{
+	static const pair<const char*, OutputFormat> formats[] =
+	{
+		{ "table", OutputFormat::Table },
+		{ "csv", OutputFormat::Csv },
+		{ "ndjson", OutputFormat::Ndjson },
+		{ "binary", OutputFormat::Binary }
+	};
+
+	// Look for the format with the given name
+	for (const auto& entry : formats)
+	{
+		if (name == entry.first)
+		{
+			format = entry.second;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,169 @@
+#include "format/table_format.h"
+#include "format/address_format.h"
+
+/**
+ * @brief The separator line of the table of IPv4 subnets.
+ */
+static const char IPV4_SEPARATOR[] = "+----------------------+-----------------------------------+---------------------+---------------+";
+
+/**
+ * @brief The title line of the table of IPv4 subnets.
+ */
+static const char IPV4_TITLE[] = "|        Subnet        |             Host Range            |      Broadcast      |    Capacity   |";
+
+/**
+ * @brief The separator line of the table of IPv6 subnets.
+ */
+static const char IPV6_SEPARATOR[] = "+------------------------------------------------+----------------------------------------------------------------------------------------+";
+
+/**
+ * @brief The title line of the table of IPv6 subnets.
+ */
+static const char IPV6_TITLE[] = "|                     Subnet                     |                                       Host Range                                       |";
+
+/**
+ * @brief Appends a string literal to a buffer.
+ *
+ * @param out The buffer receiving the literal.
+ * @param literal The literal to append.
+ */
+template <size_t N>
+static inline void appendLiteral(OutputBuffer& out, const char (&literal)[N])
+{
+	out.append(literal, N - 1);
+}
+
+/**
+ * @brief Appends a prefix length preceded by a slash.
+ *
+ * @param out The buffer receiving the prefix length.
+ * @param prefixLength The prefix length to append.
+ */
+static inline void appendPrefixLength(OutputBuffer& out, int prefixLength)
+{
+	char* it = out.reserve(DECIMAL_MAX_LENGTH + 1);
+
+	it[0] = '/';
+	out.commit(1 + formatDecimal((uint64_t)prefixLength, it + 1));
+}
+
+/**
+ * @brief Writes the header of the table of IPv4 subnets.
+ *
+ * @param out The buffer receiving the header.
+ */
+void writeIPv4TableHeader(OutputBuffer& out)
+{
+	appendLiteral(out, IPV4_SEPARATOR);
+	out.append('\n');
+	appendLiteral(out, IPV4_TITLE);
+	out.append('\n');
+	appendLiteral(out, IPV4_SEPARATOR);
+	out.append('\n');
+}
+
+/**
+ * @brief Writes a row of the table of IPv4 subnets.
+ *
+ * The addresses are padded to the width of their column, but the prefix length
+ * directly follows the network address and is not padded.
+ *
+ * @param out The buffer receiving the row.
+ * @param ip The network address of the subnet.
+ * @param prefixLength The prefix length of the subnet.
+ * @param firstIp The first host address of the subnet.
+ * @param lastIp The last host address of the subnet.
+ * @param broadcastIp The broadcast address of the subnet.
+ * @param capacity The number of addresses of the subnet.
+ */
+void writeIPv4TableRow(OutputBuffer& out, uint32_t ip, int prefixLength, uint32_t firstIp, uint32_t lastIp, uint32_t broadcastIp, uint64_t capacity)
+{
+	char text[DECIMAL_MAX_LENGTH];
+
+	// Write the network address and the prefix length
+	appendLiteral(out, "| ");
+	out.appendLeft(text, formatIPv4(ip, text), 17);
+	appendPrefixLength(out, prefixLength);
+	appendLiteral(out, " | ");
+
+	// Write the host range
+	out.appendLeft(text, formatIPv4(firstIp, text), 15);
+	appendLiteral(out, " - ");
+	out.appendLeft(text, formatIPv4(lastIp, text), 15);
+	appendLiteral(out, " | ");
+
+	// Write the broadcast address
+	out.appendLeft(text, formatIPv4(broadcastIp, text), 19);
+	appendLiteral(out, " | ");
+
+	// Write the capacity
+	out.appendRight(text, formatDecimal(capacity, text), 13);
+	appendLiteral(out, " |\n");
+}
+
+/**
+ * @brief Writes the footer of the table of IPv4 subnets, without a trailing newline.
+ *
+ * @param out The buffer receiving the footer.
+ */
+void writeIPv4TableFooter(OutputBuffer& out)
+{
+	appendLiteral(out, IPV4_SEPARATOR);
+}
+
+/**
+ * @brief Writes the header of the table of IPv6 subnets.
+ *
+ * @param out The buffer receiving the header.
+ */
+void writeIPv6TableHeader(OutputBuffer& out)
+{
+	appendLiteral(out, IPV6_SEPARATOR);
+	out.append('\n');
+	appendLiteral(out, IPV6_TITLE);
+	out.append('\n');
+	appendLiteral(out, IPV6_SEPARATOR);
+	out.append('\n');
+}
+
+/**
+ * @brief Writes a row of the table of IPv6 subnets.
+ *
+ * The addresses are padded to the width of their column, but the prefix length
+ * directly follows the network address and is not padded. Each column is
+ * written by its own formatter, per thread, so that consecutive rows share the
+ * text of the first half of their addresses.
+ *
+ * @param out The buffer receiving the row.
+ * @param ip The network address of the subnet.
+ * @param prefixLength The prefix length of the subnet.
+ * @param firstIp The first host address of the subnet.
+ * @param lastIp The last host address of the subnet.
+ */
+void writeIPv6TableRow(OutputBuffer& out, const UInt128& ip, int prefixLength, const UInt128& firstIp, const UInt128& lastIp)
+{
+	static thread_local IPv6Formatter formatters[3];
+	char text[IPV6_MAX_LENGTH];
+
+	// Write the network address and the prefix length
+	appendLiteral(out, "| ");
+	out.appendLeft(text, formatters[0].format(ip, text), 43);
+	appendPrefixLength(out, prefixLength);
+	appendLiteral(out, " | ");
+
+	// Write the host range
+	out.appendLeft(text, formatters[1].format(firstIp, text), 45);
+	appendLiteral(out, " - ");
+	out.appendLeft(text, formatters[2].format(lastIp, text), 30);
+	appendLiteral(out, " |\n");
+}
+
+/**
+ * @brief Writes the footer of the table of IPv6 subnets, without a trailing newline.
+ *
+ * @param out The buffer receiving the footer.
+ */
+void writeIPv6TableFooter(OutputBuffer& out)
+{
+	appendLiteral(out, IPV6_SEPARATOR);
+}
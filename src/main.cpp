@@ -1,75 +1,108 @@
-#include "utils/utils.h"
-#include "network/ipv4_network.h"
-#include "network/ipv6_network.h"
-#include <algorithm>
+#include "cli/cli.h"
+#include "utils/stats.h"
+#include <iostream>
 
-int main(int argc, char* argv[])
+/**
+ * @brief Ends the run, reporting its statistics to the standard error if requested.
+ *
+ * @param options The options of the run.
+ * @param status The exit status of the run.
+ * @return int The exit status.
+ */
+static int finish(const CliOptions& options, int status)
 {
-	// Check if the correct number of arguments is provided
-	if (argc < 3)
+	if (options.stats)
 	{
-		cerr << "Usage: " << argv[0] << " <IP address/prefix> <number of subnets>" << endl;
-		return 1;
+		cout.flush();
+		Stats::report(cerr);
 	}
 
-	// Store the IP address and number of subnets
-	vector<string> tokens = split(argv[1], "/");
-	int numSubnets = stoi(argv[2]);
+	return status;
+}
+
+int main(int argc, char* argv[])
+{
+	CliOptions options;
 
-	// Validate the IP address and prefix
-	if (tokens.size() != 2)
+	try
+	{
+		// Parse the options of the command line
+		options = parseOptions(argc, argv);
+	}
+	catch (const exception& e)
 	{
-		cerr << "Invalid IP address/prefix format. Use the format <IP address>/<prefix length>." << endl;
+		cerr << "Error: " << e.what() << endl;
 		return 1;
 	}
 
-	// Check if the IP address is IPv4 or IPv6
-	if (find(tokens[0].begin(), tokens[0].end(), ':') != tokens[0].end())
+	// Time and count the hot paths if requested
+	if (options.stats)
 	{
-		// IPv6 address
-		try
-		{
-			// Create an IPv6 address object
-			IPv6Address ip(tokens[0]);
-			
-			// Create an IPv6 network object
-			IPv6Network network(ip, stoi(tokens[1]));
+		Stats::enable();
+	}
 
-			// Segment the network into the specified number of subnets
-			network.segment(numSubnets);
+	// Check if the batch or the aggregation mode is requested
+	if (options.batch || options.aggregate)
+	{
+		// Speed up the standard streams, they are not mixed with C stdio
+		ios::sync_with_stdio(false);
 
-			// Print the network information
-			cout << network << endl;
-		}
-		catch (const exception& e)
+		size_t failures = 0;
+
+		// Read the input from the given file, mapped in memory if it is a regular file, or from the standard input
+		if (!options.inputFile.empty())
 		{
-			cerr << "Error: " << e.what() << endl;
-			return 1;
+			if (!tryRunInputFile(options.inputFile, cout, failures, options))
+			{
+				cerr << "Error: cannot open " << options.inputFile << "." << endl;
+				return finish(options, 1);
+			}
 		}
-	}
-	else
-	{
-		// IPv4 address
-		try
+		else
 		{
-			// Create an IPv4 address object
-			IPv4Address ip(tokens[0]);
+			failures = options.aggregate ? runAggregate(cin, cout, options) : runBatch(cin, cout, options);
+		}
 
-			// Create an IPv4 network object
-			IPv4Network network(ip, stoi(tokens[1]));
+		cout.flush();
 
-			// Segment the network into the specified number of subnets
-			network.segment(numSubnets);
+		return finish(options, failures == 0 ? 0 : 1);
+	}
+
+	// Check if the correct number of arguments is provided
+	if (options.arguments.size() < (options.plan.empty() ? 2u : 1u))
+	{
+		cerr << "Usage: " << argv[0] << " [--threads <count>] [--format <format>] [--stats] [--offset <index>] [--limit <count>] <IP address/prefix> <number of subnets>" << endl;
+		cerr << "       " << argv[0] << " [--threads <count>] [--format <format>] [--stats] --plan <levels> <IP address/prefix>" << endl;
+		cerr << "       " << argv[0] << " [--threads <count>] [--format <format>] [--stats] --batch [file]" << endl;
+		cerr << "       " << argv[0] << " [--threads <count>] [--format <format>] [--stats] --aggregate [file]" << endl;
+		return 1;
+	}
 
-			// Print the network information
-			cout << network << endl;
+	try
+	{
+		// Segment the network, once or level by level, and print its subnets
+		if (options.plan.empty())
+		{
+			runJob(options.arguments[0], options.arguments[1], cout, options);
 		}
-		catch (const exception& e)
+		else
 		{
-			cerr << "Error: " << e.what() << endl;
-			return 1;
+			runPlan(options.arguments[0], cout, options);
 		}
+
+		// Terminate the table, the records already end with a newline
+		if (options.format == OutputFormat::Table)
+		{
+			cout << '\n';
+		}
+
+		cout.flush();
 	}
-	
-	return 0;
-}
\ No newline at end of file
+	catch (const exception& e)
+	{
+		cerr << "Error: " << e.what() << endl;
+		return finish(options, 1);
+	}
+
+	return finish(options, 0);
+}
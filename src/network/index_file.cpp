@@ -0,0 +1,127 @@
+#include "network/index_file.h"
+
+/**
+ * @brief Creates the header of an index file, laying out its arrays.
+ *
+ * The addresses follow the header, then the prefix lengths, then the entries
+ * of the nodes, each array starting on INDEX_FILE_ALIGNMENT bytes.
+ *
+ * @param addressBits The number of bits of the addresses.
+ * @param addressSize The size of an address, in bytes.
+ * @param subnetCount The number of subnets.
+ * @param nodeCount The number of nodes of the trie, 0 for none.
+ * @param defaultSubnet The index of the subnet with an empty prefix, or PREFIX_TRIE_NONE.
+ * @return IndexFileHeader The header.
+ */
+IndexFileHeader makeIndexFileHeader(int addressBits, size_t addressSize, uint64_t subnetCount, uint64_t nodeCount, uint32_t defaultSubnet)
+{
+	IndexFileHeader header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, INDEX_FILE_MAGIC, sizeof(header.magic));
+
+	header.version = INDEX_FILE_VERSION;
+	header.byteOrder = INDEX_FILE_BYTE_ORDER;
+	header.addressBits = (uint32_t)addressBits;
+	header.stride = PREFIX_TRIE_STRIDE;
+	header.subnetCount = subnetCount;
+	header.nodeCount = nodeCount;
+	header.defaultSubnet = defaultSubnet;
+
+	// Lay out the arrays after the header
+	header.addressesOffset = alignIndexOffset(sizeof(header));
+	header.prefixLengthsOffset = alignIndexOffset(header.addressesOffset + subnetCount * addressSize);
+	header.nodesOffset = alignIndexOffset(header.prefixLengthsOffset + subnetCount);
+
+	return header;
+}
+
+/**
+ * @brief Checks if an array of an index file fits in its data.
+ *
+ * @param dataSize The size of the data, in bytes.
+ * @param offset The offset of the array, in bytes.
+ * @param count The number of elements of the array.
+ * @param elementSize The size of an element, in bytes.
+ * @return bool True if the array is empty, or aligned and ending within the data, false otherwise.
+ */
+static bool fitsIndexArray(size_t dataSize, uint64_t offset, uint64_t count, uint64_t elementSize)
+{
+	return count == 0 || (offset % INDEX_FILE_ALIGNMENT == 0 && offset <= dataSize && count <= (dataSize - offset) / elementSize);
+}
+
+/**
+ * @brief Checks the header of an index file held in memory.
+ *
+ * Only the header is read: the arrays are checked to fit in the data, but their
+ * contents are not, so checking a file takes constant time whatever its size.
+ *
+ * @param data The bytes of the file, such as the view of a mapped file.
+ * @param addressBits The number of bits of the addresses of the expected family.
+ * @param addressSize The size of an address of the expected family, in bytes.
+ * @return const IndexFileHeader& The header, at the start of the data.
+ * @throws std::invalid_argument If the data is not an index file of the family, of this version and of
+ *         this byte order, or if its arrays do not fit in the data.
+ */
+const IndexFileHeader& checkIndexFile(string_view data, int addressBits, size_t addressSize)
+{
+	// Check the alignment of the data, the arrays are used in place
+	if ((uintptr_t)data.data() % alignof(uint64_t) != 0)
+	{
+		throw invalid_argument("Invalid index file: the data must be aligned on " + to_string(alignof(uint64_t)) + " bytes.");
+	}
+
+	const IndexFileHeader& header = *(const IndexFileHeader*)data.data();
+
+	// Check the magic string, the version and the byte order
+	if (data.size() < sizeof(IndexFileHeader) || memcmp(header.magic, INDEX_FILE_MAGIC, sizeof(header.magic)) != 0)
+	{
+		throw invalid_argument("Invalid index file: not an index file.");
+	}
+
+	if (header.version != INDEX_FILE_VERSION)
+	{
+		throw invalid_argument("Invalid index file: unsupported version " + to_string(header.version) + ", expected " + to_string(INDEX_FILE_VERSION) + ".");
+	}
+
+	if (header.byteOrder != INDEX_FILE_BYTE_ORDER)
+	{
+		throw invalid_argument("Invalid index file: written on a machine of another byte order.");
+	}
+
+	// Check the family of the addresses and the layout of the trie
+	if (header.addressBits != (uint32_t)addressBits)
+	{
+		throw invalid_argument("Invalid index file: holds " + to_string(header.addressBits) + "-bit addresses, expected " + to_string(addressBits) + "-bit addresses.");
+	}
+
+	if (header.nodeCount > 0 && (header.stride != PREFIX_TRIE_STRIDE || header.subnetCount >= PREFIX_TRIE_NONE))
+	{
+		throw invalid_argument("Invalid index file: the trie does not have the layout of this version.");
+	}
+
+	// Check that the arrays fit in the data
+	if (!fitsIndexArray(data.size(), header.addressesOffset, header.subnetCount, addressSize)
+		|| !fitsIndexArray(data.size(), header.prefixLengthsOffset, header.subnetCount, 1)
+		|| !fitsIndexArray(data.size(), header.nodesOffset, header.nodeCount, (1u << PREFIX_TRIE_STRIDE) * sizeof(PrefixTrieEntry)))
+	{
+		throw invalid_argument("Invalid index file: truncated or corrupted.");
+	}
+
+	return header;
+}
+
+/**
+ * @brief Writes the zero bytes aligning an offset of an index file.
+ *
+ * @param out The buffer receiving the bytes.
+ * @param offset The offset reached in the file, updated to the aligned offset.
+ */
+void writeIndexPadding(OutputBuffer& out, uint64_t& offset)
+{
+	static const char zeros[INDEX_FILE_ALIGNMENT] = {};
+	uint64_t aligned = alignIndexOffset(offset);
+
+	out.append(zeros, (size_t)(aligned - offset));
+	offset = aligned;
+}
@@ -6,14 +6,18 @@
  * This constructor initializes the network with the specified IP address and prefix length.
  * It checks if the prefix length is compatible with the address type, initializes the IP address
  * and mask, applies the mask to the IP address, and calculates the first and last IP addresses
- * in the network.
+ * in the network. The addresses are cloned in the arena if one is given.
  *
  * @param ip The IP address to initialize the network with.
  * @param prefixLength The prefix length to initialize the network with.
+ * @param arena The arena from which the addresses are allocated, or nullptr to allocate them on the heap.
  * @throws std::invalid_argument If the prefix length is not compatible with the address type.
  */
-Network::Network(const IPAddress& ip, int prefixLength)
+Network::Network(const IPAddress& ip, int prefixLength, Arena* arena)
+	: _arenaAllocated(arena != nullptr)
 {
+	STATS_TIMER(StatsPhase::Network);
+
 	// Check if the prefix length is compatible with the address type
 	if (!ip.isPrefixLengthCompatible(prefixLength))
 	{
@@ -21,15 +25,19 @@ Network::Network(const IPAddress& ip, int prefixLength)
 	}
 	
 	// Initialize the IP address and mask
-	_ip = ip.clone();
-	_mask = Mask(prefixLength);
+	_ip = cloneAddress(ip, arena);
+
+	{
+		STATS_TIMER(StatsPhase::Mask);
+		_mask = Mask(prefixLength);
+	}
 
 	// Apply the mask to the IP address
 	(*_ip) &= _mask;
 
 	// Clone the IP address for the first and last addresses
-	_firstIp = _ip->clone();
-	_lastIp = _ip->clone();
+	_firstIp = cloneAddress(*_ip, arena);
+	_lastIp = cloneAddress(*_ip, arena);
 
 	// Calculate the first and last IP addresses in the network
 	++(*_firstIp);
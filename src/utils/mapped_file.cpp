@@ -0,0 +1,227 @@
+#include "utils/mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Constructs an object mapping no file.
+ */
+MappedFile::MappedFile()
+	: _data(nullptr), _size(0)
+#ifdef _WIN32
+	, _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+#endif
+{
+}
+
+/**
+ * @brief Destructor for the MappedFile class, unmapping the file.
+ */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifdef _WIN32
+
+/**
+ * @brief Maps a file in memory, unmapping the previous one.
+ *
+ * A file read sequentially is opened for a sequential scan, which makes the
+ * cache manager read ahead aggressively, and any other file for a random
+ * access, then the file is mapped read-only. An empty file cannot be mapped, so
+ * it is kept open with an empty view.
+ *
+ * @param path The path of the file.
+ * @param sequential Whether the file is read sequentially, like a text to parse, or randomly, like an index.
+ * @return bool True if the file is mapped, false if it cannot be opened or mapped.
+ */
+bool MappedFile::open(const string& path, bool sequential)
+{
+	close();
+
+	// Open the file for its access pattern
+	DWORD flags = sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(_file, &size))
+	{
+		close();
+		return false;
+	}
+
+	// An empty file has no mapping
+	if (size.QuadPart == 0)
+	{
+		return true;
+	}
+
+	// Map the whole file read-only
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (_mapping == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	_data = (const char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (_data == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	_size = (size_t)size.QuadPart;
+
+	return true;
+}
+
+/**
+ * @brief Unmaps the file, invalidating the view.
+ */
+void MappedFile::close()
+{
+	if (_data != nullptr)
+	{
+		UnmapViewOfFile(_data);
+	}
+
+	if (_mapping != nullptr)
+	{
+		CloseHandle(_mapping);
+	}
+
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_file);
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_mapping = nullptr;
+	_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+/**
+ * @brief Maps a file in memory, unmapping the previous one.
+ *
+ * The file is mapped read-only and private. The mapping of a file read
+ * sequentially is advised as such, which makes the kernel read ahead more and
+ * release the pages behind the parser sooner, and any other mapping as read
+ * randomly, which keeps the kernel from reading ahead of each lookup. The
+ * descriptor is closed as soon as the file is mapped, the mapping keeping the
+ * file alive. An empty file cannot be mapped, so it gets an empty view.
+ *
+ * @param path The path of the file.
+ * @param sequential Whether the file is read sequentially, like a text to parse, or randomly, like an index.
+ * @return bool True if the file is mapped, false if it cannot be opened or mapped.
+ */
+bool MappedFile::open(const string& path, bool sequential)
+{
+	close();
+
+	int descriptor = ::open(path.c_str(), O_RDONLY);
+
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	// Check that the file is a regular file, whose size is known
+	struct stat status;
+
+	if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+	{
+		::close(descriptor);
+		return false;
+	}
+
+	// An empty file has no mapping
+	if (status.st_size == 0)
+	{
+		::close(descriptor);
+		return true;
+	}
+
+	void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+	::close(descriptor);
+
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	// Tell the kernel how the file will be read, the advice is only a hint
+	madvise(data, (size_t)status.st_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+	_data = (const char*)data;
+	_size = (size_t)status.st_size;
+
+	return true;
+}
+
+/**
+ * @brief Unmaps the file, invalidating the view.
+ */
+void MappedFile::close()
+{
+	if (_data != nullptr)
+	{
+		munmap((void*)_data, _size);
+	}
+
+	_data = nullptr;
+	_size = 0;
+}
+
+#endif
+
+/**
+ * @brief Splits a text into chunks made of whole lines.
+ *
+ * Each chunk is cut at the first newline after chunkSize bytes, so only the end
+ * of one line is scanned to find its end.
+ *
+ * @param text The text to split.
+ * @param chunkSize The minimum size of a chunk in bytes, except for the last one.
+ * @return vector<string_view> The chunks, in order, empty if the text is empty.
+ */
+vector<string_view> splitLines(string_view text, size_t chunkSize)
+{
+	vector<string_view> chunks;
+	size_t start = 0;
+
+	chunkSize = (chunkSize == 0) ? 1 : chunkSize;
+
+	while (start < text.size())
+	{
+		// End the chunk after the newline ending its last line, or at the end of the text
+		size_t end = (text.size() - start <= chunkSize) ? string_view::npos : text.find('\n', start + chunkSize - 1);
+		end = (end == string_view::npos) ? text.size() : end + 1;
+
+		chunks.push_back(text.substr(start, end - start));
+		start = end;
+	}
+
+	return chunks;
+}
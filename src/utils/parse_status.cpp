@@ -0,0 +1,31 @@
+#include "utils/parse_status.h"
+
+/**
+ * @brief Retrieves the message of an error of an address of a family.
+ *
+ * @param status The error, as returned by the parsers or by the creation of a mask or a network.
+ * @param addressSize The number of octets of the addresses of the family, 4 for IPv4 and 16 for IPv6.
+ * @return const char* The message, the one the throwing constructors report, empty for ParseStatus::Success.
+ */
+const char* getParseStatusMessage(ParseStatus status, size_t addressSize)
+{
+	bool ipv4 = (addressSize == 4);
+
+	switch (status)
+	{
+		case ParseStatus::Success:
+			break;
+		case ParseStatus::InvalidPartCount:
+			return ipv4 ? "Invalid IPv4 address: must have 4 parts." : "Invalid address format: must have 8 parts.";
+		case ParseStatus::InvalidPart:
+			return ipv4 ? "Invalid IPv4 address: parts must be non-empty and contain only digits."
+				: "Invalid address format: hextets must be non-empty and contain only hexadecimal digits.";
+		case ParseStatus::PartOutOfRange:
+			return ipv4 ? "Invalid IPv4 address: parts must be between 0 and 255."
+				: "Invalid address format: hextets must be between 0x0000 and 0xFFFF.";
+		case ParseStatus::InvalidPrefixLength:
+			return "Prefix length is not compatible with address type.";
+	}
+
+	return "";
+}
@@ -0,0 +1,120 @@
+#include "utils/stats.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Resets the timings and the counters, then enables the instrumentation.
+ */
+void Stats::enable()
+{
+	for (int i = 0; i < STATS_PHASE_COUNT; ++i)
+	{
+		_calls[i].store(0, memory_order_relaxed);
+		_nanoseconds[i].store(0, memory_order_relaxed);
+	}
+
+	for (int i = 0; i < STATS_COUNTER_COUNT; ++i)
+	{
+		_counters[i].store(0, memory_order_relaxed);
+	}
+
+	_start = chrono::steady_clock::now();
+	_enabled.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the peak resident set size of the process.
+ *
+ * The size is the peak working set on Windows, and the maximum resident set
+ * size reported by getrusage(), in kilobytes on Linux, elsewhere.
+ *
+ * @return uint64_t The peak resident set size in bytes, 0 if it is not known.
+ */
+uint64_t Stats::getPeakResidentSize()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return 0;
+	}
+
+	return (uint64_t)counters.PeakWorkingSetSize;
+#else
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+
+#ifdef __APPLE__
+	return (uint64_t)usage.ru_maxrss;
+#else
+	return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+/**
+ * @brief Writes the per-phase breakdown, the counters, the wall time since enable() and the peak resident set size.
+ *
+ * Each phase is reported with its number of calls, its total time and its time
+ * per subnet computed by the segmentations, which is the figure to compare
+ * between runs of different sizes.
+ *
+ * @param s The output stream to which the report is written.
+ * @return ostream& A reference to the output stream.
+ */
+ostream& Stats::report(ostream& s)
+{
+#ifdef NO_STATS
+	return s << "Statistics: not available, the instrumentation is compiled out.\n";
+#else
+	static const char* phases[STATS_PHASE_COUNT] = { "parse", "mask", "network", "segment", "print" };
+
+	char line[128];
+	uint64_t subnets = getCount(StatsCounter::Subnets);
+	double wall = chrono::duration<double, milli>(chrono::steady_clock::now() - _start).count();
+
+	s << "Statistics:\n";
+
+	snprintf(line, sizeof(line), "  %-10s %14s %14s %14s\n", "phase", "calls", "time (ms)", "ns/subnet");
+	s << line;
+
+	// Write the breakdown of the phases
+	for (int i = 0; i < STATS_PHASE_COUNT; ++i)
+	{
+		uint64_t nanoseconds = _nanoseconds[i].load(memory_order_relaxed);
+		char perSubnet[32] = "-";
+
+		if (subnets > 0)
+		{
+			snprintf(perSubnet, sizeof(perSubnet), "%.2f", (double)nanoseconds / (double)subnets);
+		}
+
+		snprintf(line, sizeof(line), "  %-10s %14llu %14.3f %14s\n", phases[i],
+			(unsigned long long)_calls[i].load(memory_order_relaxed), (double)nanoseconds / 1e6, perSubnet);
+		s << line;
+	}
+
+	// Write the counters and the figures of the process
+	snprintf(line, sizeof(line), "  subnets: %llu, allocations: %llu, bytes written: %llu\n", (unsigned long long)subnets,
+		(unsigned long long)getCount(StatsCounter::Allocations), (unsigned long long)getCount(StatsCounter::BytesWritten));
+	s << line;
+
+	snprintf(line, sizeof(line), "  wall time: %.3f ms, peak RSS: %llu KiB\n", wall, (unsigned long long)(getPeakResidentSize() / 1024));
+	s << line;
+
+	return s;
+#endif
+}
@@ -1,5 +1,6 @@
 #include "utils/utils.h"
 #include <sstream>
+#include <stdexcept>
 
 /**
  * @brief Splits a string into a vector of substrings based on a specified delimiter.
@@ -28,4 +29,14 @@ vector<string> split(const string& s, const string& delimiter)
 	tokens.push_back(s.substr(start));
 
 	return tokens;
-}
\ No newline at end of file
+}
+/**
+ * @brief Throws the error of an index out of the range of a container.
+ *
+ * @param size The number of elements of the container.
+ * @throws std::out_of_range Always.
+ */
+void throwIndexOutOfRange(size_t size)
+{
+	throw out_of_range("Index out of range, must be between 0 and " + to_string((long long)size - 1) + ".");
+}
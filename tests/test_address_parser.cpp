@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "address/address_parser.h"
+
+TEST(AddressParser, ParseIPv4)
+{
+	// Arrange
+	uint32_t value = 0;
+
+	// Act
+	ParseStatus status = parseIPv4("192.168.1.254", value);
+
+	// Assert
+	EXPECT_EQ(status, ParseStatus::Success);
+	EXPECT_EQ(value, 0xC0A801FEu);
+}
+
+TEST(AddressParser, ParseIPv4Errors)
+{
+	// Arrange
+	uint32_t value = 42;
+
+	// Act & Assert
+	EXPECT_EQ(parseIPv4("1.2.3", value), ParseStatus::InvalidPartCount);
+	EXPECT_EQ(parseIPv4("1.x.3.4.5", value), ParseStatus::InvalidPartCount);
+	EXPECT_EQ(parseIPv4("1..3.4", value), ParseStatus::InvalidPart);
+	EXPECT_EQ(parseIPv4("1.2.3.4 ", value), ParseStatus::InvalidPart);
+	EXPECT_EQ(parseIPv4("256.x.3.4", value), ParseStatus::PartOutOfRange);
+	EXPECT_EQ(parseIPv4("1.2.3.99999999999", value), ParseStatus::PartOutOfRange);
+	EXPECT_EQ(value, 42u);
+}
+
+TEST(AddressParser, ParseIPv6)
+{
+	// Arrange
+	UInt128 full = 0;
+	UInt128 compressed = 0;
+	UInt128 leading = 0;
+	UInt128 any = 1;
+
+	// Act
+	ParseStatus status1 = parseIPv6("2001:0db8:85a3:0000:0000:8a2e:0370:7334", full);
+	ParseStatus status2 = parseIPv6("2001:DB8::8a2e:370:7334", compressed);
+	ParseStatus status3 = parseIPv6("::1", leading);
+	ParseStatus status4 = parseIPv6("::", any);
+
+	// Assert
+	EXPECT_EQ(status1, ParseStatus::Success);
+	EXPECT_EQ(status2, ParseStatus::Success);
+	EXPECT_EQ(status3, ParseStatus::Success);
+	EXPECT_EQ(status4, ParseStatus::Success);
+	EXPECT_EQ(full, UInt128(0x20010db885a30000ULL, 0x00008a2e03707334ULL));
+	EXPECT_EQ(compressed, UInt128(0x20010db800000000ULL, 0x00008a2e03707334ULL));
+	EXPECT_EQ(leading, UInt128(1));
+	EXPECT_EQ(any, UInt128(0));
+}
+
+TEST(AddressParser, ParseIPv6Errors)
+{
+	// Arrange
+	UInt128 value = 0;
+
+	// Act & Assert
+	EXPECT_EQ(parseIPv6("1:2:3:4:5:6:7", value), ParseStatus::InvalidPartCount);
+	EXPECT_EQ(parseIPv6("1::2::3", value), ParseStatus::InvalidPartCount);
+	EXPECT_EQ(parseIPv6("1:2:3:4:5:6:7:8:9::", value), ParseStatus::InvalidPartCount);
+	EXPECT_EQ(parseIPv6(":::", value), ParseStatus::InvalidPart);
+	EXPECT_EQ(parseIPv6("2001:db8::g", value), ParseStatus::InvalidPart);
+	EXPECT_EQ(parseIPv6("2001:db8::10000", value), ParseStatus::PartOutOfRange);
+}
+TEST(AddressParser, ParseBatch)
+{
+	// Arrange
+	string_view ipv4Texts[] = { "10.0.0.1", "10.0.0.256", "192.168.1.254" };
+	string_view ipv6Texts[] = { "2001:db8::1", "2001:db8:::1" };
+	uint32_t ipv4Values[3];
+	UInt128 ipv6Values[2];
+	ParseStatus statuses[3];
+
+	// Act
+	size_t ipv4Valid = parseIPv4Batch(ipv4Texts, 3, ipv4Values, statuses);
+	size_t ipv6Valid = parseIPv6Batch(ipv6Texts, 2, ipv6Values);
+
+	// Assert
+	EXPECT_EQ(ipv4Valid, 2u);
+	EXPECT_EQ(ipv4Values[0], 0x0A000001u);
+	EXPECT_EQ(ipv4Values[1], 0u);
+	EXPECT_EQ(ipv4Values[2], 0xC0A801FEu);
+	EXPECT_EQ(statuses[1], ParseStatus::PartOutOfRange);
+	EXPECT_EQ(ipv6Valid, 1u);
+	EXPECT_EQ(ipv6Values[0], UInt128(0x20010DB800000000ULL, 1));
+	EXPECT_EQ(ipv6Values[1], UInt128(0));
+}
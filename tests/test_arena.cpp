@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "utils/arena.h"
+#include "address/ipv4_address.h"
+
+TEST(Arena, Allocate)
+{
+	// Arrange
+	Arena arena(1024);
+
+	// Act
+	char* first = (char*)arena.allocate(1, 1);
+	uint64_t* second = (uint64_t*)arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+	char* large = (char*)arena.allocate(4096);
+
+	// Assert
+	EXPECT_EQ((uintptr_t)second % alignof(uint64_t), 0u);
+	EXPECT_GT((char*)second, first);
+	EXPECT_LE((char*)second - first, (ptrdiff_t)alignof(uint64_t));
+	EXPECT_NE(large, nullptr);
+	EXPECT_EQ(arena.getBlockCount(), 2u);
+}
+
+TEST(Arena, MisalignedTail)
+{
+	// Arrange
+	Arena arena(100);
+	Arena oversized(64);
+
+	// Act
+	char* block = (char*)arena.allocate(100, 1);
+	char* aligned = (char*)arena.allocate(8, 16);
+	char* large = (char*)oversized.allocate(65, 1);
+	char* next = (char*)oversized.allocate(8, 16);
+
+	// Assert
+	EXPECT_EQ(arena.getBlockCount(), 2u);
+	EXPECT_EQ((uintptr_t)aligned % 16, 0u);
+	EXPECT_TRUE(aligned + 8 <= block || aligned >= block + 100);
+	EXPECT_EQ(oversized.getBlockCount(), 2u);
+	EXPECT_EQ((uintptr_t)next % 16, 0u);
+	EXPECT_TRUE(next + 8 <= large || next >= large + 65);
+}
+
+TEST(Arena, CreateAndAdopt)
+{
+	// Arrange
+	Arena arena;
+	Arena other;
+	IPv4Address ip("10.1.2.3");
+
+	// Act
+	IPAddress* clone = ip.clone(other);
+	arena.allocate(16);
+	arena.adopt(other);
+
+	// Assert
+	EXPECT_EQ(clone->toString(), "10.1.2.3");
+	EXPECT_EQ(arena.getBlockCount(), 2u);
+	EXPECT_EQ(other.getBlockCount(), 0u);
+
+	clone->~IPAddress();
+}
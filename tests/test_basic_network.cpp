@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "network/basic_network.h"
+#include "network/ipv6_network.h"
+#include <sstream>
+
+TEST(BasicNetwork, Segment)
+{
+	// Arrange
+	BasicNetwork<IPv4Traits> network(0xC0A80017u, 24);
+
+	// Act
+	const SubnetRange<IPv4Traits>& subnets = network.segment(3);
+
+	// Assert
+	EXPECT_EQ(network.getNetwork().getValue(), 0xC0A80000u);
+	ASSERT_EQ(subnets.size(), 3u);
+	EXPECT_EQ(subnets.getPrefixLength(), 26);
+	EXPECT_EQ(subnets[2].getIp().toString(), "192.168.0.128");
+	EXPECT_THROW(network.segment(0), invalid_argument);
+	EXPECT_THROW(network.segment(257), invalid_argument);
+	EXPECT_EQ(network.getSubnets().size(), 3u);
+	EXPECT_THROW(BasicNetwork<IPv4Traits>(0u, 33), invalid_argument);
+}
+
+TEST(BasicNetwork, PrintMatchesFacade)
+{
+	// Arrange
+	BasicNetwork<IPv6Traits> engine(IPv6Address("2001:db8::").toUInt128(), 48);
+	IPv6Network network(IPv6Address("2001:db8::"), 48);
+	ostringstream engineOutput;
+	ostringstream networkOutput;
+
+	// Act
+	engine.segment(5);
+	network.segment(5);
+	engine.print(engineOutput);
+	network.print(networkOutput);
+
+	// Assert
+	EXPECT_EQ(engineOutput.str(), networkOutput.str());
+	EXPECT_NE(engineOutput.str().find("2001:db8:0:6000::"), string::npos);
+}
+
+TEST(BasicNetwork, LargePlan)
+{
+	// Arrange
+	BasicNetwork<IPv6Traits> network(IPv6Address("2001:db8::").toUInt128(), 32);
+	uint64_t count = 1ULL << 32;
+
+	// Act
+	SubnetRange<IPv6Traits> subnets = network.segmentRange(count);
+
+	// Assert
+	EXPECT_EQ(subnets.size(), count);
+	EXPECT_EQ(subnets.getPrefixLength(), 64);
+	EXPECT_EQ(subnets[count - 1].getIp().toString(), "2001:db8:ffff:ffff::");
+	EXPECT_EQ(network.getNetwork().getIp().calculateCapacity(32), UInt128(1ULL << 32, 0));
+	EXPECT_EQ(network.getNetwork().getIp().calculateCapacity(0), UInt128::lowBits(128));
+	EXPECT_EQ(BasicNetwork<IPv6Traits>(0, 96).checkSegment(count), SegmentStatus::Success);
+	EXPECT_EQ(BasicNetwork<IPv6Traits>(0, 96).checkSegment(count + 1), SegmentStatus::ExceedsCapacity);
+	EXPECT_EQ(BasicNetwork<IPv4Traits>(0u, 31).checkSegment(2), SegmentStatus::Success);
+}
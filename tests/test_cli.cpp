@@ -0,0 +1,362 @@
+#include <gtest/gtest.h>
+#include "cli/cli.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+TEST(Cli, RunJob)
+{
+	// Arrange
+	ostringstream output;
+
+	// Act
+	runJob("192.168.0.0/24", "2", output);
+
+	// Assert
+	EXPECT_NE(output.str().find("| 192.168.0.128    /25 |"), string::npos);
+	EXPECT_THROW(runJob("192.168.0.0", "2", output), invalid_argument);
+	EXPECT_THROW(runJob("192.168.0.0/24", "two", output), invalid_argument);
+}
+
+TEST(Cli, TryRunJob)
+{
+	// Arrange
+	ostringstream output;
+	ostringstream expected;
+	string error;
+
+	// Act
+	bool valid = tryRunJob("192.168.0.0/24", "2", output, error);
+	bool invalid = tryRunJob("192.168.0.0/33", "2", output, error);
+
+	// Assert
+	runJob("192.168.0.0/24", "2", expected);
+
+	EXPECT_TRUE(valid);
+	EXPECT_FALSE(invalid);
+	EXPECT_EQ(error, "Prefix length is not compatible with address type.");
+	EXPECT_EQ(output.str(), expected.str());
+	EXPECT_FALSE(tryRunJob("2001:db8::/32", "0", output, error));
+	EXPECT_EQ(error, "Number of subnets must be greater than 0.");
+}
+
+TEST(Cli, RunBatch)
+{
+	// Arrange
+	istringstream input("# jobs\n10.0.0.0/8 2\n\n10.0.0.0/8\n10.0.0/8 2\n  2001:db8::/32\t4\n");
+	ostringstream output;
+	ostringstream expected;
+
+	// Act
+	size_t failures = runBatch(input, output);
+
+	// Assert
+	runJob("10.0.0.0/8", "2", expected);
+	expected << "\nError: line 4: Invalid job format. Use the format <IP address>/<prefix length> <number of subnets>.\n";
+	expected << "Error: line 5: Invalid IPv4 address: must have 4 parts.\n";
+	runJob("2001:db8::/32", "4", expected);
+	expected << "\n";
+
+	EXPECT_EQ(failures, 2u);
+	EXPECT_EQ(output.str(), expected.str());
+}
+TEST(Cli, ParseOptions)
+{
+	// Arrange
+	const char* argv[] = { "network-segmenter", "--threads", "4", "10.0.0.0/8", "2" };
+	const char* batchArgv[] = { "network-segmenter", "--batch", "-", "--threads", "0" };
+	const char* invalidArgv[] = { "network-segmenter", "--threads", "four" };
+
+	// Act
+	CliOptions options = parseOptions(5, argv);
+	CliOptions batchOptions = parseOptions(5, batchArgv);
+
+	// Assert
+	EXPECT_FALSE(options.batch);
+	EXPECT_EQ(options.threadCount, 4u);
+	ASSERT_EQ(options.arguments.size(), 2u);
+	EXPECT_EQ(options.arguments[0], "10.0.0.0/8");
+	EXPECT_TRUE(batchOptions.batch);
+	EXPECT_TRUE(batchOptions.inputFile.empty());
+	EXPECT_EQ(batchOptions.threadCount, 0u);
+	EXPECT_THROW(parseOptions(3, invalidArgv), invalid_argument);
+}
+
+TEST(Cli, RunJobLargeCount)
+{
+	// Arrange
+	CliOptions options;
+	options.format = OutputFormat::Csv;
+	options.offset = 4294967295u;
+	options.limit = 1;
+	ostringstream output;
+	ostringstream unused;
+	string error;
+
+	// Act
+	runJob("2001:db8::/32", "4294967296", output, options);
+	bool tooLarge = tryRunJob("10.0.0.0/8", "18446744073709551616", unused, error, options);
+
+	// Assert
+	EXPECT_EQ(output.str(), "network,prefix_length,first_host,last_host\n2001:db8:ffff:ffff::,64,2001:db8:ffff:ffff::1,2001:db8:ffff:ffff:ffff:ffff:ffff:ffff\n");
+	EXPECT_FALSE(tooLarge);
+	EXPECT_EQ(error, "Invalid number of subnets: must be an integer between 1 and 18446744073709551615.");
+	EXPECT_THROW(runJob("10.0.0.0/8", "4294967296", unused, options), invalid_argument);
+}
+
+TEST(Cli, RunJobPage)
+{
+	// Arrange
+	const char* argv[] = { "network-segmenter", "--offset", "18446744073709551615", "--limit", "2", "10.0.0.0/8", "8" };
+	const char* invalidArgv[] = { "network-segmenter", "--offset", "18446744073709551616" };
+	CliOptions options;
+	ostringstream full;
+	ostringstream page;
+	ostringstream past;
+
+	// Act
+	CliOptions parsed = parseOptions(7, argv);
+	options.format = OutputFormat::Csv;
+	runJob("10.0.0.0/8", "8", full, options);
+	options.offset = 5;
+	options.limit = 2;
+	runJob("10.0.0.0/8", "8", page, options);
+	options.offset = 8;
+	runJob("10.0.0.0/8", "8", past, options);
+
+	// Assert
+	EXPECT_EQ(parsed.offset, UINT64_MAX);
+	EXPECT_EQ(parsed.limit, 2u);
+	EXPECT_THROW(parseOptions(3, invalidArgv), invalid_argument);
+	vector<string> rows;
+	istringstream lines(full.str());
+	for (string line; getline(lines, line);)
+	{
+		rows.push_back(line);
+	}
+	ASSERT_EQ(rows.size(), 9u);
+	EXPECT_EQ(page.str(), rows[0] + "\n" + rows[6] + "\n" + rows[7] + "\n");
+	EXPECT_EQ(past.str(), rows[0] + "\n");
+}
+
+TEST(Cli, RunPlan)
+{
+	// Arrange
+	const char* argv[] = { "network-segmenter", "--plan", "/16:2,/20", "10.0.0.0/8" };
+	const char* invalidArgv[] = { "network-segmenter", "--plan", "/16:0" };
+	ostringstream output;
+	ostringstream parallel;
+	ostringstream invalid;
+	string error;
+
+	// Act
+	CliOptions options = parseOptions(4, argv);
+	options.format = OutputFormat::Csv;
+	runPlan(options.arguments[0], output, options);
+	options.threadCount = 4;
+	runPlan(options.arguments[0], parallel, options);
+	options.plan = { { 4, 2 } };
+	bool succeeded = tryRunPlan("10.0.0.0/8", invalid, error, options);
+
+	// Assert
+	ASSERT_EQ(options.arguments.size(), 1u);
+	string rows = output.str();
+	EXPECT_EQ(count(rows.begin(), rows.end(), '\n'), 1 + 2 * (1 + 16));
+	EXPECT_EQ(rows.substr(0, rows.find('\n', rows.find('\n', rows.find('\n') + 1) + 1) + 1),
+		"network,prefix_length,first_host,last_host,broadcast\n10.0.0.0,16,10.0.0.1,10.0.255.254,10.0.255.255\n10.0.0.0,20,10.0.0.1,10.0.15.254,10.0.15.255\n");
+	EXPECT_EQ(parallel.str(), rows);
+	EXPECT_THROW(parseOptions(3, invalidArgv), invalid_argument);
+	EXPECT_FALSE(succeeded);
+	EXPECT_TRUE(invalid.str().empty());
+	EXPECT_THROW(runPlan("10.0.0.0/8", invalid, options), invalid_argument);
+}
+
+TEST(Cli, RunJobFormat)
+{
+	// Arrange
+	CliOptions options;
+	ostringstream csv;
+	ostringstream batch;
+	istringstream input("10.0.0.0/8 2\n2001:db8::/32 2\n");
+
+	// Act
+	options.format = OutputFormat::Csv;
+	runJob("10.0.0.0/8", "2", csv, options);
+	options.format = OutputFormat::Ndjson;
+	size_t failures = runBatch(input, batch, options);
+
+	// Assert
+	EXPECT_EQ(csv.str(), "network,prefix_length,first_host,last_host,broadcast\n10.0.0.0,9,10.0.0.1,10.127.255.254,10.127.255.255\n10.128.0.0,9,10.128.0.1,10.255.255.254,10.255.255.255\n");
+	EXPECT_EQ(failures, 0u);
+	string records = batch.str();
+	EXPECT_EQ(count(records.begin(), records.end(), '\n'), 4);
+}
+
+TEST(Cli, RunAggregate)
+{
+	// Arrange
+	istringstream input("# prefixes\n10.0.1.0/24\n2001:db8::/33\n10.0.0.0/24\n\n10.0.0.7/32\n2001:db8:8000::/33\n10.0.0.0/33\n10.0.0/8\n");
+	ostringstream output;
+
+	// Act
+	size_t failures = runAggregate(input, output);
+
+	// Assert
+	EXPECT_EQ(failures, 2u);
+	EXPECT_EQ(output.str(), "Error: line 8: Invalid prefix length: must be between 0 and 32.\nError: line 9: Invalid IPv4 address: must have 4 parts.\n10.0.0.0/23\n2001:db8::/32\n");
+}
+
+TEST(Cli, RunInMemory)
+{
+	// Arrange
+	ostringstream jobs;
+	ostringstream prefixes;
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		jobs << "10." << i % 256 << "." << i / 256 % 256 << ".0/24 " << (i % 7 == 0 ? "0" : "2") << "\n";
+		prefixes << "10." << i / 256 % 256 << "." << i % 256 << ".0/" << (i % 13 == 0 ? "33" : "24") << "\n";
+	}
+
+	CliOptions options;
+	options.format = OutputFormat::Csv;
+	options.threadCount = 4;
+
+	istringstream jobStream(jobs.str());
+	istringstream prefixStream(prefixes.str());
+	ostringstream expectedBatch, batch, expectedAggregate, aggregate;
+
+	// Act
+	size_t expectedBatchFailures = runBatch(jobStream, expectedBatch, options);
+	size_t batchFailures = runBatch(string_view(jobs.str()), batch, options);
+	size_t expectedAggregateFailures = runAggregate(prefixStream, expectedAggregate, options);
+	size_t aggregateFailures = runAggregate(string_view(prefixes.str()), aggregate, options);
+
+	// Assert
+	EXPECT_EQ(batchFailures, expectedBatchFailures);
+	EXPECT_EQ(batch.str(), expectedBatch.str());
+	EXPECT_EQ(aggregateFailures, expectedAggregateFailures);
+	EXPECT_EQ(aggregate.str(), expectedAggregate.str());
+	EXPECT_NE(aggregate.str().find("Error: line 99997: "), string::npos);
+}
+
+/**
+ * @brief A stream buffer keeping the characters written to it and the size of the largest write.
+ */
+class WriteSizeBuffer : public streambuf
+{
+public:
+	string text; ///< The characters written.
+	size_t largest = 0; ///< The number of characters of the largest write.
+
+protected:
+	streamsize xsputn(const char* data, streamsize count) override
+	{
+		text.append(data, (size_t)count);
+		largest = max(largest, (size_t)count);
+		return count;
+	}
+
+	int_type overflow(int_type c) override
+	{
+		if (!traits_type::eq_int_type(c, traits_type::eof()))
+		{
+			char character = traits_type::to_char_type(c);
+			xsputn(&character, 1);
+		}
+
+		return traits_type::not_eof(c);
+	}
+};
+
+TEST(Cli, RunInMemoryLargeJob)
+{
+	// Arrange
+	string comment = "# " + string(60, '-') + "\n";
+	string jobs;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		jobs += comment;
+	}
+
+	jobs += "10.0.0.0/8 524288\n10.0.0.0/33 2\n";
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		jobs += comment;
+	}
+
+	CliOptions options;
+	options.format = OutputFormat::Csv;
+	options.threadCount = 4;
+
+	istringstream jobStream(jobs);
+	ostringstream expected;
+	WriteSizeBuffer buffer;
+	ostream output(&buffer);
+
+	// Act
+	size_t expectedFailures = runBatch(jobStream, expected, options);
+	size_t failures = runBatch(string_view(jobs), output, options);
+
+	// Assert
+	EXPECT_EQ(failures, 1u);
+	EXPECT_EQ(failures, expectedFailures);
+	EXPECT_EQ(buffer.text, expected.str());
+	EXPECT_GT(buffer.text.size(), (size_t)16 << 20);
+	EXPECT_LT(buffer.largest, (size_t)4 << 20);
+}
+
+TEST(Cli, RunInputFile)
+{
+	// Arrange
+	string path = testing::TempDir() + "test_cli_jobs.txt";
+	string jobs = "10.0.0.0/24 2\n# comment\n10.0.0.0/24 0\n";
+	ofstream(path, ios::binary) << jobs;
+	istringstream jobStream(jobs);
+	ostringstream expected, regular, missing;
+	size_t regularFailures = 0;
+	size_t missingFailures = 0;
+	size_t expectedFailures = runBatch(jobStream, expected);
+
+	// Act
+	bool regularRun = tryRunInputFile(path, regular, regularFailures);
+	bool missingRun = tryRunInputFile(testing::TempDir() + "test_cli_missing.txt", missing, missingFailures);
+
+	// Assert
+	EXPECT_TRUE(regularRun);
+	EXPECT_EQ(regularFailures, expectedFailures);
+	EXPECT_EQ(regular.str(), expected.str());
+	EXPECT_FALSE(missingRun);
+	EXPECT_TRUE(missing.str().empty());
+
+	remove(path.c_str());
+
+#ifndef _WIN32
+	// Arrange
+	string fifo = testing::TempDir() + "test_cli_jobs.fifo";
+	ostringstream piped;
+	size_t pipedFailures = 0;
+	remove(fifo.c_str());
+	ASSERT_EQ(mkfifo(fifo.c_str(), 0600), 0);
+	thread writer([&]() { ofstream(fifo, ios::binary) << jobs; });
+
+	// Act
+	bool pipedRun = tryRunInputFile(fifo, piped, pipedFailures);
+	writer.join();
+
+	// Assert
+	EXPECT_TRUE(pipedRun);
+	EXPECT_EQ(pipedFailures, expectedFailures);
+	EXPECT_EQ(piped.str(), expected.str());
+
+	remove(fifo.c_str());
+#endif
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "network/index_file.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include "utils/mapped_file.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+TEST(IndexFile, WriteSegmentation)
+{
+	// Arrange
+	string path = testing::TempDir() + "test_index_file_segmentation.bin";
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	network.segment(1000);
+	{
+		ofstream out(path, ios::binary);
+		network.writeIndex(out);
+	}
+	MappedFile file;
+	ASSERT_TRUE(file.open(path, false));
+
+	// Act
+	PrefixIndex<IPv4Traits> index(file.getView());
+
+	// Assert
+	ASSERT_EQ(index.size(), 1000u);
+	EXPECT_FALSE(index.hasTrie());
+	EXPECT_EQ(index.find(IPv4Traits::toValue(IPv4Address("10.3.232.77"))), 15u);
+	EXPECT_EQ(index[15].getIp().toString(), network[15]->getIp()->toString());
+	EXPECT_EQ(index[999].getPrefixLength(), 18);
+	EXPECT_EQ(index.find(IPv4Traits::toValue(IPv4Address("10.250.0.0"))), index.size());
+	EXPECT_EQ(index.find(IPv4Traits::toValue(IPv4Address("9.255.255.255"))), index.size());
+	EXPECT_THROW(index[1000], out_of_range);
+
+	file.close();
+	remove(path.c_str());
+}
+
+TEST(IndexFile, WriteTrie)
+{
+	// Arrange
+	string path = testing::TempDir() + "test_index_file_trie.bin";
+	PrefixTrie<IPv6Traits> trie;
+	trie.insert(Subnet<IPv6Traits>(UInt128(0), 0));
+	trie.insert(Subnet<IPv6Traits>(UInt128(0x20010DB800000000ULL, 0), 32));
+	trie.insert(Subnet<IPv6Traits>(UInt128(0x20010DB812340000ULL, 0), 48));
+	trie.insert(Subnet<IPv6Traits>(UInt128(0x20010DB812345678ULL, 0), 64));
+	{
+		ofstream out(path, ios::binary);
+		writeIndexFile(out, trie);
+	}
+	MappedFile file;
+	ASSERT_TRUE(file.open(path, false));
+	UInt128 ips[] = { UInt128(0x20010DB812345678ULL, 1), UInt128(0x20010DB812340001ULL, 0), UInt128(0x20010DB8FFFF0000ULL, 0), UInt128(0xFE80000000000000ULL, 0) };
+	size_t indices[4];
+
+	// Act
+	PrefixIndex<IPv6Traits> index(file.getView());
+	index.find(ips, 4, indices, 2);
+
+	// Assert
+	ASSERT_EQ(index.size(), trie.size());
+	EXPECT_TRUE(index.hasTrie());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(indices[i], trie.find(ips[i]));
+	}
+	EXPECT_EQ(index[indices[0]].getPrefixLength(), 64);
+	EXPECT_EQ(index[indices[3]].getPrefixLength(), 0);
+
+	file.close();
+	remove(path.c_str());
+}
+
+TEST(IndexFile, InvalidData)
+{
+	// Arrange
+	ostringstream stream;
+	writeIndexFile(stream, SubnetRange<IPv4Traits>(0x0A000000u, 16, 256));
+	string bytes = stream.str();
+	vector<uint64_t> storage(bytes.size() / 8 + 1);
+	memcpy(storage.data(), bytes.data(), bytes.size());
+	string_view data((const char*)storage.data(), bytes.size());
+	IndexFileHeader* header = (IndexFileHeader*)storage.data();
+
+	// Act & Assert
+	EXPECT_EQ(PrefixIndex<IPv4Traits>(data).size(), 256u);
+	EXPECT_THROW(PrefixIndex<IPv6Traits>{ data }, invalid_argument);
+	EXPECT_THROW(PrefixIndex<IPv4Traits>(data.substr(0, data.size() - 1)), invalid_argument);
+	EXPECT_THROW(PrefixIndex<IPv4Traits>(data.substr(0, 16)), invalid_argument);
+	header->version = INDEX_FILE_VERSION + 1;
+	EXPECT_THROW(PrefixIndex<IPv4Traits>{ data }, invalid_argument);
+	header->version = INDEX_FILE_VERSION;
+	header->magic[0] = 'X';
+	EXPECT_THROW(PrefixIndex<IPv4Traits>{ data }, invalid_argument);
+}
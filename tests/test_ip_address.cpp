@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "address/ipv4_address.h"
+#include <climits>
 
 TEST(IPAddress, PreIncrementOperator)
 {
@@ -71,4 +72,60 @@ TEST(IPAddress, BitwiseOrOperator)
 
 	// Assert
 	EXPECT_EQ(ipv4[3], 255);
-}
\ No newline at end of file
+}
+
+TEST(IPAddress, IncrementCarry)
+{
+	// Arrange
+	IPv4Address ipv4("1.2.3.255");
+
+	// Act
+	++ipv4;
+
+	// Assert
+	EXPECT_EQ(ipv4.toString(), "1.2.4.0");
+}
+
+TEST(IPAddress, DecrementBorrow)
+{
+	// Arrange
+	IPv4Address ipv4("1.2.4.0");
+
+	// Act
+	ipv4 -= 1;
+
+	// Assert
+	EXPECT_EQ(ipv4.toString(), "1.2.3.255");
+}
+
+TEST(IPAddress, LowestOffset)
+{
+	// Arrange
+	IPv4Address decremented("0.0.0.0");
+	IPv4Address incremented("128.0.0.0");
+
+	// Act
+	decremented -= INT_MIN;
+	incremented += INT_MIN;
+
+	// Assert
+	EXPECT_EQ(decremented.toString(), "128.0.0.0");
+	EXPECT_EQ(incremented.toString(), "0.0.0.0");
+}
+
+TEST(IPAddress, UncheckedAccess)
+{
+	// Arrange
+	IPv4Address ipv4("192.168.10.254");
+	uint8_t octets[IPV4_NUM_OCTETS];
+
+	// Act
+	size_t count = ipv4.getOctets(octets);
+
+	// Assert
+	EXPECT_EQ(count, 4u);
+	EXPECT_EQ(octets[0], 192);
+	EXPECT_EQ(octets[3], 254);
+	EXPECT_EQ(ipv4.getOctetUnchecked(1), ipv4[1]);
+	EXPECT_THROW(ipv4[4], out_of_range);
+}
@@ -49,4 +49,35 @@ TEST(IPv4Address, IsPrefixLengthCompatible)
 	EXPECT_FALSE(compatible1);
 	EXPECT_TRUE(compatible2);
 	EXPECT_FALSE(compatible3);
-}
\ No newline at end of file
+}
+
+TEST(IPv4Address, IntegerValue)
+{
+	// Arrange
+	IPv4Address ipv4("1.2.3.4");
+
+	// Act
+	IPv4Address copy(ipv4.toUInt32());
+
+	// Assert
+	EXPECT_EQ(ipv4.toUInt32(), 0x01020304u);
+	EXPECT_EQ(copy.toString(), "1.2.3.4");
+}
+
+TEST(IPv4Address, TryParse)
+{
+	// Arrange
+	IPv4Address ipv4(0u);
+
+	// Act
+	ParseStatus valid = IPv4Address::tryParse("10.20.30.40", ipv4);
+	ParseStatus invalid = IPv4Address::tryParse("10.20.300.40", ipv4);
+
+	// Assert
+	EXPECT_EQ(valid, ParseStatus::Success);
+	EXPECT_EQ(invalid, ParseStatus::PartOutOfRange);
+	EXPECT_EQ(ipv4.toString(), "10.20.30.40");
+	EXPECT_EQ(IPv4Address::tryParse("10.20.30", ipv4), ParseStatus::InvalidPartCount);
+	EXPECT_STREQ(IPv4Address::getErrorMessage(invalid), "Invalid IPv4 address: parts must be between 0 and 255.");
+	EXPECT_THROW(IPv4Address("10.20.300.40"), invalid_argument);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "network/ipv4_network.h"
+#include <sstream>
 
 TEST(IPv4Network, Constructor)
 {
@@ -33,4 +34,102 @@ TEST(IPv4Network, Segment)
 
 	// Assert
 	EXPECT_EQ(4, (int)network.getSubnetCount());
-}
\ No newline at end of file
+	EXPECT_EQ(network.getSubnetUnchecked(3), network[3]);
+	EXPECT_EQ(network.getSubnetUnchecked(3)->getIp()->toString(), "1.2.3.192");
+	EXPECT_THROW(network[4], out_of_range);
+}
+
+TEST(IPv4Network, SegmentAgain)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+
+	// Act
+	network.segment(256);
+	network.segment(2);
+
+	// Assert
+	ASSERT_EQ(network.getSubnetCount(), 2u);
+	EXPECT_EQ(network[1]->getIp()->toString(), "192.168.0.128");
+	EXPECT_EQ(network[1]->getLastIp()->toString(), "192.168.0.254");
+	EXPECT_EQ(dynamic_cast<const IPv4Network*>(network[1])->getBroadcastIp()->toString(), "192.168.0.255");
+}
+
+TEST(IPv4Network, SegmentParallel)
+{
+	// Arrange
+	IPv4Address ip("10.0.0.0");
+	int prefixLength = 8;
+	IPv4Network serial(ip, prefixLength);
+	IPv4Network parallel(ip, prefixLength);
+
+	// Act
+	serial.segment(20000);
+	parallel.segment(20000, 4);
+
+	// Assert
+	ASSERT_EQ(serial.getSubnetCount(), parallel.getSubnetCount());
+
+	for (size_t i = 0; i < serial.getSubnetCount(); ++i)
+	{
+		EXPECT_EQ(serial[i]->getIp()->toString(), parallel[i]->getIp()->toString());
+		EXPECT_EQ(serial[i]->getPrefixLength(), parallel[i]->getPrefixLength());
+	}
+}
+
+TEST(IPv4Network, TryCreate)
+{
+	// Arrange
+	IPv4Address ip("10.0.0.0");
+	unique_ptr<IPv4Network> network;
+
+	// Act
+	ParseStatus invalid = IPv4Network::tryCreate(ip, 33, network);
+	ParseStatus valid = IPv4Network::tryCreate(ip, 30, network);
+
+	// Assert
+	EXPECT_EQ(invalid, ParseStatus::InvalidPrefixLength);
+	EXPECT_EQ(valid, ParseStatus::Success);
+	ASSERT_NE(network, nullptr);
+	EXPECT_EQ(network->checkSegment(4), SegmentStatus::Success);
+	EXPECT_EQ(network->checkSegment(0), SegmentStatus::NoSubnets);
+	EXPECT_EQ(network->checkSegment(5), SegmentStatus::ExceedsCapacity);
+	EXPECT_THROW(network->segment(5), invalid_argument);
+}
+
+TEST(IPv4Network, Move)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	network.segment(1024);
+	const Network* subnet = network[1023];
+	vector<IPv4Network> networks;
+	ostringstream table;
+	ostringstream empty;
+
+	// Act
+	networks.push_back(move(network));
+	networks.emplace_back(IPv4Address("192.168.0.0"), 24);
+	IPv4Network assigned(IPv4Address("172.16.0.0"), 12);
+	assigned.segment(16);
+	assigned = move(networks[0]);
+	assigned.print(table);
+	network.print(empty);
+
+	// Assert
+	EXPECT_FALSE(is_copy_constructible<IPv4Network>::value);
+	EXPECT_TRUE(is_nothrow_move_constructible<IPv4Network>::value);
+	ASSERT_EQ(assigned.getSubnetCount(), 1024u);
+	EXPECT_EQ(assigned[1023], subnet);
+	EXPECT_EQ(assigned.getIp()->toString(), "10.0.0.0");
+	EXPECT_EQ(assigned.getBroadcastIp()->toString(), "10.255.255.255");
+	EXPECT_EQ(networks[0].getIp(), nullptr);
+	EXPECT_EQ(networks[0].getBroadcastIp(), nullptr);
+	EXPECT_EQ(networks[0].getSubnetCount(), 0u);
+	EXPECT_EQ(networks[1].getLastIp()->toString(), "192.168.0.254");
+	EXPECT_EQ(network.getIp(), nullptr);
+	EXPECT_EQ(network.getSubnetCount(), 0u);
+	string rows = table.str();
+	string header = empty.str();
+	EXPECT_EQ(count(rows.begin(), rows.end(), '\n'), count(header.begin(), header.end(), '\n') + 1024);
+}
@@ -71,4 +71,40 @@ TEST(IPv6Address, SumIncrementOperator)
 
 	// Assert
 	EXPECT_EQ(ipv6.toString(), "2001:db8:85a3::8a2e:370:7335");
-}
\ No newline at end of file
+}
+
+TEST(IPv6Address, IntegerValue)
+{
+	// Arrange
+	IPv6Address ipv6("2001:db8::1");
+
+	// Act
+	UInt128 value = ipv6.toUInt128();
+	IPv6Address copy(value + 1);
+
+	// Assert
+	EXPECT_EQ(value, UInt128(0x20010db800000000ULL, 1));
+	EXPECT_EQ(copy.toString(), "2001:db8::2");
+}
+
+TEST(IPv6Address, UncheckedAccess)
+{
+	// Arrange
+	IPv6Address ipv6("2001:db8:0:0:8:800:200c:417a");
+	uint16_t hextets[IPV6_NUM_HEXTETS];
+	uint8_t octets[IPV6_NUM_OCTETS];
+
+	// Act
+	ipv6.getHextets(hextets);
+	ipv6.getOctets(octets);
+
+	// Assert
+	EXPECT_EQ(hextets[0], 0x2001);
+	EXPECT_EQ(hextets[4], 0x0008);
+	EXPECT_EQ(hextets[7], 0x417a);
+	EXPECT_EQ(octets[8], 0x00);
+	EXPECT_EQ(octets[9], 0x08);
+	EXPECT_EQ(octets[15], 0x7a);
+	EXPECT_EQ(ipv6.getHextetUnchecked(5), ipv6[5]);
+	EXPECT_THROW(ipv6[8], out_of_range);
+}
@@ -16,7 +16,7 @@ TEST(IPv6Network, Constructor)
 	// Assert
 	EXPECT_EQ("2001:db8:85a3::", ipAddr->toString());
 	EXPECT_EQ("2001:db8:85a3::1", firstIp->toString());
-	EXPECT_EQ("2001:db8:85a3::ffff:ffff:ffff:ffff", lastIp->toString());
+	EXPECT_EQ("2001:db8:85a3:0:ffff:ffff:ffff:ffff", lastIp->toString());
 }
 
 TEST(IPv6Network, Segment)
@@ -31,4 +31,46 @@ TEST(IPv6Network, Segment)
 
 	// Assert
 	EXPECT_EQ(4, (int)network.getSubnetCount());
-}
\ No newline at end of file
+}
+
+TEST(IPv6Network, SegmentAddresses)
+{
+	// Arrange
+	IPv6Address ip("2001:db8::");
+	int prefixLength = 48;
+	IPv6Network network(ip, prefixLength);
+
+	// Act
+	network.segment(65536);
+
+	// Assert
+	EXPECT_EQ(65536, (int)network.getSubnetCount());
+	EXPECT_EQ("2001:db8::", network[0]->getIp()->toString());
+	EXPECT_EQ("2001:db8:0:1::", network[1]->getIp()->toString());
+	EXPECT_EQ("2001:db8:0:1234::", network[0x1234]->getIp()->toString());
+	EXPECT_EQ("2001:db8:0:ffff::", network[65535]->getIp()->toString());
+	EXPECT_EQ(64, network[65535]->getPrefixLength());
+}
+
+TEST(IPv6Network, Move)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 48);
+	network.segment(256);
+	const Network* subnet = network[255];
+
+	// Act
+	IPv6Network moved(move(network));
+	IPv6Network assigned(IPv6Address("fe80::"), 10);
+	assigned.segment(4);
+	assigned = move(moved);
+
+	// Assert
+	ASSERT_EQ(assigned.getSubnetCount(), 256u);
+	EXPECT_EQ(assigned[255], subnet);
+	EXPECT_EQ(assigned.segmentRange(256)[255].getIp().toString(), "2001:db8:0:ff00::");
+	EXPECT_EQ(moved.getIp(), nullptr);
+	EXPECT_EQ(moved.getLastIp(), nullptr);
+	EXPECT_EQ(moved.getSubnetCount(), 0u);
+	EXPECT_EQ(network.getSubnetCount(), 0u);
+}
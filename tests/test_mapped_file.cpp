@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "utils/mapped_file.h"
+#include <cstdio>
+#include <fstream>
+
+TEST(MappedFile, Open)
+{
+	// Arrange
+	string path = testing::TempDir() + "test_mapped_file.txt";
+	string empty = testing::TempDir() + "test_mapped_file_empty.txt";
+	ofstream(path, ios::binary) << "10.0.0.0/8 2\n2001:db8::/32 4\n";
+	ofstream(empty, ios::binary);
+	MappedFile file;
+	MappedFile emptyFile;
+	MappedFile missingFile;
+
+	// Act
+	bool opened = file.open(path);
+	bool emptyOpened = emptyFile.open(empty);
+	bool missingOpened = missingFile.open(testing::TempDir() + "test_mapped_file_missing.txt");
+
+	// Assert
+	EXPECT_TRUE(opened);
+	EXPECT_EQ(file.getView(), "10.0.0.0/8 2\n2001:db8::/32 4\n");
+	EXPECT_EQ(file.getSize(), 29u);
+	EXPECT_TRUE(emptyOpened);
+	EXPECT_TRUE(emptyFile.getView().empty());
+	EXPECT_FALSE(missingOpened);
+	EXPECT_EQ(missingFile.getSize(), 0u);
+
+	file.close();
+	EXPECT_TRUE(file.getView().empty());
+
+	remove(path.c_str());
+	remove(empty.c_str());
+}
+
+TEST(MappedFile, SplitLines)
+{
+	// Arrange
+	string_view text = "aaa\nbb\nc\n\ndddd\neee";
+
+	// Act
+	vector<string_view> chunks = splitLines(text, 3);
+	vector<string_view> whole = splitLines(text, 100);
+
+	// Assert
+	ASSERT_EQ(chunks.size(), 5u);
+	EXPECT_EQ(chunks[0], "aaa\n");
+	EXPECT_EQ(chunks[1], "bb\n");
+	EXPECT_EQ(chunks[2], "c\n\n");
+	EXPECT_EQ(chunks[3], "dddd\n");
+	EXPECT_EQ(chunks[4], "eee");
+	ASSERT_EQ(whole.size(), 1u);
+	EXPECT_EQ(whole[0], text);
+	EXPECT_TRUE(splitLines("").empty());
+}
@@ -36,4 +36,72 @@ TEST(Mask, OperatorNot)
 	EXPECT_EQ(octet0, 0);
 	EXPECT_EQ(octet1, 0);
 	EXPECT_EQ(octet2, 0);
-}
\ No newline at end of file
+}
+TEST(Mask, PartialOctet)
+{
+	// Arrange
+	Mask mask(20);
+
+	// Act
+	Mask notMask = ~mask;
+
+	// Assert
+	EXPECT_EQ(mask.getSize(), 3u);
+	EXPECT_EQ(mask[2], 0xF0);
+	EXPECT_EQ(notMask[2], 0x0F);
+	EXPECT_EQ(mask.toString(), "255.255.240");
+	EXPECT_EQ(mask.getOctetUnchecked(1), 0xFF);
+	EXPECT_THROW(mask[3], out_of_range);
+	EXPECT_THROW(Mask(0), invalid_argument);
+	EXPECT_THROW(Mask(129), invalid_argument);
+}
+
+TEST(Mask, ToValue)
+{
+	// Arrange
+	constexpr Mask mask(20);
+	constexpr Mask ipv6Mask(64);
+
+	// Act
+	constexpr UInt128 networkMask = mask.toValue(4, false);
+	constexpr UInt128 hostMask = (~mask).toValue(4, true);
+
+	// Assert
+	static_assert(networkMask == UInt128(0xFFFFF000u), "The mask is computed at compile time");
+	EXPECT_EQ(hostMask, UInt128(0x00000FFFu));
+	EXPECT_EQ((~mask).toValue(4, false), UInt128(0x00000F00u));
+	EXPECT_EQ(mask.toValue(4, true), UInt128(0xFFFFF0FFu));
+	EXPECT_EQ(ipv6Mask.toValue(16, false), UInt128(~0ULL, 0));
+	EXPECT_EQ(MASK_TABLE.masks[128], UInt128(~0ULL, ~0ULL));
+	EXPECT_EQ(MASK_TABLE.complements[0], UInt128(~0ULL, ~0ULL));
+}
+
+TEST(Mask, GetOctets)
+{
+	// Arrange
+	Mask mask(26);
+	uint8_t octets[16];
+
+	// Act
+	size_t count = (~mask).getOctets(octets);
+
+	// Assert
+	EXPECT_EQ(count, 4u);
+	EXPECT_EQ(octets[0], 0x00);
+	EXPECT_EQ(octets[3], 0x3F);
+}
+
+TEST(Mask, TryCreate)
+{
+	// Arrange
+	Mask mask;
+
+	// Act
+	ParseStatus valid = Mask::tryCreate(24, mask);
+	ParseStatus invalid = Mask::tryCreate(129, mask);
+
+	// Assert
+	EXPECT_EQ(valid, ParseStatus::Success);
+	EXPECT_EQ(invalid, ParseStatus::InvalidPrefixLength);
+	EXPECT_EQ(mask.getPrefixLength(), 24);
+}
@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+#include "utils/parse_status.h"
+#include "mask/mask.h"
+
+TEST(ParseStatus, Messages)
+{
+	// Arrange
+	Mask mask;
+
+	// Act
+	ParseStatus status = Mask::tryCreate(0, mask);
+
+	// Assert
+	EXPECT_EQ(status, ParseStatus::InvalidPrefixLength);
+	EXPECT_STREQ(getParseStatusMessage(status, 4), "Prefix length is not compatible with address type.");
+	EXPECT_STREQ(getParseStatusMessage(ParseStatus::InvalidPartCount, 4), "Invalid IPv4 address: must have 4 parts.");
+	EXPECT_STREQ(getParseStatusMessage(ParseStatus::InvalidPartCount, 16), "Invalid address format: must have 8 parts.");
+	EXPECT_STREQ(getParseStatusMessage(ParseStatus::Success, 16), "");
+}
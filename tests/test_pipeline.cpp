@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "format/pipeline.h"
+#include "network/basic_network.h"
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Range of subnets recording the threads its subnets are computed on.
+ */
+struct ThreadRecordingRange
+{
+	struct iterator
+	{
+		SubnetRange<IPv4Traits>::iterator it;
+		const ThreadRecordingRange* range;
+
+		Subnet<IPv4Traits> operator *() const
+		{
+			lock_guard<mutex> guard(range->lock);
+			range->threads.insert(this_thread::get_id());
+
+			return *it;
+		}
+
+		iterator& operator ++()
+		{
+			++it;
+			return *this;
+		}
+
+		iterator operator +(int64_t offset) const
+		{
+			return { it + offset, range };
+		}
+	};
+
+	SubnetRange<IPv4Traits> subnets;
+	mutable mutex lock;
+	mutable set<thread::id> threads;
+
+	uint64_t size() const
+	{
+		return subnets.size();
+	}
+
+	iterator begin() const
+	{
+		return { subnets.begin(), this };
+	}
+};
+
+TEST(Pipeline, WriteTable)
+{
+	// Arrange
+	BasicNetwork<IPv4Traits> network(0x0A000000u, 8);
+	BasicNetwork<IPv4Traits> unsegmented(0x0A000000u, 8);
+	network.segment(3 * PIPELINE_CHUNK_SIZE + 5);
+	ostringstream expected, expectedEmpty, single, parallel, empty;
+	network.print(expected);
+	unsegmented.print(expectedEmpty);
+
+	// Act
+	writePipelined(single, network.getSubnets(), OutputFormat::Table);
+	writePipelined(parallel, network.getSubnets(), OutputFormat::Table, 3);
+	writePipelined(empty, unsegmented.getSubnets(), OutputFormat::Table, 3);
+
+	// Assert
+	EXPECT_EQ(single.str(), expected.str());
+	EXPECT_EQ(parallel.str(), expected.str());
+	EXPECT_EQ(empty.str(), expectedEmpty.str());
+}
+
+TEST(Pipeline, SingleThread)
+{
+	// Arrange
+	BasicNetwork<IPv4Traits> network(0x0A000000u, 8);
+	ThreadRecordingRange range{ network.segmentRange(3 * PIPELINE_CHUNK_SIZE + 5), {}, {} };
+	ostringstream expected, output;
+	writePipelined(expected, range.subnets, OutputFormat::Csv, 3);
+
+	// Act
+	writePipelinedRange<IPv4Traits>(output, range, OutputFormat::Csv, 1);
+
+	// Assert
+	EXPECT_EQ(output.str(), expected.str());
+	EXPECT_EQ(range.threads, set<thread::id>({ this_thread::get_id() }));
+}
+
+TEST(Pipeline, WriteRecords)
+{
+	// Arrange
+	BasicNetwork<IPv6Traits> network(UInt128(0x20010DB800000000ULL, 0), 32);
+	SubnetRange<IPv6Traits> range = network.segmentRange(2 * PIPELINE_CHUNK_SIZE + 1);
+
+	for (OutputFormat format : { OutputFormat::Csv, OutputFormat::Ndjson, OutputFormat::Binary })
+	{
+		ostringstream expected, output;
+
+		{
+			OutputBuffer out(expected);
+			writeRecords(out, range, format);
+		}
+
+		// Act
+		writePipelined(output, range, format, 2);
+
+		// Assert
+		EXPECT_EQ(output.str(), expected.str());
+	}
+}
+
+TEST(Pipeline, MemoryBuffer)
+{
+	// Arrange
+	OutputBuffer out(4);
+
+	// Act
+	out.append("subnet", 6);
+	out.append('\n');
+	out.flush();
+
+	// Assert
+	EXPECT_EQ(string(out.data(), out.size()), "subnet\n");
+
+	out.clear();
+	EXPECT_EQ(out.size(), 0u);
+}
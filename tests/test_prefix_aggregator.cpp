@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "network/prefix_aggregator.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(PrefixAggregator, MergeSiblings)
+{
+	// Arrange
+	vector<Subnet<IPv4Traits>> prefixes = {
+		Subnet<IPv4Traits>(0x0A000080u, 25),
+		Subnet<IPv4Traits>(0x0A000100u, 24),
+		Subnet<IPv4Traits>(0x0A000000u, 25),
+		Subnet<IPv4Traits>(0x0A000300u, 24)
+	};
+
+	// Act
+	vector<Subnet<IPv4Traits>> result = aggregate(prefixes);
+
+	// Assert
+	ASSERT_EQ(result.size(), 2u);
+	EXPECT_EQ(result[0], Subnet<IPv4Traits>(0x0A000000u, 23));
+	EXPECT_EQ(result[1], Subnet<IPv4Traits>(0x0A000300u, 24));
+}
+
+TEST(PrefixAggregator, RemoveContained)
+{
+	// Arrange
+	vector<Subnet<IPv4Traits>> prefixes = {
+		Subnet<IPv4Traits>(0xC0A80105u, 32),
+		Subnet<IPv4Traits>(0xC0A80000u, 16),
+		Subnet<IPv4Traits>(0xC0A80000u, 16),
+		Subnet<IPv4Traits>(0xC0A80200u, 24),
+		Subnet<IPv4Traits>(0xC0A90000u, 24)
+	};
+
+	// Act
+	vector<Subnet<IPv4Traits>> result = aggregate(prefixes);
+
+	// Assert
+	ASSERT_EQ(result.size(), 2u);
+	EXPECT_EQ(result[0], Subnet<IPv4Traits>(0xC0A80000u, 16));
+	EXPECT_EQ(result[1], Subnet<IPv4Traits>(0xC0A90000u, 24));
+}
+
+TEST(PrefixAggregator, InverseOfSegment)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+	PrefixAggregator<IPv6Traits> aggregator(100);
+
+	// Act
+	for (const Subnet<IPv6Traits>& subnet : network.segmentRange(1024))
+	{
+		aggregator.add(subnet);
+	}
+
+	const vector<Subnet<IPv6Traits>>& result = aggregator.result();
+
+	// Assert
+	ASSERT_EQ(result.size(), 1u);
+	EXPECT_EQ(result[0].getIp().toString(), "2001:db8::");
+	EXPECT_EQ(result[0].getPrefixLength(), 32);
+}
+
+TEST(PrefixAggregator, Chunks)
+{
+	// Arrange
+	PrefixAggregator<IPv4Traits> aggregator(3);
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+
+	// Act
+	for (uint32_t i = 0; i < 256; i += 2)
+	{
+		aggregator.add(Subnet<IPv4Traits>(0x0A000000u + (i << 8), 24));
+	}
+
+	for (uint32_t i = 1; i < 255; i += 2)
+	{
+		aggregator.add(Subnet<IPv4Traits>(0x0A000000u + (i << 8), 24));
+	}
+
+	aggregator.add(network);
+
+	// Assert
+	ASSERT_EQ(aggregator.result().size(), 1u);
+	EXPECT_EQ(aggregator.result()[0], Subnet<IPv4Traits>(0x0A000000u, 8));
+}
+
+TEST(PrefixAggregator, FullAddressSpace)
+{
+	// Arrange
+	vector<Subnet<IPv4Traits>> prefixes = {
+		Subnet<IPv4Traits>(0x80000000u, 1),
+		Subnet<IPv4Traits>(0x00000000u, 1)
+	};
+
+	// Act
+	vector<Subnet<IPv4Traits>> result = aggregate(prefixes);
+
+	// Assert
+	ASSERT_EQ(result.size(), 1u);
+	EXPECT_EQ(result[0], Subnet<IPv4Traits>(0u, 0));
+	EXPECT_TRUE(aggregate(vector<Subnet<IPv4Traits>>()).empty());
+}
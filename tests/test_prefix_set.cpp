@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "network/prefix_set.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(PrefixSet, Normalize)
+{
+	// Arrange
+	vector<Subnet<IPv4Traits>> prefixes = {
+		Subnet<IPv4Traits>(0x0A000100u, 24),
+		Subnet<IPv4Traits>(0x0A000000u, 24),
+		Subnet<IPv4Traits>(0x0A000180u, 25),
+		Subnet<IPv4Traits>(0x0A000300u, 24)
+	};
+
+	// Act
+	PrefixSet<IPv4Traits> set(prefixes);
+
+	// Assert
+	ASSERT_EQ(set.getIntervals().size(), 2u);
+	EXPECT_EQ(set.getIntervals()[0].first, 0x0A000000u);
+	EXPECT_EQ(set.getIntervals()[0].last, 0x0A0001FFu);
+	EXPECT_EQ(set.getIntervals()[1].first, 0x0A000300u);
+	EXPECT_TRUE(set.contains(0x0A000305u));
+	EXPECT_FALSE(set.contains(0x0A000200u));
+	EXPECT_FALSE(set.contains(0x09FFFFFFu));
+}
+
+TEST(PrefixSet, Operations)
+{
+	// Arrange
+	PrefixSet<IPv4Traits> a(vector<Subnet<IPv4Traits>>{ Subnet<IPv4Traits>(0x0A000000u, 16), Subnet<IPv4Traits>(0x0A020000u, 16) });
+	PrefixSet<IPv4Traits> b(vector<Subnet<IPv4Traits>>{ Subnet<IPv4Traits>(0x0A008000u, 17), Subnet<IPv4Traits>(0x0A010000u, 16), Subnet<IPv4Traits>(0x0A020000u, 17) });
+	PrefixSet<IPv4Traits> c(Subnet<IPv4Traits>(0x0B000000u, 8));
+
+	// Act
+	vector<Subnet<IPv4Traits>> united = a.unite(b).toPrefixes();
+	vector<Subnet<IPv4Traits>> intersected = a.intersect(b).toPrefixes();
+	vector<Subnet<IPv4Traits>> subtracted = a.subtract(b).toPrefixes();
+
+	// Assert
+	ASSERT_EQ(united.size(), 2u);
+	EXPECT_EQ(united[0], Subnet<IPv4Traits>(0x0A000000u, 15));
+	EXPECT_EQ(united[1], Subnet<IPv4Traits>(0x0A020000u, 16));
+	ASSERT_EQ(intersected.size(), 2u);
+	EXPECT_EQ(intersected[0], Subnet<IPv4Traits>(0x0A008000u, 17));
+	EXPECT_EQ(intersected[1], Subnet<IPv4Traits>(0x0A020000u, 17));
+	ASSERT_EQ(subtracted.size(), 2u);
+	EXPECT_EQ(subtracted[0], Subnet<IPv4Traits>(0x0A000000u, 17));
+	EXPECT_EQ(subtracted[1], Subnet<IPv4Traits>(0x0A028000u, 17));
+	EXPECT_TRUE(a.overlaps(b));
+	EXPECT_FALSE(a.overlaps(c));
+	EXPECT_TRUE(a.intersect(c).empty());
+}
+
+TEST(PrefixSet, ToPrefixes)
+{
+	// Arrange
+	vector<Subnet<IPv4Traits>> prefixes;
+	vector<Subnet<IPv6Traits>> everything;
+
+	// Act
+	PrefixSet<IPv4Traits>::appendPrefixes(0x0A000001u, 0x0A000102u, prefixes);
+	PrefixSet<IPv6Traits>::appendPrefixes(UInt128(0), UInt128::lowBits(128), everything);
+
+	// Assert
+	ASSERT_EQ(prefixes.size(), 10u);
+	EXPECT_EQ(prefixes[0], Subnet<IPv4Traits>(0x0A000001u, 32));
+	EXPECT_EQ(prefixes[1], Subnet<IPv4Traits>(0x0A000002u, 31));
+	EXPECT_EQ(prefixes[7], Subnet<IPv4Traits>(0x0A000080u, 25));
+	EXPECT_EQ(prefixes[8], Subnet<IPv4Traits>(0x0A000100u, 31));
+	EXPECT_EQ(prefixes[9], Subnet<IPv4Traits>(0x0A000102u, 32));
+	ASSERT_EQ(everything.size(), 1u);
+	EXPECT_EQ(everything[0].getPrefixLength(), 0);
+}
+
+TEST(PrefixSet, FreeBlocks)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	BasicNetwork<IPv6Traits> engine(UInt128(0x20010DB800000000ULL, 0), 32);
+	network.segment(5);
+	engine.segment(3);
+
+	// Act
+	vector<Subnet<IPv4Traits>> free = freeBlocks<IPv4Traits>(network);
+	vector<Subnet<IPv6Traits>> engineFree = freeBlocks(engine);
+	PrefixSet<IPv4Traits> used = PrefixSet<IPv4Traits>::fromSubnets(network);
+
+	// Assert
+	ASSERT_EQ(free.size(), 2u);
+	EXPECT_EQ(free[0], Subnet<IPv4Traits>(0xC0A800A0u, 27));
+	EXPECT_EQ(free[1], Subnet<IPv4Traits>(0xC0A800C0u, 26));
+	EXPECT_EQ(used.getIntervals().size(), 1u);
+	ASSERT_EQ(engineFree.size(), 1u);
+	EXPECT_EQ(engineFree[0], Subnet<IPv6Traits>(UInt128(0x20010DB8C0000000ULL, 0), 34));
+	EXPECT_EQ(freeBlocks(BasicNetwork<IPv4Traits>(0xC0A80000u, 24)).size(), 1u);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "network/prefix_trie.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(PrefixTrie, LongestMatch)
+{
+	// Arrange
+	PrefixTrie<IPv4Traits> trie;
+	size_t eight = trie.insert(Subnet<IPv4Traits>(0x0A000000u, 8));
+	size_t sixteen = trie.insert(Subnet<IPv4Traits>(0x0A010000u, 16));
+	size_t twentyFour = trie.insert(Subnet<IPv4Traits>(0x0A010200u, 24));
+	size_t other = trie.insert(Subnet<IPv4Traits>(0xC0A80000u, 16));
+
+	// Act & Assert
+	EXPECT_EQ(trie.size(), 4u);
+	EXPECT_EQ(trie.insert(Subnet<IPv4Traits>(0x0A010000u, 16)), sixteen);
+	EXPECT_EQ(trie.find(0x0A010203u), twentyFour);
+	EXPECT_EQ(trie.find(0x0A0103FFu), sixteen);
+	EXPECT_EQ(trie.find(0x0AFF0000u), eight);
+	EXPECT_EQ(trie.find(0xC0A8FFFFu), other);
+	EXPECT_EQ(trie.find(0x0B000000u), trie.size());
+	EXPECT_EQ(trie[twentyFour].getPrefixLength(), 24);
+	EXPECT_THROW(trie[4], out_of_range);
+}
+
+TEST(PrefixTrie, SegmentedNetwork)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+	network.segment(1000);
+	PrefixTrie<IPv6Traits> trie(network);
+	vector<UInt128> ips;
+
+	for (size_t i = 0; i < network.getSubnetCount(); ++i)
+	{
+		ips.push_back(network[i]->getLastIp()->toUInt128());
+	}
+
+	ips.push_back(IPv6Address("2001:db9::").toUInt128());
+
+	vector<size_t> indices(ips.size());
+
+	// Act
+	trie.find(ips.data(), ips.size(), indices.data(), 4);
+
+	// Assert
+	ASSERT_EQ(trie.size(), network.getSubnetCount());
+
+	for (size_t i = 0; i < network.getSubnetCount(); ++i)
+	{
+		EXPECT_EQ(indices[i], i);
+	}
+
+	EXPECT_EQ(indices.back(), trie.size());
+}
+
+TEST(PrefixTrie, SubnetTable)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("172.16.0.0"), 12);
+	SubnetTable<IPv4Traits> table = network.segmentTable(4096);
+
+	// Act
+	PrefixTrie<IPv4Traits> trie(table);
+	trie.insert(Subnet<IPv4Traits>(0, 0));
+
+	// Assert
+	EXPECT_EQ(trie.find(0xAC100001u), 0u);
+	EXPECT_EQ(trie.find(0xAC1FFFFFu), 4095u);
+	EXPECT_EQ(trie.find(0x08080808u), 4096u);
+}
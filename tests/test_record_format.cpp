@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "format/record_format.h"
+#include <sstream>
+
+TEST(RecordFormat, Csv)
+{
+	// Arrange
+	ostringstream output;
+	SubnetRange<IPv4Traits> range = SubnetRange<IPv4Traits>::split(0xC0A80000u, 24, 25);
+
+	// Act
+	{
+		OutputBuffer out(output);
+		writeRecords(out, range, OutputFormat::Csv);
+	}
+
+	// Assert
+	EXPECT_EQ(output.str(),
+		"network,prefix_length,first_host,last_host,broadcast\n"
+		"192.168.0.0,25,192.168.0.1,192.168.0.126,192.168.0.127\n"
+		"192.168.0.128,25,192.168.0.129,192.168.0.254,192.168.0.255\n");
+}
+
+TEST(RecordFormat, Ndjson)
+{
+	// Arrange
+	ostringstream output;
+	SubnetRange<IPv6Traits> range = SubnetRange<IPv6Traits>::split(UInt128(0x20010DB800000000ull, 0), 32, 33);
+
+	// Act
+	{
+		OutputBuffer out(output);
+		writeRecords(out, range, OutputFormat::Ndjson);
+	}
+
+	// Assert
+	EXPECT_EQ(output.str(),
+		"{\"network\":\"2001:db8::\",\"prefix_length\":33,\"first_host\":\"2001:db8::1\",\"last_host\":\"2001:db8:7fff:ffff:ffff:ffff:ffff:ffff\"}\n"
+		"{\"network\":\"2001:db8:8000::\",\"prefix_length\":33,\"first_host\":\"2001:db8:8000::1\",\"last_host\":\"2001:db8:ffff:ffff:ffff:ffff:ffff:ffff\"}\n");
+}
+
+TEST(RecordFormat, Binary)
+{
+	// Arrange
+	ostringstream output;
+	SubnetRange<IPv4Traits> range = SubnetRange<IPv4Traits>::split(0x0A000000u, 8, 9);
+	OutputFormat format = OutputFormat::Table;
+
+	// Act
+	{
+		OutputBuffer out(output);
+		writeRecords(out, range, OutputFormat::Binary);
+	}
+
+	// Assert
+	EXPECT_EQ(output.str(), string("\x0A\x00\x00\x00\x09\x0A\x80\x00\x00\x09", 10));
+	EXPECT_TRUE(parseOutputFormat("binary", format));
+	EXPECT_EQ(format, OutputFormat::Binary);
+	EXPECT_FALSE(parseOutputFormat("xml", format));
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "network/segment_plan.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(SegmentPlan, DepthFirst)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	SegmentPlan<IPv4Traits> plan(network, { { 16, 2 }, { 20, 2 } });
+
+	// Act
+	vector<string> subnets;
+	vector<size_t> depths;
+	for (SegmentPlan<IPv4Traits>::iterator it = plan.begin(); it != plan.end(); ++it)
+	{
+		subnets.push_back((*it).getIp().toString() + "/" + to_string((*it).getPrefixLength()));
+		depths.push_back(it.getDepth());
+	}
+
+	// Assert
+	EXPECT_EQ(plan.size(), 6u);
+	EXPECT_EQ(subnets, vector<string>({ "10.0.0.0/16", "10.0.0.0/20", "10.0.16.0/20", "10.1.0.0/16", "10.1.0.0/20", "10.1.16.0/20" }));
+	EXPECT_EQ(depths, vector<size_t>({ 0, 1, 1, 0, 1, 1 }));
+	EXPECT_THROW(plan[6], out_of_range);
+}
+
+TEST(SegmentPlan, RandomAccess)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+	SegmentPlan<IPv6Traits> plan(network, { { 36, 3 }, { 40, 0 }, { 48, 5 } });
+
+	// Act
+	SegmentPlan<IPv6Traits>::iterator it = plan.begin();
+	size_t mismatches = 0;
+	for (uint64_t i = 0; i < plan.size(); ++i, ++it)
+	{
+		mismatches += (*it == plan[i] && it.getIndex() == i) ? 0 : 1;
+	}
+
+	// Assert
+	EXPECT_EQ(plan.size(), 3u * (1 + 16 * (1 + 5)));
+	EXPECT_EQ(plan.getLevels()[1].count, 16u);
+	EXPECT_EQ(mismatches, 0u);
+	EXPECT_TRUE(it == plan.end());
+	EXPECT_EQ(plan[plan.size() - 1].getIp().toString(), "2001:db8:2f04::");
+	EXPECT_EQ((plan.begin() + 8).getDepth(), 2u);
+}
+
+TEST(SegmentPlan, InvalidLevels)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	UInt128 wide(0);
+
+	// Act & Assert
+	EXPECT_THROW(SegmentPlan<IPv4Traits>(network, {}), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv4Traits>(network, { { 8, 1 } }), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv4Traits>(network, { { 16, 1 }, { 12, 1 } }), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv4Traits>(network, { { 33, 1 } }), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv4Traits>(network, { { 16, 257 } }), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv6Traits>(wide, 0, { { 64, 0 } }), invalid_argument);
+	EXPECT_THROW(SegmentPlan<IPv6Traits>(wide, 0, { { 64, UINT64_MAX }, { 65, 2 } }), invalid_argument);
+	EXPECT_NO_THROW(SegmentPlan<IPv6Traits>(wide, 0, { { 64, UINT64_MAX - 1 } }));
+}
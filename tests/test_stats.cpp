@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "utils/stats.h"
+#include "network/ipv4_network.h"
+#include <sstream>
+
+TEST(Stats, CountHotPaths)
+{
+#ifdef NO_STATS
+	GTEST_SKIP() << "The instrumentation is compiled out.";
+#endif
+
+	// Arrange
+	ostringstream output;
+	ostringstream report;
+	Stats::enable();
+
+	// Act
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	network.segment(4);
+	output << network;
+	Stats::disable();
+	Stats::report(report);
+
+	// Assert
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Parse), 1u);
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Network), 5u);
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Mask), 5u);
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Segment), 1u);
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Print), 1u);
+	EXPECT_EQ(Stats::getCount(StatsCounter::Subnets), 4u);
+	EXPECT_EQ(Stats::getCount(StatsCounter::BytesWritten), output.str().size());
+	EXPECT_GE(Stats::getCount(StatsCounter::Allocations), 4u);
+	EXPECT_NE(report.str().find("segment"), string::npos);
+	EXPECT_NE(report.str().find("peak RSS"), string::npos);
+}
+
+TEST(Stats, Disabled)
+{
+	// Arrange
+	Stats::enable();
+	Stats::disable();
+
+	// Act
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	network.segment(2);
+
+	// Assert
+	EXPECT_EQ(Stats::getCalls(StatsPhase::Network), 0u);
+	EXPECT_EQ(Stats::getCount(StatsCounter::Subnets), 0u);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+#include "network/subnet_pool.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+TEST(SubnetPool, AllocateRelease)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	SubnetPool<IPv4Traits> pool(network.segmentRange(4));
+	uint64_t index = 0;
+
+	// Act
+	vector<uint64_t> indices;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		indices.push_back(pool.allocate());
+	}
+
+	sort(indices.begin(), indices.end());
+
+	// Assert
+	EXPECT_EQ(indices, vector<uint64_t>({ 0, 1, 2, 3 }));
+	EXPECT_EQ(pool.getAllocatedCount(), 4u);
+	EXPECT_FALSE(pool.tryAllocate(index));
+	EXPECT_THROW(pool.allocate(), out_of_range);
+
+	pool.release(2);
+
+	EXPECT_FALSE(pool.isAllocated(2));
+	EXPECT_EQ(pool.allocate(), 2u);
+	EXPECT_EQ(pool[2].getIp().toString(), "192.168.0.128");
+
+	pool.release(2);
+
+	EXPECT_THROW(pool.release(2), invalid_argument);
+	EXPECT_THROW(pool.release(4), out_of_range);
+	EXPECT_EQ(pool.getAllocatedCount(), 3u);
+}
+
+TEST(SubnetPool, Hosts)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 30);
+	SubnetPool<IPv4Traits> pool(network.subnets(32));
+	SubnetPool<IPv4Traits>::Cache cache(pool);
+
+	// Act
+	bool networkClaimed = pool.tryClaim(0);
+	bool broadcastClaimed = pool.tryClaim(3);
+	bool claimedTwice = pool.tryClaim(3);
+	uint64_t first = cache.allocate();
+	uint64_t second = cache.allocate();
+
+	// Assert
+	EXPECT_TRUE(networkClaimed);
+	EXPECT_TRUE(broadcastClaimed);
+	EXPECT_FALSE(claimedTwice);
+	EXPECT_EQ(pool[first].getIp().toString(), "10.0.0.1");
+	EXPECT_EQ(pool[second].getIp().toString(), "10.0.0.2");
+	EXPECT_THROW(cache.allocate(), out_of_range);
+	EXPECT_THROW(pool.tryClaim(4), out_of_range);
+}
+
+TEST(SubnetPool, Snapshot)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+	SubnetPool<IPv6Traits> pool(network.subnets(48).slice(0, 100), 4);
+	vector<uint64_t> allocated;
+
+	for (uint64_t i = 0; i < 100; i += 7)
+	{
+		pool.tryClaim(i);
+	}
+
+	// Act
+	pool.forEachAllocated([&](uint64_t index) { allocated.push_back(index); });
+
+	// Assert
+	EXPECT_EQ(pool.getShardCount(), 1u);
+	EXPECT_EQ(allocated.size(), 15u);
+	EXPECT_EQ(allocated.front(), 0u);
+	EXPECT_EQ(allocated.back(), 98u);
+	EXPECT_TRUE(is_sorted(allocated.begin(), allocated.end()));
+	EXPECT_EQ(pool.getAllocatedCount(), 15u);
+}
+
+TEST(SubnetPool, Concurrent)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	SubnetPool<IPv4Traits> pool(network.subnets(24).slice(0, 4000 + 13), 4);
+	vector<vector<uint64_t>> leases(4);
+	vector<thread> threads;
+
+	// Act
+	for (size_t t = 0; t < leases.size(); ++t)
+	{
+		threads.emplace_back([&pool, &leases, t]()
+		{
+			SubnetPool<IPv4Traits>::Cache cache(pool);
+			uint64_t index = 0;
+
+			// Churn the cache, then keep a share of the subnets
+			for (int i = 0; i < 1000; ++i)
+			{
+				cache.release(cache.allocate());
+			}
+
+			while (leases[t].size() < 1000 && cache.tryAllocate(index))
+			{
+				leases[t].push_back(index);
+			}
+		});
+	}
+
+	for (thread& t : threads)
+	{
+		t.join();
+	}
+
+	vector<uint64_t> indices;
+
+	for (const vector<uint64_t>& lease : leases)
+	{
+		indices.insert(indices.end(), lease.begin(), lease.end());
+	}
+
+	sort(indices.begin(), indices.end());
+
+	// Assert
+	EXPECT_EQ(pool.getShardCount(), 4u);
+	EXPECT_EQ(indices.size(), 4000u);
+	EXPECT_EQ(unique(indices.begin(), indices.end()), indices.end());
+	EXPECT_EQ(pool.getAllocatedCount(), 4000u);
+	EXPECT_LT(indices.back(), pool.size());
+
+	for (uint64_t index : indices)
+	{
+		pool.release(index);
+	}
+
+	EXPECT_EQ(pool.getAllocatedCount(), 0u);
+	EXPECT_THROW(SubnetPool<IPv4Traits>(network.subnets(24).slice(0, 0)), invalid_argument);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(SubnetRange, IPv4Subnets)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+
+	// Act
+	SubnetRange<IPv4Traits> range = network.subnets(30);
+	Subnet<IPv4Traits> last = range[range.size() - 1];
+
+	// Assert
+	EXPECT_EQ(range.size(), 1ULL << 22);
+	EXPECT_EQ(range[1].getIp().toString(), "10.0.0.4");
+	EXPECT_EQ(last.getIp().toString(), "10.255.255.252");
+	EXPECT_EQ(last.getFirstIp().toString(), "10.255.255.253");
+	EXPECT_EQ(last.getLastIp().toString(), "10.255.255.254");
+	EXPECT_EQ(last.getBroadcastIp().toString(), "10.255.255.255");
+	EXPECT_THROW(range[range.size()], out_of_range);
+}
+
+TEST(SubnetRange, IPv6Subnets)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+
+	// Act
+	SubnetRange<IPv6Traits> range = network.subnets(64);
+	Subnet<IPv6Traits> subnet = range[0x12345678];
+
+	// Assert
+	EXPECT_EQ(range.size(), 1ULL << 32);
+	EXPECT_EQ(subnet.getIp().toString(), "2001:db8:1234:5678::");
+	EXPECT_EQ(subnet.getLastIp().toString(), "2001:db8:1234:5678:ffff:ffff:ffff:ffff");
+}
+
+TEST(SubnetRange, Iteration)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	network.segment(4);
+
+	// Act
+	SubnetRange<IPv4Traits> range = network.subnets(26);
+
+	// Assert
+	size_t i = 0;
+	for (Subnet<IPv4Traits> subnet : range)
+	{
+		EXPECT_EQ(subnet.getIp().toString(), network[i]->getIp()->toString());
+		EXPECT_EQ(subnet.getLastIp().toString(), network[i]->getLastIp()->toString());
+		++i;
+	}
+
+	EXPECT_EQ(i, 4u);
+	EXPECT_EQ(range.end() - range.begin(), 4);
+}
+
+TEST(SubnetRange, InvalidPrefixLength)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 32);
+
+	// Assert
+	EXPECT_THROW(network.subnets(16), invalid_argument);
+	EXPECT_THROW(network.subnets(129), invalid_argument);
+	EXPECT_THROW(network.subnets(96), invalid_argument);
+}
+TEST(SubnetRange, Slice)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	SubnetRange<IPv4Traits> range = network.subnets(30);
+
+	// Act
+	SubnetRange<IPv4Traits> page = range.slice(1000000, 100);
+	SubnetRange<IPv4Traits> tail = range.slice(range.size() - 2, 100);
+	SubnetRange<IPv4Traits> past = range.slice(range.size() + 1, 100);
+
+	// Assert
+	ASSERT_EQ(page.size(), 100u);
+	EXPECT_EQ(page[0], range[1000000]);
+	EXPECT_EQ(page[99], range[1000099]);
+	EXPECT_EQ(tail.size(), 2u);
+	EXPECT_EQ(tail[1].getIp().toString(), "10.255.255.252");
+	EXPECT_TRUE(past.empty());
+}
+
+TEST(SubnetRange, Find)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("10.0.0.0"), 8);
+	SubnetRange<IPv4Traits> range = network.segmentRange(1000);
+	SubnetRange<IPv6Traits> whole(UInt128(0), 0, 1);
+	uint64_t index = 0;
+	uint64_t wholeIndex = 1;
+
+	// Act
+	bool found = range.find(IPv4Traits::toValue(IPv4Address("10.3.232.77")), index);
+	bool after = range.find(IPv4Traits::toValue(IPv4Address("10.250.0.0")), index);
+	bool before = range.find(IPv4Traits::toValue(IPv4Address("9.255.255.255")), index);
+	bool wholeFound = whole.find(UInt128::lowBits(128), wholeIndex);
+
+	// Assert
+	EXPECT_TRUE(found);
+	EXPECT_EQ(index, 15u);
+	EXPECT_TRUE(range[index].contains(IPv4Traits::toValue(IPv4Address("10.3.232.77"))));
+	EXPECT_FALSE(after);
+	EXPECT_FALSE(before);
+	EXPECT_TRUE(wholeFound);
+	EXPECT_EQ(wholeIndex, 0u);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(SubnetTable, SegmentTable)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	network.segment(5);
+
+	// Act
+	SubnetTable<IPv4Traits> table = network.segmentTable(5);
+
+	// Assert
+	ASSERT_EQ(table.size(), network.getSubnetCount());
+	EXPECT_EQ(table.getPrefixLength(), 27);
+
+	for (size_t i = 0; i < table.size(); ++i)
+	{
+		const IPv4Network* subnet = dynamic_cast<const IPv4Network*>(network[i]);
+
+		EXPECT_EQ(table[i].getIp().toString(), subnet->getIp()->toString());
+		EXPECT_EQ(table[i].getFirstIp().toString(), subnet->getFirstIp()->toString());
+		EXPECT_EQ(table[i].getLastIp().toString(), subnet->getLastIp()->toString());
+		EXPECT_EQ(table[i].getBroadcastIp().toString(), subnet->getBroadcastIp()->toString());
+	}
+}
+
+TEST(SubnetTable, Contiguous)
+{
+	// Arrange
+	IPv6Network network(IPv6Address("2001:db8::"), 48);
+
+	// Act
+	SubnetTable<IPv6Traits> table = network.segmentTable(1000);
+	const UInt128* ips = table.data();
+
+	// Assert
+	EXPECT_EQ(table.size(), 1000u);
+	EXPECT_EQ(ips[999], IPv6Address("2001:db8:0:f9c0::").toUInt128());
+	EXPECT_THROW(table[1000], out_of_range);
+}
+
+TEST(SubnetTable, SortAndFind)
+{
+	// Arrange
+	vector<uint32_t> ips = { 0x0A000300, 0x0A000100, 0x0A000201 };
+	SubnetTable<IPv4Traits> table(ips, 24);
+
+	// Act
+	table.sort();
+
+	// Assert
+	EXPECT_EQ(table[0].getIp().toString(), "10.0.1.0");
+	EXPECT_EQ(table[1].getIp().toString(), "10.0.2.0");
+	EXPECT_EQ(table.find(0x0A0003FF), 2u);
+	EXPECT_EQ(table.find(0x0A000400), table.size());
+}
\ No newline at end of file
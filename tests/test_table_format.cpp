@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "format/table_format.h"
+#include "format/address_format.h"
+#include <sstream>
+
+TEST(TableFormat, FormatAddresses)
+{
+	// Arrange
+	char text[IPV6_MAX_LENGTH];
+
+	// Act & Assert
+	EXPECT_EQ(string(text, formatDecimal(0, text)), "0");
+	EXPECT_EQ(string(text, formatDecimal(18446744073709551615ull, text)), "18446744073709551615");
+	EXPECT_EQ(string(text, formatIPv4(0xC0A80A05u, text)), "192.168.10.5");
+	EXPECT_EQ(string(text, formatIPv4(0xFFFFFFFFu, text)), "255.255.255.255");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x20010DB800000000ull, 0), text)), "2001:db8::");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x20010DB800000000ull, 0x00000000FFFF0001ull), text)), "2001:db8::ffff:1");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x0001000000000002ull, 0x0000000000030004ull), text)), "1::2:0:0:3:4");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull), text)), "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0, 0), text)), "::");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0, 1), text)), "::1");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x20010DB800000001ull, 0x0001000100010001ull), text)), "2001:db8:0:1:1:1:1:1");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x20010DB800010002ull, 0x0003000400050000ull), text)), "2001:db8:1:2:3:4:5:0");
+	EXPECT_EQ(string(text, formatIPv6(UInt128(0x20010DB800000000ull, 0x0001000000000001ull), text)), "2001:db8::1:0:0:1");
+}
+
+TEST(TableFormat, FormatBatch)
+{
+	// Arrange
+	uint32_t ipv4Values[] = { 0x0A000001u, 0xC0A80A05u, 0 };
+	UInt128 ipv6Values[] = { UInt128(0x20010DB800000000ull, 1), UInt128(0xFE80000000000000ull, 0x0000000000000001ull) };
+	char text[3 * (IPV6_MAX_LENGTH + 1)];
+
+	// Act
+	size_t ipv4Length = formatIPv4Batch(ipv4Values, 3, text);
+	string ipv4Text(text, ipv4Length);
+	size_t ipv6Length = formatIPv6Batch(ipv6Values, 2, text, ' ');
+	string ipv6Text(text, ipv6Length);
+
+	// Assert
+	EXPECT_EQ(ipv4Text, "10.0.0.1\n192.168.10.5\n0.0.0.0\n");
+	EXPECT_EQ(ipv6Text, "2001:db8::1 fe80::1 ");
+}
+
+TEST(TableFormat, FormatSharedPrefix)
+{
+	// Arrange
+	UInt128 values[] = {
+		UInt128(0x20010DB800000000ull, 0), UInt128(0x20010DB800000000ull, 0x0001000000000000ull),
+		UInt128(0x20010DB800000000ull, 0x0001000000000001ull), UInt128(0x20010DB800010000ull, 0x0001000000000001ull),
+		UInt128(0x20010DB800010000ull, 0), UInt128(0, 0), UInt128(0, 1), UInt128(0x20010DB800010000ull, 0)
+	};
+	IPv6Formatter formatter;
+	char expected[IPV6_MAX_LENGTH];
+	char text[IPV6_MAX_LENGTH];
+
+	// Act & Assert
+	for (const UInt128& value : values)
+	{
+		EXPECT_EQ(string(text, formatter.format(value, text)), string(expected, formatIPv6(value, expected)));
+	}
+
+	EXPECT_EQ(string(text, formatter.format(UInt128(0x20010DB800010000ull, 0x00000000FFFF0001ull), text)), "2001:db8:1::ffff:1");
+}
+
+TEST(TableFormat, OutputBuffer)
+{
+	// Arrange
+	ostringstream output;
+
+	// Act
+	{
+		OutputBuffer out(output, 4);
+		out.append("ab", 2);
+		out.appendLeft("cd", 2, 4);
+		out.appendRight("efghij", 6, 3);
+		out.append('|');
+	}
+
+	// Assert
+	EXPECT_EQ(output.str(), "abcd  efghij|");
+}
+
+TEST(TableFormat, IPv4Row)
+{
+	// Arrange
+	ostringstream output;
+
+	// Act
+	{
+		OutputBuffer out(output);
+		writeIPv4TableRow(out, 0xC0A80000u, 25, 0xC0A80001u, 0xC0A8007Eu, 0xC0A8007Fu, 128);
+	}
+
+	// Assert
+	EXPECT_EQ(output.str(), "| 192.168.0.0      /25 | 192.168.0.1     - 192.168.0.126   | 192.168.0.127       |           128 |\n");
+}
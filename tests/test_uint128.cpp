@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "utils/uint128.h"
+
+TEST(UInt128, AdditionCarry)
+{
+	// Arrange
+	UInt128 value(0, ~0ULL);
+
+	// Act
+	UInt128 sum = value + 1;
+
+	// Assert
+	EXPECT_EQ(sum.getHigh(), 1ULL);
+	EXPECT_EQ(sum.getLow(), 0ULL);
+}
+
+TEST(UInt128, SubtractionBorrow)
+{
+	// Arrange
+	UInt128 value(1, 0);
+
+	// Act
+	UInt128 difference = value - 1;
+
+	// Assert
+	EXPECT_EQ(difference.getHigh(), 0ULL);
+	EXPECT_EQ(difference.getLow(), ~0ULL);
+}
+
+TEST(UInt128, Shift)
+{
+	// Arrange
+	UInt128 value(1);
+
+	// Act
+	UInt128 left = value << 100;
+	UInt128 right = left >> 99;
+	UInt128 overflow = value << 128;
+
+	// Assert
+	EXPECT_EQ(left.getHigh(), 1ULL << 36);
+	EXPECT_EQ(left.getLow(), 0ULL);
+	EXPECT_EQ(right, UInt128(2));
+	EXPECT_EQ(overflow, UInt128(0));
+}
+
+TEST(UInt128, LowBits)
+{
+	// Act
+	UInt128 none = UInt128::lowBits(0);
+	UInt128 some = UInt128::lowBits(72);
+	UInt128 all = UInt128::lowBits(128);
+
+	// Assert
+	EXPECT_EQ(none, UInt128(0));
+	EXPECT_EQ(some, UInt128(0xFF, ~0ULL));
+	EXPECT_EQ(all, ~UInt128(0));
+}
+
+TEST(UInt128, Comparison)
+{
+	// Arrange
+	UInt128 low(0, ~0ULL);
+	UInt128 high(1, 0);
+
+	// Assert
+	EXPECT_TRUE(low < high);
+	EXPECT_TRUE(high > low);
+	EXPECT_TRUE(low <= low);
+	EXPECT_TRUE(low != high);
+}
+TEST(UInt128, Logarithm)
+{
+	// Arrange
+	UInt128 value(1, 0);
+
+	// Act
+	int leadingZeros = value.countLeadingZeros();
+
+	// Assert
+	EXPECT_EQ(leadingZeros, 63);
+	EXPECT_EQ(UInt128(0).countLeadingZeros(), 128);
+	EXPECT_EQ(ceilLog2(1), 0);
+	EXPECT_EQ(ceilLog2(5), 3);
+	EXPECT_EQ(ceilLog2(1ULL << 32), 32);
+	EXPECT_EQ(ceilLog2((1ULL << 53) + 1), 54);
+	EXPECT_EQ(ceilLog2(~0ULL), 64);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "network/vlsm_planner.h"
+#include "network/ipv4_network.h"
+#include "network/ipv6_network.h"
+
+TEST(VlsmPlanner, Plan)
+{
+	// Arrange
+	IPv4Network network(IPv4Address("192.168.0.0"), 24);
+	VlsmPlanner<IPv4Traits> planner(network);
+
+	// Act
+	vector<Subnet<IPv4Traits>> subnets = planner.plan({ 2, 100, 50, 20 });
+
+	// Assert
+	ASSERT_EQ(subnets.size(), 4u);
+	EXPECT_EQ(subnets[0].getIp().toString(), "192.168.0.224");
+	EXPECT_EQ(subnets[0].getPrefixLength(), 30);
+	EXPECT_EQ(subnets[1].getIp().toString(), "192.168.0.0");
+	EXPECT_EQ(subnets[1].getPrefixLength(), 25);
+	EXPECT_EQ(subnets[2].getIp().toString(), "192.168.0.128");
+	EXPECT_EQ(subnets[2].getPrefixLength(), 26);
+	EXPECT_EQ(subnets[3].getIp().toString(), "192.168.0.192");
+	EXPECT_EQ(subnets[3].getPrefixLength(), 27);
+	EXPECT_EQ(planner.getAllocatedCount(), 4u);
+}
+
+TEST(VlsmPlanner, PlanDoesNotFit)
+{
+	// Arrange
+	VlsmPlanner<IPv4Traits> planner(0xC0A80000u, 24);
+
+	// Act & Assert
+	EXPECT_THROW(planner.plan({ 100, 100, 100 }), invalid_argument);
+	EXPECT_EQ(planner.getAllocatedCount(), 0u);
+	EXPECT_EQ(planner.allocatePrefix(24).getValue(), 0xC0A80000u);
+	EXPECT_THROW(planner.allocate(0), invalid_argument);
+}
+
+TEST(VlsmPlanner, AllocateAndRelease)
+{
+	// Arrange
+	VlsmPlanner<IPv6Traits> planner(IPv6Address("2001:db8::").toUInt128(), 32);
+
+	// Act
+	Subnet<IPv6Traits> first = planner.allocatePrefix(48);
+	Subnet<IPv6Traits> second = planner.allocatePrefix(48);
+	Subnet<IPv6Traits> small = planner.allocate(1000);
+	planner.release(first);
+	Subnet<IPv6Traits> reused = planner.allocatePrefix(48);
+	planner.release(second);
+	planner.release(small);
+	planner.release(reused);
+
+	// Assert
+	EXPECT_EQ(second.getIp().toString(), "2001:db8:1::");
+	EXPECT_EQ(small.getIp().toString(), "2001:db8:2::");
+	EXPECT_EQ(small.getPrefixLength(), 118);
+	EXPECT_EQ(reused, first);
+	EXPECT_THROW(planner.release(first), invalid_argument);
+	EXPECT_EQ(planner.allocatePrefix(32).getValue(), IPv6Address("2001:db8::").toUInt128());
+}